@@ -0,0 +1,289 @@
+/**
+ * @file
+ * @brief Declarations of public data types and functions for the
+ *        Metrics module.
+ *
+ * @see docs/Metrics/README.md
+ *
+ * @author Vitor Betmann
+ */
+
+
+#ifndef SMILE_METRICS_H
+#define SMILE_METRICS_H
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <stdint.h>
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Handle to a metric created with `mtCreateCounter()`,
+ *        `mtCreateGauge()` or `mtCreateHistogram()`.
+ *
+ * `0` is never a valid handle, so it can mark "no metric". Handles stay
+ * invalid after `mtStop()`, even if Metrics starts again.
+ *
+ * @author Vitor Betmann
+ */
+typedef uint64_t mtMetricId;
+
+/**
+ * @brief Merged view of a histogram across every thread that recorded into it.
+ *
+ * Percentiles come from log-linear buckets, so they are within 12.5% of the
+ * exact value. `min` and `max` are exact.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+    uint64_t p50;
+    uint64_t p90;
+    uint64_t p99;
+} mtHistogramSummary;
+
+/**
+ * @brief File formats for `mtWriteSnapshot()`.
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    MT_SNAPSHOT_TEXT,
+    MT_SNAPSHOT_BINARY,
+} mtSnapshotFormat;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Prototypes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Start Related
+
+/**
+ * @brief Starts Metrics with an empty registry.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: Metrics is already running (`RES_ALREADY_RUNNING`).
+ * @note SceneManager only publishes its metrics if Metrics starts first.
+ *
+ * @author Vitor Betmann
+ */
+int mtStart(void);
+
+/**
+ * @brief Checks whether Metrics is running.
+ *
+ * @return `true` if Metrics is running, `false` otherwise.
+ *
+ * @author Vitor Betmann
+ */
+bool mtIsRunning(void);
+
+// Registry Related
+
+/**
+ * @brief Creates a counter, a total that only grows.
+ *
+ * @param name Unique name of the metric. It is copied.
+ * @param id Output for the handle used to update and read the counter.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: Metrics is not running; @p name or @p id is null; @p name is
+ *       empty; @p name belongs to a gauge or histogram; the registry is full;
+ *       or memory allocation fails.
+ * @note Creating a counter whose name is taken by another counter returns the
+ *       existing handle.
+ *
+ * @author Vitor Betmann
+ */
+int mtCreateCounter(const char *name, mtMetricId *id);
+
+/**
+ * @brief Creates a gauge, a value that is set rather than accumulated.
+ *
+ * @param name Unique name of the metric. It is copied.
+ * @param id Output for the handle used to update and read the gauge.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: Metrics is not running; @p name or @p id is null; @p name is
+ *       empty; @p name belongs to a counter or histogram; the registry is full;
+ *       or memory allocation fails.
+ * @note Creating a gauge whose name is taken by another gauge returns the
+ *       existing handle.
+ *
+ * @author Vitor Betmann
+ */
+int mtCreateGauge(const char *name, mtMetricId *id);
+
+/**
+ * @brief Creates a histogram, a distribution of recorded values.
+ *
+ * @param name Unique name of the metric. It is copied.
+ * @param id Output for the handle used to update and read the histogram.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: Metrics is not running; @p name or @p id is null; @p name is
+ *       empty; @p name belongs to a counter or gauge; the registry is full;
+ *       or memory allocation fails.
+ * @note Creating a histogram whose name is taken by another histogram returns
+ *       the existing handle.
+ *
+ * @author Vitor Betmann
+ */
+int mtCreateHistogram(const char *name, mtMetricId *id);
+
+// Recording Related
+
+/**
+ * @brief Adds to a counter.
+ *
+ * Safe to call from any thread. Each thread adds into its own slot, so
+ * threads never contend on the same cache line.
+ *
+ * @param id Handle of the counter.
+ * @param delta Amount to add.
+ *
+ * @note Does nothing if @p id is not a counter of the running session, so
+ *       it never logs on a hot path.
+ *
+ * @author Vitor Betmann
+ */
+void mtAddCounter(mtMetricId id, uint64_t delta);
+
+/**
+ * @brief Sets a gauge.
+ *
+ * Safe to call from any thread. Gauges hold one shared value, so the last set
+ * wins.
+ *
+ * @param id Handle of the gauge.
+ * @param value New value.
+ *
+ * @note Does nothing if @p id is not a gauge of the running session.
+ *
+ * @author Vitor Betmann
+ */
+void mtSetGauge(mtMetricId id, int64_t value);
+
+/**
+ * @brief Records one value into a histogram.
+ *
+ * Safe to call from any thread. Each thread records into its own buckets,
+ * which are allocated the first time it records into @p id.
+ *
+ * @param id Handle of the histogram.
+ * @param value Value to record, e.g. a duration in nanoseconds.
+ *
+ * @note Does nothing if @p id is not a histogram of the running session, or if
+ *       the thread's buckets cannot be allocated.
+ *
+ * @author Vitor Betmann
+ */
+void mtRecordHistogram(mtMetricId id, uint64_t value);
+
+// Reading Related
+
+/**
+ * @brief Reads a counter, summed across every thread.
+ *
+ * @param id Handle of the counter.
+ * @param value Output for the total.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: Metrics is not running; @p value is null; or @p id is not a
+ *       counter of the running session.
+ *
+ * @author Vitor Betmann
+ */
+int mtGetCounter(mtMetricId id, uint64_t *value);
+
+/**
+ * @brief Reads a gauge.
+ *
+ * @param id Handle of the gauge.
+ * @param value Output for the last value set, or `0` if never set.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: Metrics is not running; @p value is null; or @p id is not a
+ *       gauge of the running session.
+ *
+ * @author Vitor Betmann
+ */
+int mtGetGauge(mtMetricId id, int64_t *value);
+
+/**
+ * @brief Reads a histogram, merged across every thread.
+ *
+ * @param id Handle of the histogram.
+ * @param summary Output for the merged summary. All zero if nothing was
+ *        recorded.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: Metrics is not running; @p summary is null; or @p id is not
+ *       a histogram of the running session.
+ *
+ * @author Vitor Betmann
+ */
+int mtGetHistogram(mtMetricId id, mtHistogramSummary *summary);
+
+// Snapshot Related
+
+/**
+ * @brief Writes every metric to a file.
+ *
+ * The text format has one line per metric. The binary format stores the same
+ * values plus every non-empty histogram bucket. Both are described in
+ * docs/Metrics/MetricsAPI.md.
+ *
+ * @param path Path of the file to create or overwrite.
+ * @param format Format to write.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: Metrics is not running (`RES_NOT_RUNNING`); @p path is null
+ *       (`RES_NULL_ARG`) or empty (`RES_EMPTY_ARG`); @p format is unknown
+ *       (`RES_INVALID_ARG`); or the file cannot be written
+ *       (`RES_CREATE_FILE_FAIL`).
+ * @note Values recorded on other threads while writing may be left out.
+ *
+ * @author Vitor Betmann
+ */
+int mtWriteSnapshot(const char *path, mtSnapshotFormat format);
+
+// Stop Related
+
+/**
+ * @brief Stops Metrics and frees the registry and every thread's slots.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: Metrics is not running (`RES_NOT_RUNNING`).
+ * @note No thread may be updating a metric while Metrics stops.
+ *
+ * @author Vitor Betmann
+ */
+int mtStop(void);
+
+
+#endif
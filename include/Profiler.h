@@ -0,0 +1,215 @@
+/**
+ * @file
+ * @brief Declarations of public data types and functions for the
+ *        Profiler module.
+ *
+ * @see docs/Profiler/README.md
+ *
+ * @author Vitor Betmann
+ */
+
+
+#ifndef SMILE_PROFILER_H
+#define SMILE_PROFILER_H
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/* Zones only exist in builds configured with SMILE_PROFILE. Otherwise both
+ * macros expand to nothing, so zones can stay in shipping code.
+ */
+#ifdef SMILE_PROFILE
+/**
+ * @brief Opens a zone on the calling thread.
+ *
+ * @param name Name shown in the trace. Must outlive the profiling session,
+ *             which string literals do.
+ *
+ * @author Vitor Betmann
+ */
+#define PF_BEGIN_ZONE(name) pfInternalBeginZone(name)
+
+/**
+ * @brief Closes the zone most recently opened on the calling thread.
+ *
+ * @author Vitor Betmann
+ */
+#define PF_END_ZONE() pfInternalEndZone()
+#else
+#define PF_BEGIN_ZONE(name) ((void)0)
+#define PF_END_ZONE() ((void)0)
+#endif
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Prototypes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Start Related
+
+/**
+ * @brief Starts the Profiler and begins a new profiling session.
+ *
+ * Zones opened before this call, or on threads that never open one, are not
+ * recorded. Each thread gets its own buffer the first time it opens a zone.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: the Profiler is already running (`RES_ALREADY_RUNNING`).
+ *
+ * @author Vitor Betmann
+ */
+int pfStart(void);
+
+/**
+ * @brief Checks whether the Profiler is running.
+ *
+ * @return `true` if the Profiler is running, `false` otherwise.
+ *
+ * @author Vitor Betmann
+ */
+bool pfIsRunning(void);
+
+// Export Related
+
+/**
+ * @brief Writes every zone recorded so far as Chrome trace-event JSON.
+ *
+ * The file opens in Perfetto (ui.perfetto.dev) and in `chrome://tracing`.
+ * Timestamps are relative to `pfStart()`.
+ *
+ * @param path Path of the file to create or overwrite.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: the Profiler is not running (`RES_NOT_RUNNING`); @p path is
+ *       null (`RES_NULL_ARG`) or empty (`RES_EMPTY_ARG`); or the file cannot be
+ *       written (`RES_CREATE_FILE_FAIL`).
+ * @note Zones still open, or closed on other threads while exporting, may be
+ *       left out.
+ *
+ * @author Vitor Betmann
+ */
+int pfExportTrace(const char *path);
+
+// Sampling Related
+
+/**
+ * @brief Starts sampling the calling thread's call stack on a CPU-time timer.
+ *
+ * Every tick of `ITIMER_PROF` raises `SIGPROF`, and a signal-safe handler walks
+ * the frame pointers of the interrupted code into a preallocated buffer. Each
+ * sample is filed under the SceneManager scene current when it was taken.
+ * Samples from earlier sampling runs are discarded.
+ *
+ * @param frequencyHz Samples per second of CPU time, from `1` to `10000`.
+ *                    The kernel may round it to its own tick rate.
+ * @param path Optional file the folded stacks are written to when SceneManager
+ *             stops. Pass nullptr to only write them with
+ *             `pfWriteFoldedStacks()`.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: the Profiler is not running (`RES_NOT_RUNNING`); sampling is
+ *       already running (`RES_ALREADY_RUNNING`); @p frequencyHz is out of range
+ *       (`RES_INVALID_ARG`); @p path is empty (`RES_EMPTY_ARG`); memory
+ *       allocation fails (`RES_MEM_ALLOC_FAIL`); the platform is not Linux on
+ *       x86-64 or arm64 (`RES_SAMPLING_UNSUPPORTED`); or the `SIGPROF` handler
+ *       or profiling timer cannot be set up (`RES_SAMPLING_TIMER_FAIL`).
+ * @note Stacks are only as deep as the frame pointers they follow. Build with
+ *       `SMILE_PROFILE`, which keeps them, and compile the game likewise.
+ * @note Only the calling thread is sampled. Ticks landing on other threads are
+ *       ignored.
+ * @note Replaces any `SIGPROF` handler until sampling stops. System calls it
+ *       interrupts are restarted.
+ *
+ * @author Vitor Betmann
+ */
+int pfStartSampling(int frequencyHz, const char *path);
+
+/**
+ * @brief Checks whether sampling is running.
+ *
+ * @return `true` if sampling is running, `false` otherwise.
+ *
+ * @author Vitor Betmann
+ */
+bool pfIsSampling(void);
+
+/**
+ * @brief Writes every stack sampled so far in folded format, one line per
+ *        distinct stack.
+ *
+ * Each line reads `scene;outermost;...;innermost count`, ready for
+ * `flamegraph.pl` or speedscope. Frames are named from the dynamic symbol
+ * table, so link with `-rdynamic` to name the game's own functions. Others are
+ * written as `file+0xoffset`, which `addr2line` resolves.
+ *
+ * @param path Path of the file to create or overwrite.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: the Profiler is not running (`RES_NOT_RUNNING`); @p path is
+ *       null (`RES_NULL_ARG`) or empty (`RES_EMPTY_ARG`); memory allocation
+ *       fails (`RES_MEM_ALLOC_FAIL`); or the file cannot be written
+ *       (`RES_CREATE_FILE_FAIL`).
+ * @note Can be called while sampling runs, or after it stops.
+ *
+ * @author Vitor Betmann
+ */
+int pfWriteFoldedStacks(const char *path);
+
+/**
+ * @brief Stops sampling, keeping the samples taken so far.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: the Profiler is not running, or sampling is not running
+ *       (`RES_NOT_RUNNING`).
+ * @note Call it from the thread that started sampling.
+ *
+ * @author Vitor Betmann
+ */
+int pfStopSampling(void);
+
+// Stop Related
+
+/**
+ * @brief Stops the Profiler, stops sampling, and frees every thread's buffer
+ *        and every sample.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: the Profiler is not running (`RES_NOT_RUNNING`).
+ * @note No thread may be inside a zone call while the Profiler stops. If
+ *       sampling runs, stop from the thread that started it.
+ *
+ * @author Vitor Betmann
+ */
+int pfStop(void);
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Prototypes - Zones
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Records the start of a zone. Use `PF_BEGIN_ZONE` instead.
+ *
+ * @param name Name shown in the trace.
+ *
+ * @author Vitor Betmann
+ */
+void pfInternalBeginZone(const char *name);
+
+/**
+ * @brief Records the end of a zone. Use `PF_END_ZONE` instead.
+ *
+ * @author Vitor Betmann
+ */
+void pfInternalEndZone(void);
+
+
+#endif
@@ -13,6 +13,22 @@
 #define SMILE_SCENE_MANAGER_H
 
 
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Payload capacity of an smMessage, chosen so a whole message is 64 bytes.
+#define SM_MESSAGE_DATA_SIZE 56
+
+
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Data Types
 // —————————————————————————————————————————————————————————————————————————————————————————————————
@@ -49,6 +65,286 @@ typedef void (*smDrawFn)(void);
  */
 typedef void (*smExitFn)(void);
 
+/**
+ * @brief Function pointer type for scene suspend callbacks.
+ *
+ * Called instead of the exit callback when a scene is kept in SceneManager's
+ * suspended-scene cache.
+ *
+ * @author Vitor Betmann
+ */
+typedef void (*smSuspendFn)(void);
+
+/**
+ * @brief Function pointer type for scene resume callbacks.
+ *
+ * Called instead of the enter callback when a suspended scene becomes active
+ * again.
+ *
+ * @param args Optional arguments passed when resuming the scene.
+ *
+ * @author Vitor Betmann
+ */
+typedef void (*smResumeFn)(void *args);
+
+/**
+ * @brief Function pointer type for incremental scene loaders.
+ *
+ * Called repeatedly, across frames, until it reports that the scene finished
+ * loading. Each call should perform a small slice of work and return.
+ *
+ * @param args Optional arguments passed to `smSetScene()`.
+ *
+ * @return Returns true when loading is complete, false to be called again.
+ *
+ * @author Vitor Betmann
+ */
+typedef bool (*smLoadFn)(void *args);
+
+/**
+ * @brief Function pointer type for idle tasks.
+ *
+ * Called during the idle time left before a frame deadline. Each call should
+ * perform a small slice of work and return, since the deadline is only checked
+ * between calls.
+ *
+ * @param args Optional arguments passed to `smPostIdleTask()`.
+ *
+ * @return Returns true when the task is complete, false to be called again.
+ *
+ * @author Vitor Betmann
+ */
+typedef bool (*smIdleFn)(void *args);
+
+/**
+ * @brief Fixed-size message posted with `smPostMessage()`.
+ *
+ * `type` is chosen by the game to tell messages apart. Only the first `size`
+ * bytes of `data` were written by the sender. `data` is 8-byte aligned, so
+ * payloads of plain scalars or small structs can be read in place.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    uint32_t type;
+    uint32_t size;
+    unsigned char data[SM_MESSAGE_DATA_SIZE];
+} smMessage;
+
+/**
+ * @brief Function pointer type for scene message handlers.
+ *
+ * Called from `smUpdate()` on the thread running SceneManager, once per queued
+ * message.
+ *
+ * @param message The message, valid only for the duration of the call.
+ *
+ * @author Vitor Betmann
+ */
+typedef void (*smMessageFn)(const smMessage *message);
+
+/**
+ * @brief Function pointer type for timer callbacks.
+ *
+ * Called from `smUpdate()` when a timer started with `smAddTimer()` expires.
+ *
+ * @param args Optional arguments passed to `smAddTimer()`.
+ *
+ * @author Vitor Betmann
+ */
+typedef void (*smTimerFn)(void *args);
+
+/**
+ * @brief Handle to a timer started with `smAddTimer()`.
+ *
+ * `0` is never a valid handle, so it can mark "no timer". Handles of expired or
+ * cancelled timers stay invalid even after their slot is reused.
+ *
+ * @author Vitor Betmann
+ */
+typedef uint64_t smTimerId;
+
+/**
+ * @brief Handle to a tween started with `smAddTween()`.
+ *
+ * Follows the same rules as `smTimerId`: `0` is never valid, and handles of
+ * finished or cancelled tweens stay invalid.
+ *
+ * @author Vitor Betmann
+ */
+typedef uint64_t smTweenId;
+
+/**
+ * @brief Describes a scene for bulk registration with `smRegisterScenes()`.
+ *
+ * @note Ownership: `name` is not copied, so it must outlive SceneManager.
+ *       String literals are the intended use.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    const char *name;
+    smEnterFn enter;
+    smUpdateFn update;
+    smDrawFn draw;
+    smExitFn exit;
+} smSceneDesc;
+
+/**
+ * @brief Compile-time scene table with a minimal perfect hash over its names.
+ *
+ * Generated by `GenScene --registry`. A name is looked up by hashing it with
+ * seed `0` to pick one of `seedCount` buckets, then hashing it again with that
+ * bucket's seed to get its index in `scenes`.
+ *
+ * @note Ownership: the table is borrowed and must outlive SceneManager.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    const smSceneDesc *scenes;
+    size_t sceneCount;
+    const uint32_t *seeds;
+    size_t seedCount;
+} smSceneRegistry;
+
+/**
+ * @brief Quality levels published by the frame-budget governor.
+ *
+ * Scenes can read the level in their update and draw callbacks to scale work
+ * such as particle counts or AI ticks. Levels are ordered, so they can be
+ * compared.
+ *
+ * @see smGetQualityLevel
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    SM_QUALITY_LOW,
+    SM_QUALITY_MEDIUM,
+    SM_QUALITY_HIGH,
+    SM_QUALITY_FULL,
+} smQualityLevel;
+
+/**
+ * @brief Clocks SceneManager can read time from.
+ *
+ * - `SM_CLOCK_MONOTONIC`: the default; slewed by NTP, stops during system
+ *   suspend.
+ * - `SM_CLOCK_MONOTONIC_RAW`: not slewed by NTP. Linux and macOS.
+ * - `SM_CLOCK_BOOTTIME`: keeps counting during system suspend. Linux only.
+ * - `SM_CLOCK_TSC`: the CPU time-stamp counter, calibrated against
+ *   `SM_CLOCK_MONOTONIC`. Skips the system call entirely, which makes it the
+ *   cheapest to read. x86 CPUs with an invariant TSC only.
+ *
+ * @see smSetClockSource
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    SM_CLOCK_MONOTONIC,
+    SM_CLOCK_MONOTONIC_RAW,
+    SM_CLOCK_BOOTTIME,
+    SM_CLOCK_TSC,
+} smClockSource;
+
+/**
+ * @brief Producer models for the message queue.
+ *
+ * - `SM_MESSAGES_MPSC`: the default; any number of threads may post at once.
+ * - `SM_MESSAGES_SPSC`: at most one thread posts at a time. Posting skips the
+ *   compare-and-swap the multi-producer mode needs, which makes it cheaper.
+ *
+ * Either way, messages are only ever consumed by `smUpdate()`.
+ *
+ * @see smSetMessageMode
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    SM_MESSAGES_MPSC,
+    SM_MESSAGES_SPSC,
+} smMessageMode;
+
+/**
+ * @brief Smoothing applied to delta time by `smDtFilter`.
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    SM_DT_FILTER_NONE,
+    SM_DT_FILTER_EMA,
+    SM_DT_FILTER_MEDIAN,
+} smDtFilterMode;
+
+/**
+ * @brief Easing curves for `smAddTween()`.
+ *
+ * Each maps progress from `0` to `1` onto eased progress from `0` to `1`.
+ * `IN` curves start slow, `OUT` curves end slow, and `IN_OUT` curves do both.
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    SM_EASE_LINEAR,
+    SM_EASE_IN_QUAD,
+    SM_EASE_OUT_QUAD,
+    SM_EASE_IN_OUT_QUAD,
+    SM_EASE_IN_CUBIC,
+    SM_EASE_OUT_CUBIC,
+    SM_EASE_IN_OUT_CUBIC,
+    SM_EASE_SMOOTHSTEP,
+} smEasing;
+
+/**
+ * @brief Filtering applied by `smGetDt()` before it returns.
+ *
+ * Stages run in field order: outliers are clamped to `maxDt`, the result is
+ * smoothed according to `mode`, then snapped to a multiple of `snapInterval`
+ * when it is within 10% of one. Time removed or added by snapping is carried
+ * into the next frame, so snapped deltas still add up to the elapsed time.
+ * Zeroed fields disable their stage.
+ *
+ * - `SM_DT_FILTER_EMA`: exponential moving average; `smoothing` is the weight
+ *   of the newest sample, in `(0, 1]`.
+ * - `SM_DT_FILTER_MEDIAN`: median of the last 5 samples, which ignores
+ *   isolated spikes entirely.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    float maxDt;
+    smDtFilterMode mode;
+    float smoothing;
+    float snapInterval;
+} smDtFilter;
+
+/**
+ * @brief Hardware counter totals of one scene callback, summed over its calls.
+ *
+ * Filled by `smGetScenePerfCounters()`. Counters the CPU or kernel does not
+ * offer stay `0`.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    uint64_t calls;
+    uint64_t cycles;
+    uint64_t instructions;
+    uint64_t cacheMisses;
+    uint64_t branchMisses;
+} smPerfCounters;
+
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Prototypes
@@ -110,6 +406,54 @@ bool smIsRunning(void);
 int smCreateScene(const char *name, smEnterFn enter, smUpdateFn update,
                   smDrawFn draw, smExitFn exit);
 
+/**
+ * @brief Registers a table of scenes in one call.
+ *
+ * Validates every descriptor before registering any of them, then builds all
+ * scenes with a single allocation. Either every scene is registered or none
+ * is.
+ *
+ * @param descs Table of scene descriptors.
+ * @param count Number of descriptors in `descs`.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; `descs` is null; `count` is
+ *       zero; any name is null, empty, already registered, or repeated in the
+ *       table; or any descriptor has all callbacks null.
+ * @note Ownership: names are borrowed, not copied, and must outlive
+ *       SceneManager.
+ * @note Logging: a single info message for the whole table.
+ *
+ * @see smCreateScene
+ *
+ * @author Vitor Betmann
+ */
+int smRegisterScenes(const smSceneDesc *descs, size_t count);
+
+/**
+ * @brief Uses a generated scene registry as SceneManager's scene table.
+ *
+ * Registry scenes are found through the registry's perfect hash instead of
+ * being inserted into the runtime hash map, so no names are copied or hashed
+ * at startup.
+ *
+ * @param registry Registry generated by `GenScene --registry`.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; `registry` or its tables are
+ *       null; a registry is already set; or a registry name is already
+ *       registered.
+ * @note Registry scenes cannot be deleted.
+ * @note Ownership: `registry` is borrowed and must outlive SceneManager.
+ *
+ * @see smRegisterScenes
+ *
+ * @author Vitor Betmann
+ */
+int smSetRegistry(const smSceneRegistry *registry);
+
 /**
  * @brief Checks whether a scene with the given name exists.
  *
@@ -138,8 +482,13 @@ bool smSceneExists(const char *name);
  * @note Fails if: SceneManager is not running; `name` is null or empty; or
  *       the target scene does not exist.
  * @note Side effects: if an active scene has an exit callback, it is called
- *       before switching; then target scene enter callback is called.
- * @note Ownership: `args` is borrowed for the duration of the enter callback.
+ *       before switching; then target scene enter callback is called. Scenes
+ *       with a suspend callback that fit the suspend budget are suspended
+ *       instead of exited, and suspended target scenes are resumed instead of
+ *       entered. Scenes with a loader are activated by `smUpdate()` once
+ *       loading completes.
+ * @note Ownership: `args` is borrowed for the duration of the enter callback,
+ *       or until loading completes for scenes with a loader.
  *
  * @see smGetCurrentSceneName
  * @see smCreateScene
@@ -148,6 +497,135 @@ bool smSceneExists(const char *name);
  */
 int smSetScene(const char *name, void *args);
 
+/**
+ * @brief Sets the suspend and resume callbacks of an existing scene.
+ *
+ * A scene with a suspend callback is kept in SceneManager's suspended-scene
+ * cache when another scene is set, so switching back to it calls its resume
+ * callback instead of its enter callback.
+ *
+ * @param name Name of the scene to configure.
+ * @param suspend Callback executed when the scene is suspended, or `nullptr`
+ *        to always exit the scene.
+ * @param resume Callback executed when the scene is resumed. May be `nullptr`.
+ * @param memoryCost Memory, in bytes, the scene keeps alive while suspended.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; `name` is null or empty; or
+ *       the scene does not exist.
+ * @note Side effects: if the scene is suspended and `suspend` is `nullptr`,
+ *       it is evicted through its exit callback.
+ *
+ * @see smSetSuspendBudget
+ * @see smIsSceneSuspended
+ *
+ * @author Vitor Betmann
+ */
+int smSetSceneSuspend(const char *name, smSuspendFn suspend, smResumeFn resume,
+                      size_t memoryCost);
+
+/**
+ * @brief Sets the total memory, in bytes, suspended scenes may keep alive.
+ *
+ * @param budget Memory budget for the suspended-scene cache. `0` disables
+ *        suspension.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running.
+ * @note Side effects: least recently used suspended scenes are evicted through
+ *       their exit callbacks until the cache fits the new budget.
+ *
+ * @see smSetSceneSuspend
+ *
+ * @author Vitor Betmann
+ */
+int smSetSuspendBudget(size_t budget);
+
+/**
+ * @brief Checks whether a scene is currently held in the suspended-scene cache.
+ *
+ * @param name Name of the scene to check.
+ *
+ * @return Returns true when the scene is suspended, false otherwise.
+ *
+ * @note Returns false if: SceneManager is not running; `name` is null or
+ *       empty; or the scene does not exist.
+ *
+ * @see smSetSceneSuspend
+ *
+ * @author Vitor Betmann
+ */
+bool smIsSceneSuspended(const char *name);
+
+/**
+ * @brief Sets the incremental loader of an existing scene.
+ *
+ * When a scene has a loader, `smSetScene()` does not switch immediately.
+ * Instead, `smUpdate()` calls the loader each frame within the load budget
+ * until it reports completion, and only then makes the scene active and calls
+ * its enter callback, if any.
+ *
+ * @param name Name of the scene to configure.
+ * @param load Incremental loader, or `nullptr` to enter the scene in one step.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; `name` is null or empty; or
+ *       the scene does not exist.
+ *
+ * @see smSetLoadBudget
+ * @see smSetLoadingScene
+ *
+ * @author Vitor Betmann
+ */
+int smSetSceneLoader(const char *name, smLoadFn load);
+
+/**
+ * @brief Sets the scene shown while an incremental loader runs.
+ *
+ * @param name Name of the loading scene, or `nullptr` to keep the previous
+ *        scene active while loading.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; `name` is empty; or the scene
+ *       does not exist.
+ *
+ * @see smSetSceneLoader
+ *
+ * @author Vitor Betmann
+ */
+int smSetLoadingScene(const char *name);
+
+/**
+ * @brief Sets how long incremental loaders may run each frame.
+ *
+ * @param budgetMs Time budget, in milliseconds. The loader is always called at
+ *        least once per frame, even when the budget is `0`.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running or `budgetMs` is negative.
+ *
+ * @see smSetSceneLoader
+ *
+ * @author Vitor Betmann
+ */
+int smSetLoadBudget(float budgetMs);
+
+/**
+ * @brief Checks whether a scene is currently being loaded incrementally.
+ *
+ * @return Returns true while a loader is pending, false otherwise.
+ *
+ * @see smSetSceneLoader
+ *
+ * @author Vitor Betmann
+ */
+bool smIsSceneLoading(void);
+
 /**
  * @brief Retrieves the name of the currently active scene.
  *
@@ -175,7 +653,9 @@ const char *smGetCurrentSceneName(void);
  * @return Returns `0` on success, or a negative error code on failure.
  *
  * @note Fails if: SceneManager is not running; `name` is null or empty; the
- *       scene does not exist; or `name` is the currently active scene.
+ *       scene does not exist; `name` is the currently active or loading
+ *       scene; or the scene comes from a registry.
+ * @note Side effects: a suspended scene is exited before it is deleted.
  *
  * @see smCreateScene
  * @see smSceneExists
@@ -209,14 +689,22 @@ int smGetSceneCount(void);
  *
  * @note Fails if: SceneManager is not running; no scene is active; or the
  *       active scene has no update callback.
+ * @note Side effects: runs the pending incremental loader, if any, within the
+ *       load budget before updating the active scene.
  * @note Logging: warning when active scene has no update callback.
+ * @note With `SMILE_UNCHECKED`, this is `smCheckedUpdate()` and `smUpdate()`
+ *       becomes an inline fast path (see the end of this header).
  *
  * @see smGetDt
  * @see smDraw
  *
  * @author Vitor Betmann
  */
+#ifdef SMILE_UNCHECKED
+int smCheckedUpdate(float dt);
+#else
 int smUpdate(float dt);
+#endif
 
 /**
  * @brief Calculates the delta time, in seconds, since last invoked.
@@ -224,17 +712,41 @@ int smUpdate(float dt);
  * @return Returns the elapsed time in seconds since the previous call to
  *         `smGetDt()`, or a negative error code (as `float`) on failure.
  *
- * @note Delta time is measured using a high-resolution monotonic clock. On the
- *       first call, it returns a duration equivalent to one frame at the
- *       configured target FPS (currently 60 by default).
+ * @note Delta time is measured in integer nanoseconds on the clock selected
+ *       with `smSetClockSource()` and only converted to seconds at the end. On
+ *       the first call, it returns a duration equivalent to one frame at the
+ *       target FPS (60 by default). Later deltas go through the filter set with
+ *       `smSetDtFilter()`, if any.
  * @note Fails if: SceneManager is not running or time acquisition fails.
  *
  * @see smUpdate
+ * @see smSetTargetFps
+ * @see smSetClockSource
+ * @see smSetDtFilter
  *
  * @author Vitor Betmann
  */
 float smGetDt(void);
 
+/**
+ * @brief Sets how `smGetDt()` filters delta time before returning it.
+ *
+ * @param filter Filter settings to copy, or `nullptr` to return raw delta time
+ *        again, which is the default.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; `mode` is not an
+ *       `smDtFilterMode`; `mode` is `SM_DT_FILTER_EMA` and `smoothing` is
+ *       outside `(0, 1]`; or `maxDt` or `snapInterval` is negative.
+ * @note Side effects: clears the history of previous delta times.
+ *
+ * @see smGetDt
+ *
+ * @author Vitor Betmann
+ */
+int smSetDtFilter(const smDtFilter *filter);
+
 /**
  * @brief Executes the draw function of the currently active scene.
  *
@@ -243,12 +755,387 @@ float smGetDt(void);
  * @note Fails if: SceneManager is not running; no scene is active; or the
  *       active scene has no draw callback.
  * @note Logging: warning when active scene has no draw callback.
+ * @note With `SMILE_UNCHECKED`, this is `smCheckedDraw()` and `smDraw()`
+ *       becomes an inline fast path (see the end of this header).
  *
  * @see smUpdate
  *
  * @author Vitor Betmann
  */
+#ifdef SMILE_UNCHECKED
+int smCheckedDraw(void);
+#else
 int smDraw(void);
+#endif
+
+// Frame Pacing
+
+/**
+ * @brief Selects the clock used for delta time, frame pacing, and load
+ *        budgets.
+ *
+ * @param source Clock to read time from.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; `source` is not an
+ *       `smClockSource`; the clock is not available on this platform or CPU;
+ *       or TSC calibration cannot read `SM_CLOCK_MONOTONIC`.
+ * @note Side effects: switching to `SM_CLOCK_TSC` for the first time blocks
+ *       for about 10 ms while the TSC frequency is measured. Timing restarts
+ *       as if on the first frame, so the next `smGetDt()` call returns one
+ *       frame at the target FPS.
+ *
+ * @see smGetDt
+ * @see smWaitForNextFrame
+ *
+ * @author Vitor Betmann
+ */
+int smSetClockSource(smClockSource source);
+
+/**
+ * @brief Sets the frame rate `smWaitForNextFrame()` paces frames to.
+ *
+ * @param fps Target frames per second.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running or `fps` is not positive.
+ *
+ * @see smWaitForNextFrame
+ * @see smGetDt
+ *
+ * @author Vitor Betmann
+ */
+int smSetTargetFps(int fps);
+
+/**
+ * @brief Runs idle tasks and then sleeps until the next frame deadline.
+ *
+ * Call once per frame, after `smDraw()`. Deadlines are one frame apart at the
+ * target FPS; the first call, and any call made after its deadline has
+ * passed, returns immediately and starts a new schedule from the current time
+ * instead of shortening later frames to catch up.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running or time acquisition fails.
+ * @note Side effects: idle tasks run in posting order until the queue is empty
+ *       or the deadline is reached. A task that returns false is moved to the
+ *       back of the queue and may run again in the same frame if time remains.
+ *
+ * @see smSetTargetFps
+ * @see smPostIdleTask
+ *
+ * @author Vitor Betmann
+ */
+int smWaitForNextFrame(void);
+
+/**
+ * @brief Sets the frame cost the quality governor aims to stay under.
+ *
+ * @param budgetMs Frame budget, in milliseconds. `0` uses one frame at the
+ *        target FPS, which is the default.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running or `budgetMs` is negative.
+ *
+ * @see smGetQualityLevel
+ *
+ * @author Vitor Betmann
+ */
+int smSetFrameBudget(float budgetMs);
+
+/**
+ * @brief Retrieves the quality level scenes should currently render at.
+ *
+ * Each `smWaitForNextFrame()` call measures the time spent since the previous
+ * one returned, leaving out idle tasks and sleep, and folds it into a moving
+ * average. The level drops one step after the average stays near or over the
+ * frame budget for 10 frames, and rises one step only after it stays well
+ * under the budget for 120 frames, so it does not flap between levels.
+ *
+ * @return Returns an `smQualityLevel` on success, or a negative error code on
+ *         failure. Starts at `SM_QUALITY_FULL`, and stays there if
+ *         `smWaitForNextFrame()` is never called.
+ *
+ * @note Fails if: SceneManager is not running.
+ * @note Logging: info when the level changes.
+ *
+ * @see smSetFrameBudget
+ * @see smWaitForNextFrame
+ *
+ * @author Vitor Betmann
+ */
+int smGetQualityLevel(void);
+
+/**
+ * @brief Queues a low-priority task to run during idle frame time.
+ *
+ * Suited to work that can wait, such as cache warming or save preparation.
+ * Tasks only run inside `smWaitForNextFrame()` and never delay a frame that
+ * already missed its deadline.
+ *
+ * @param task Task to run. Called until it returns true.
+ * @param args Optional arguments passed to @p task.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; @p task is null; or the queue
+ *       already holds its maximum of 64 tasks.
+ * @note Side effects: the task belongs to the scene that is current when it is
+ *       posted and is dropped without being called again when that scene
+ *       exits. Suspending the scene keeps its tasks. `smStop()` drops all
+ *       tasks.
+ *
+ * @see smWaitForNextFrame
+ *
+ * @author Vitor Betmann
+ */
+int smPostIdleTask(smIdleFn task, void *args);
+
+// Messaging
+
+/**
+ * @brief Sets the message handler of an existing scene.
+ *
+ * While the scene is active, `smUpdate()` passes it every queued message
+ * before calling its update callback.
+ *
+ * @param name Name of the scene to configure.
+ * @param handleMessage Message handler, or `nullptr` to discard messages that
+ *        arrive while the scene is active.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; `name` is null or empty; or
+ *       the scene does not exist.
+ *
+ * @see smPostMessage
+ *
+ * @author Vitor Betmann
+ */
+int smSetSceneMessageHandler(const char *name, smMessageFn handleMessage);
+
+/**
+ * @brief Selects whether one or many threads may post messages.
+ *
+ * @param mode Producer model to use. Defaults to `SM_MESSAGES_MPSC`.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running, or @p mode is not a valid
+ *       `smMessageMode`.
+ * @note Must not be called while another thread is posting.
+ *
+ * @see smPostMessage
+ *
+ * @author Vitor Betmann
+ */
+int smSetMessageMode(smMessageMode mode);
+
+/**
+ * @brief Queues a message for the active scene.
+ *
+ * Safe to call from any thread, including from a message handler. Posting
+ * never locks or allocates: the message is copied into a preallocated ring of
+ * 256 slots. Queued messages are delivered in order at the start of the next
+ * `smUpdate()`, right after any incremental loader runs.
+ *
+ * @param type Game-defined message type.
+ * @param data Payload to copy, or `nullptr` when @p size is `0`.
+ * @param size Payload size in bytes, at most `SM_MESSAGE_DATA_SIZE`.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; @p size is too large or @p data
+ *       is null while @p size is not `0`; or the queue is full.
+ * @note Messages are dropped when the scene they reach has no handler, and
+ *       wait in the queue while no scene is active. `smStop()` drops them all,
+ *       so other threads must stop posting before it is called.
+ *
+ * @see smSetSceneMessageHandler
+ * @see smSetMessageMode
+ *
+ * @author Vitor Betmann
+ */
+int smPostMessage(uint32_t type, const void *data, size_t size);
+
+// Timers
+
+/**
+ * @brief Starts a one-shot or repeating timer owned by the active scene.
+ *
+ * Timers run on the delta time passed to `smUpdate()`, which advances them
+ * after delivering messages and before calling the scene's update callback.
+ * They are kept in a hierarchical timing wheel with millisecond ticks, so
+ * starting, cancelling, and advancing with nothing due all take constant
+ * time regardless of how many timers exist.
+ *
+ * @param delay Seconds until the first expiry, rounded to the nearest
+ *        millisecond. Timers always wait at least one millisecond.
+ * @param interval Seconds between later expiries, or `0` for a one-shot
+ *        timer.
+ * @param fn Callback to call on each expiry.
+ * @param args Optional arguments passed to @p fn.
+ * @param id Optional output for the handle used to cancel the timer.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; @p fn is null; @p delay or
+ *       @p interval is negative or not a number; or memory allocation fails.
+ * @note Side effects: the timer belongs to the scene that is current when it
+ *       is started and is cancelled when that scene exits. Suspending the
+ *       scene keeps its timers running. `smStop()` cancels all timers.
+ * @note When an update spans several expiries of a repeating timer, the
+ *       callback is called once per expiry.
+ *
+ * @see smCancelTimer
+ *
+ * @author Vitor Betmann
+ */
+int smAddTimer(float delay, float interval, smTimerFn fn, void *args, smTimerId *id);
+
+/**
+ * @brief Cancels a pending timer.
+ *
+ * @param id Handle returned by `smAddTimer()`.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running, or @p id does not name a
+ *       pending timer, such as a one-shot timer that already fired.
+ *
+ * @see smAddTimer
+ *
+ * @author Vitor Betmann
+ */
+int smCancelTimer(smTimerId id);
+
+// Tweens
+
+/**
+ * @brief Animates a float from one value to another, owned by the active
+ *        scene.
+ *
+ * `smUpdate()` advances every tween after timers and before the scene's update
+ * callback, writing the eased value straight into @p target. Tweens are stored
+ * as parallel arrays grouped by easing curve and stepped in tight loops, with
+ * no per-tween function call. That makes thousands of UI or camera tweens
+ * cheap. Finished tweens write @p to exactly and are removed.
+ *
+ * @param target Float to animate. Must stay valid until the tween finishes,
+ *        is cancelled, or its scene exits.
+ * @param from Starting value, written on the first update.
+ * @param to Final value.
+ * @param duration Length of the tween in seconds.
+ * @param easing Curve applied to the tween's progress.
+ * @param id Optional output for the handle used to cancel the tween.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; @p target is null;
+ *       @p duration is not positive; @p easing is not a valid `smEasing`; or
+ *       memory allocation fails.
+ * @note Side effects: the tween belongs to the scene that is current when it
+ *       is started and is cancelled, leaving @p target as it is, when that
+ *       scene exits. `smStop()` cancels all tweens.
+ * @note Tweens have no completion callback. Pair one with `smAddTimer()` when
+ *       something must happen at the end.
+ *
+ * @see smCancelTween
+ *
+ * @author Vitor Betmann
+ */
+int smAddTween(float *target, float from, float to, float duration, smEasing easing,
+               smTweenId *id);
+
+/**
+ * @brief Cancels a running tween, leaving its target at its current value.
+ *
+ * @param id Handle returned by `smAddTween()`.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running, or @p id does not name a
+ *       running tween.
+ *
+ * @see smAddTween
+ *
+ * @author Vitor Betmann
+ */
+int smCancelTween(smTweenId id);
+
+/**
+ * @brief Turns stepping large tween groups across worker threads on or off.
+ *
+ * While on, SceneManager holds a share of Smile's worker pool, starting it if
+ * no other module has, and `smUpdate()` splits any easing group of 4096 or
+ * more tweens into batches run on the pool. Smaller groups always run on the
+ * calling thread.
+ *
+ * @param isEnabled `true` to start using the pool, `false` to release it.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running, memory allocation fails, or a
+ *       worker thread cannot be created. Tweens keep running on the calling
+ *       thread either way.
+ * @note `smStop()` releases the pool.
+ *
+ * @see smAddTween
+ *
+ * @author Vitor Betmann
+ */
+int smSetParallelTweens(bool isEnabled);
+
+// Performance Counters
+
+/**
+ * @brief Turns hardware performance counters around scene callbacks on or off.
+ *
+ * While on, each `update` and `draw` dispatched by `smUpdate()` and `smDraw()`
+ * adds its cycles, instructions, cache misses and branch misses to the current
+ * scene's totals. Linux only.
+ *
+ * @param isEnabled `true` to open the counters, `false` to close them.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running, or no counter can be opened
+ *       (`RES_PERF_UNAVAILABLE`), e.g. off Linux, in a VM without a virtual
+ *       PMU, or under a restrictive `perf_event_paranoid`. SceneManager keeps
+ *       running without counters either way.
+ * @note Only the calling thread's work is counted, so call this from the thread
+ *       that runs `smUpdate()` and `smDraw()`.
+ * @note Logging: warning when some or all counters are unavailable.
+ *
+ * @see smGetScenePerfCounters
+ *
+ * @author Vitor Betmann
+ */
+int smSetPerfCounters(bool isEnabled);
+
+/**
+ * @brief Reads the hardware counter totals of a scene's callbacks.
+ *
+ * @param name Name of the scene.
+ * @param update Optional output for the totals of its `update` calls.
+ * @param draw Optional output for the totals of its `draw` calls.
+ *
+ * @return Returns `0` on success, or a negative error code on failure.
+ *
+ * @note Fails if: SceneManager is not running; @p name is null or empty; or no
+ *       scene has that name.
+ * @note Totals are all `0` for scenes never measured. A call during which the
+ *       scene was switched away from is not counted.
+ *
+ * @see smSetPerfCounters
+ *
+ * @author Vitor Betmann
+ */
+int smGetScenePerfCounters(const char *name, smPerfCounters *update, smPerfCounters *draw);
 
 // Stop Related
 
@@ -259,8 +1146,10 @@ int smDraw(void);
  *
  * @note Fails if: SceneManager is not running, or internal cleanup invariants
  *       fail.
- * @note Side effects: current scene exit callback is called before cleanup.
- *       All internal data is reset after stop; restart with `smStart()`.
+ * @note Side effects: current, loading, and suspended scene exit callbacks are
+ *       called before cleanup. All internal data is reset after stop; restart with `smStart()`.
+ * @note If the Profiler is sampling with an output path, the folded stacks are
+ *       written there once every exit callback has run.
  *
  * @see smStart
  * @see smIsRunning
@@ -270,4 +1159,64 @@ int smDraw(void);
 int smStop(void);
 
 
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Unchecked Fast Path
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef SMILE_UNCHECKED
+
+#include <stdatomic.h>
+
+/* Not part of the API; never assign them. SceneManager points them straight at
+ * the active scene's callbacks whenever the scene can be called without any
+ * checks, and at the checked functions otherwise (before smStart(), while
+ * loading, when the callback is missing, when the scene handles messages, while
+ * messages are queued, while timers or tweens are pending, or while
+ * performance counters are on or Metrics is publishing SceneManager's timings).
+ */
+extern _Atomic(smUpdateFn) smInternalCachedUpdate;
+extern smDrawFn smInternalCachedDraw;
+
+/**
+ * @brief Updates the currently active scene without validation.
+ *
+ * Compiled in with `SMILE_UNCHECKED` for tight loops such as headless
+ * simulation: one indirect call, with no running or null checks.
+ *
+ * @param dt Delta time in seconds since the last update.
+ *
+ * @return Always returns `0`. Failures are still logged through
+ *         `smCheckedUpdate()`, but not reported.
+ *
+ * @see smCheckedUpdate
+ *
+ * @author Vitor Betmann
+ */
+static inline int smUpdate(float dt)
+{
+    // Relaxed, so just a plain load; smPostMessage() may store from another thread.
+    atomic_load_explicit(&smInternalCachedUpdate, memory_order_relaxed)(dt);
+    return 0;
+}
+
+/**
+ * @brief Executes the draw function of the currently active scene without
+ *        validation.
+ *
+ * @return Always returns `0`. Failures are still logged through
+ *         `smCheckedDraw()`, but not reported.
+ *
+ * @see smCheckedDraw
+ *
+ * @author Vitor Betmann
+ */
+static inline int smDraw(void)
+{
+    smInternalCachedDraw();
+    return 0;
+}
+
+#endif
+
+
 #endif
@@ -27,6 +27,7 @@
 #include "LogInternal.h"
 // Support
 #include "internal/Common/Common.h"
+#include "Profiler.h"
 
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
@@ -209,6 +210,7 @@ static int lgPrivateLogV(lgInternalLevel lvl, const char *ori, const char *msg,
         return RES_TIME_FAIL;
     }
 
+    PF_BEGIN_ZONE("Log Write");
     int prefixStatus = fprintf(stderr, "%s%s [%s %s] - ", color, timeBuf, ori, prefix);
     int messageStatus = vfprintf(stderr, msg, args);
     int suffixStatus = fprintf(stderr, "%s\n", SMILE_WHITE); // Reset color
@@ -217,6 +219,7 @@ static int lgPrivateLogV(lgInternalLevel lvl, const char *ori, const char *msg,
     {
         flushStatus = fflush(stderr);
     }
+    PF_END_ZONE();
 
     if (prefixStatus < 0 || messageStatus < 0 || suffixStatus < 0 ||
         flushStatus == EOF)
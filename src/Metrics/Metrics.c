@@ -0,0 +1,669 @@
+/**
+ * @file
+ * @brief Implementation of the Metrics module.
+ *
+ * @see Metrics.h
+ * @see MetricsInternal.h
+ * @see MetricsMessages.h
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+// Module Related
+#include "Metrics.h"
+#include "MetricsInternal.h"
+#include "MetricsMessages.h"
+// Support
+#include "internal/Common/Common.h"
+#include "internal/Common/CommonMessages.h"
+#include "internal/Common/CommonThreads.h"
+#include "internal/Test/Test.h"
+#include "LogInternal.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Variables
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static mtInternalTracker tracker;
+static thread_local mtInternalThreadSlots *threadSlots;
+static thread_local uint32_t threadSession;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Prototypes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Registers a metric, or returns the handle of the one already using the name.
+static int mtPrivateCreateMetric(const char *name, mtInternalKind kind, mtMetricId *id,
+                                 const char *fnName);
+
+/* Returns the metric behind a handle of the running session, or nullptr if the
+ * handle is stale, unknown or of another kind. Stores its index in `index` if
+ * not null.
+ */
+static mtInternalMetric *mtPrivateGetMetric(mtMetricId id, mtInternalKind kind,
+                                            uint32_t *index);
+
+/* Returns the calling thread's slots for the running session, creating and
+ * registering them on first use. Returns nullptr if allocation fails.
+ */
+static mtInternalThreadSlots *mtPrivateGetSlots(void);
+
+// Sums a counter over every thread's slots. The caller holds the lock.
+static uint64_t mtPrivateMergeCounter(uint32_t index);
+
+/* Sums a histogram's buckets over every thread's slots into `buckets` and
+ * fills `summary`. The caller holds the lock.
+ */
+static void mtPrivateMergeHistogram(uint32_t index, uint64_t *buckets,
+                                    mtHistogramSummary *summary);
+
+static uint32_t mtPrivateGetBucket(uint64_t value);
+
+// Returns a value inside the bucket, its midpoint for buckets wider than one.
+static uint64_t mtPrivateGetBucketValue(uint32_t bucket);
+
+// Writes every metric in the text or binary format. The caller holds the lock.
+static void mtPrivateWriteSnapshot(FILE *file, mtSnapshotFormat format);
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Public
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Start Related
+
+int mtStart(void)
+{
+    if (mtIsRunning())
+    {
+        lgInternalLog(WARN, ORI, CSE_ALREADY_RUNNING, __func__, CSQ_ABORT);
+        return RES_ALREADY_RUNNING;
+    }
+
+    cmInitMutex(&tracker.lock);
+    atomic_init(&tracker.metricCount, 0);
+    tracker.slots = nullptr;
+    tracker.lastSession++;
+    CM_STORE_RELEASE(&tracker.session, tracker.lastSession);
+
+    lgInternalLog(INFO, ORI, CSE_MODULE_START, __func__, CSQ_SUCCESS);
+    return RES_OK;
+}
+
+bool mtIsRunning(void) { return CM_LOAD_RELAXED(&tracker.session) != 0; }
+
+// Registry Related
+
+int mtCreateCounter(const char *name, mtMetricId *id)
+{
+    return mtPrivateCreateMetric(name, MT_KIND_COUNTER, id, __func__);
+}
+
+int mtCreateGauge(const char *name, mtMetricId *id)
+{
+    return mtPrivateCreateMetric(name, MT_KIND_GAUGE, id, __func__);
+}
+
+int mtCreateHistogram(const char *name, mtMetricId *id)
+{
+    return mtPrivateCreateMetric(name, MT_KIND_HISTOGRAM, id, __func__);
+}
+
+// Recording Related
+
+void mtAddCounter(mtMetricId id, uint64_t delta)
+{
+    uint32_t index;
+    if (!mtPrivateGetMetric(id, MT_KIND_COUNTER, &index))
+    {
+        return;
+    }
+    mtInternalThreadSlots *slots = mtPrivateGetSlots();
+    if (!slots)
+    {
+        return;
+    }
+
+    // Only this thread writes its slot, so a load and a store are enough.
+    atomic_uint_least64_t *counter = &slots->counters[index];
+    CM_STORE_RELAXED(counter, CM_LOAD_RELAXED(counter) + delta);
+}
+
+void mtSetGauge(mtMetricId id, int64_t value)
+{
+    mtInternalMetric *metric = mtPrivateGetMetric(id, MT_KIND_GAUGE, nullptr);
+    if (metric)
+    {
+        CM_STORE_RELAXED(&metric->gauge, value);
+    }
+}
+
+void mtRecordHistogram(mtMetricId id, uint64_t value)
+{
+    uint32_t index;
+    if (!mtPrivateGetMetric(id, MT_KIND_HISTOGRAM, &index))
+    {
+        return;
+    }
+    mtInternalThreadSlots *slots = mtPrivateGetSlots();
+    if (!slots)
+    {
+        return;
+    }
+
+    mtInternalHistogram *histogram = CM_LOAD_RELAXED(&slots->histograms[index]);
+    if (!histogram)
+    {
+        histogram = tsCalloc(1, sizeof(mtInternalHistogram));
+        if (!histogram)
+        {
+            return;
+        }
+        CM_STORE_RELAXED(&histogram->min, UINT64_MAX);
+        CM_STORE_RELEASE(&slots->histograms[index], histogram);
+    }
+
+    CM_STORE_RELAXED(&histogram->sum, CM_LOAD_RELAXED(&histogram->sum) + value);
+    if (value < CM_LOAD_RELAXED(&histogram->min))
+    {
+        CM_STORE_RELAXED(&histogram->min, value);
+    }
+    if (value > CM_LOAD_RELAXED(&histogram->max))
+    {
+        CM_STORE_RELAXED(&histogram->max, value);
+    }
+    // Last, so a merge that counts this value also sees it in min and max.
+    atomic_uint_least64_t *bucket = &histogram->buckets[mtPrivateGetBucket(value)];
+    CM_STORE_RELEASE(bucket, CM_LOAD_RELAXED(bucket) + 1);
+}
+
+// Reading Related
+
+int mtGetCounter(mtMetricId id, uint64_t *value)
+{
+    if (!cmIsRunning(mtIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!value)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "value", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+
+    uint32_t index;
+    if (!mtPrivateGetMetric(id, MT_KIND_COUNTER, &index))
+    {
+        lgInternalLog(WARN, ORI, CSE_METRIC_NOT_FOUND, __func__, CSQ_ABORT);
+        return RES_METRIC_NOT_FOUND;
+    }
+
+    cmLockMutex(&tracker.lock);
+    *value = mtPrivateMergeCounter(index);
+    cmUnlockMutex(&tracker.lock);
+    return RES_OK;
+}
+
+int mtGetGauge(mtMetricId id, int64_t *value)
+{
+    if (!cmIsRunning(mtIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!value)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "value", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+
+    const mtInternalMetric *METRIC = mtPrivateGetMetric(id, MT_KIND_GAUGE, nullptr);
+    if (!METRIC)
+    {
+        lgInternalLog(WARN, ORI, CSE_METRIC_NOT_FOUND, __func__, CSQ_ABORT);
+        return RES_METRIC_NOT_FOUND;
+    }
+
+    *value = CM_LOAD_RELAXED(&METRIC->gauge);
+    return RES_OK;
+}
+
+int mtGetHistogram(mtMetricId id, mtHistogramSummary *summary)
+{
+    if (!cmIsRunning(mtIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!summary)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "summary", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+
+    uint32_t index;
+    if (!mtPrivateGetMetric(id, MT_KIND_HISTOGRAM, &index))
+    {
+        lgInternalLog(WARN, ORI, CSE_METRIC_NOT_FOUND, __func__, CSQ_ABORT);
+        return RES_METRIC_NOT_FOUND;
+    }
+
+    uint64_t buckets[METRICS_BUCKETS];
+    cmLockMutex(&tracker.lock);
+    mtPrivateMergeHistogram(index, buckets, summary);
+    cmUnlockMutex(&tracker.lock);
+    return RES_OK;
+}
+
+// Snapshot Related
+
+int mtWriteSnapshot(const char *path, mtSnapshotFormat format)
+{
+    if (!cmIsRunning(mtIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!path)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "path", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+    if (!path[0])
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_EMPTY_ARG, "path", __func__, CSQ_ABORT);
+        return RES_EMPTY_ARG;
+    }
+    if (format != MT_SNAPSHOT_TEXT && format != MT_SNAPSHOT_BINARY)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "format", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    FILE *file = tsFopen(path, format == MT_SNAPSHOT_BINARY ? "wb" : "w");
+    if (!file)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_CREATE_FILE_FAIL, path, __func__, CSQ_ABORT);
+        return RES_CREATE_FILE_FAIL;
+    }
+
+    cmLockMutex(&tracker.lock);
+    mtPrivateWriteSnapshot(file, format);
+    cmUnlockMutex(&tracker.lock);
+
+    const bool HAS_WRITE_ERROR = ferror(file);
+    if (fclose(file) != 0 || HAS_WRITE_ERROR)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_CREATE_FILE_FAIL, path, __func__, CSQ_ABORT);
+        return RES_CREATE_FILE_FAIL;
+    }
+
+    lgInternalLogWithArg(INFO, ORI, CSE_SNAPSHOT_WRITTEN, path, __func__, CSQ_SUCCESS);
+    return RES_OK;
+}
+
+// Stop Related
+
+int mtStop(void)
+{
+    if (!cmIsRunning(mtIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    CM_STORE_RELAXED(&tracker.session, 0);
+
+    mtInternalThreadSlots *slots = tracker.slots;
+    while (slots)
+    {
+        mtInternalThreadSlots *next = slots->next;
+        for (uint32_t i = 0; i < METRICS_MAX; i++)
+        {
+            tsFree(CM_LOAD_RELAXED(&slots->histograms[i]));
+        }
+        tsFree(slots);
+        slots = next;
+    }
+    tracker.slots = nullptr;
+
+    const uint32_t COUNT = CM_LOAD_RELAXED(&tracker.metricCount);
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+        tsFree(tracker.metrics[i].name);
+        tracker.metrics[i].name = nullptr;
+    }
+    cmDestroyMutex(&tracker.lock);
+
+    if (tsReportAllocations("Metrics") > 0)
+    {
+        lgInternalLog(WARN, ORI, CSE_MEMORY_LEAKED, __func__, CSQ_SUCCESS);
+    }
+
+    lgInternalLog(INFO, ORI, CSE_MODULE_STOP, __func__, CSQ_SUCCESS);
+    return RES_OK;
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Private
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int mtPrivateCreateMetric(const char *name, mtInternalKind kind, mtMetricId *id,
+                          const char *fnName)
+{
+    if (!cmIsRunning(mtIsRunning, ORI, fnName))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!name)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "name", fnName, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+    if (!name[0])
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_EMPTY_ARG, "name", fnName, CSQ_ABORT);
+        return RES_EMPTY_ARG;
+    }
+    if (!id)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "id", fnName, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+
+    const uint64_t SESSION_BITS = (uint64_t)tracker.lastSession << 32;
+
+    cmLockMutex(&tracker.lock);
+    const uint32_t COUNT = CM_LOAD_RELAXED(&tracker.metricCount);
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+        const mtInternalMetric *METRIC = &tracker.metrics[i];
+        if (strcmp(METRIC->name, name) != 0)
+        {
+            continue;
+        }
+        cmUnlockMutex(&tracker.lock);
+
+        if (METRIC->kind != kind)
+        {
+            lgInternalLogWithArg(WARN, ORI, CSE_METRIC_KIND_MISMATCH, name, fnName, CSQ_ABORT);
+            return RES_METRIC_KIND_MISMATCH;
+        }
+        *id = SESSION_BITS | (i + 1);
+        return RES_OK;
+    }
+
+    if (COUNT == METRICS_MAX)
+    {
+        cmUnlockMutex(&tracker.lock);
+        lgInternalLogWithArg(WARN, ORI, CSE_METRIC_LIMIT_REACHED, name, fnName, CSQ_ABORT);
+        return RES_METRIC_LIMIT_REACHED;
+    }
+
+    const size_t NAME_SIZE = strlen(name) + 1;
+    char *nameCopy = tsMalloc(NAME_SIZE);
+    if (!nameCopy)
+    {
+        cmUnlockMutex(&tracker.lock);
+        lgInternalLog(ERROR, ORI, CSE_MEM_ALLOC_FAIL, fnName, CSQ_ABORT);
+        return RES_MEM_ALLOC_FAIL;
+    }
+    memcpy(nameCopy, name, NAME_SIZE);
+
+    mtInternalMetric *metric = &tracker.metrics[COUNT];
+    metric->name = nameCopy;
+    metric->kind = kind;
+    atomic_init(&metric->gauge, 0);
+
+    CM_STORE_RELEASE(&tracker.metricCount, COUNT + 1);
+    cmUnlockMutex(&tracker.lock);
+
+    *id = SESSION_BITS | (COUNT + 1);
+    lgInternalLogWithArg(INFO, ORI, CSE_METRIC_CREATED, name, fnName, CSQ_SUCCESS);
+    return RES_OK;
+}
+
+mtInternalMetric *mtPrivateGetMetric(mtMetricId id, mtInternalKind kind, uint32_t *index)
+{
+    const uint32_t SESSION = CM_LOAD_ACQUIRE(&tracker.session);
+    if (SESSION == 0 || id >> 32 != SESSION)
+    {
+        return nullptr;
+    }
+
+    const uint32_t SLOT = (uint32_t)id;
+    if (SLOT == 0 || SLOT > CM_LOAD_ACQUIRE(&tracker.metricCount))
+    {
+        return nullptr;
+    }
+
+    mtInternalMetric *metric = &tracker.metrics[SLOT - 1];
+    if (metric->kind != kind)
+    {
+        return nullptr;
+    }
+    if (index)
+    {
+        *index = SLOT - 1;
+    }
+    return metric;
+}
+
+mtInternalThreadSlots *mtPrivateGetSlots(void)
+{
+    const uint32_t SESSION = CM_LOAD_RELAXED(&tracker.session);
+    if (threadSession == SESSION)
+    {
+        return threadSlots;
+    }
+
+    // Cached only once allocated, so a failed allocation is retried on the next update.
+    mtInternalThreadSlots *slots = tsCalloc(1, sizeof(mtInternalThreadSlots));
+    if (!slots)
+    {
+        return nullptr;
+    }
+    threadSession = SESSION;
+    threadSlots = slots;
+
+    cmLockMutex(&tracker.lock);
+    slots->next = tracker.slots;
+    tracker.slots = slots;
+    cmUnlockMutex(&tracker.lock);
+
+    return slots;
+}
+
+uint64_t mtPrivateMergeCounter(uint32_t index)
+{
+    uint64_t total = 0;
+    for (mtInternalThreadSlots *slots = tracker.slots; slots; slots = slots->next)
+    {
+        total += CM_LOAD_RELAXED(&slots->counters[index]);
+    }
+    return total;
+}
+
+void mtPrivateMergeHistogram(uint32_t index, uint64_t *buckets, mtHistogramSummary *summary)
+{
+    *summary = (mtHistogramSummary){.min = UINT64_MAX};
+    memset(buckets, 0, METRICS_BUCKETS * sizeof(uint64_t));
+
+    for (mtInternalThreadSlots *slots = tracker.slots; slots; slots = slots->next)
+    {
+        const mtInternalHistogram *HISTOGRAM = CM_LOAD_ACQUIRE(&slots->histograms[index]);
+        if (!HISTOGRAM)
+        {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < METRICS_BUCKETS; i++)
+        {
+            const uint64_t BUCKET_COUNT = CM_LOAD_ACQUIRE(&HISTOGRAM->buckets[i]);
+            buckets[i] += BUCKET_COUNT;
+            summary->count += BUCKET_COUNT;
+        }
+        summary->sum += CM_LOAD_RELAXED(&HISTOGRAM->sum);
+        const uint64_t MIN = CM_LOAD_RELAXED(&HISTOGRAM->min);
+        const uint64_t MAX = CM_LOAD_RELAXED(&HISTOGRAM->max);
+        summary->min = MIN < summary->min ? MIN : summary->min;
+        summary->max = MAX > summary->max ? MAX : summary->max;
+    }
+
+    if (summary->count == 0)
+    {
+        summary->min = 0;
+        return;
+    }
+
+    const double QUANTILES[] = {0.5, 0.9, 0.99};
+    uint64_t *results[] = {&summary->p50, &summary->p90, &summary->p99};
+    uint64_t seen = 0;
+    uint32_t bucket = 0;
+    for (size_t q = 0; q < sizeof(QUANTILES) / sizeof(QUANTILES[0]); q++)
+    {
+        // The smallest value with at least this share of values at or below it.
+        const uint64_t RANK = (uint64_t)(QUANTILES[q] * (double)summary->count + 0.999999);
+        while (seen + buckets[bucket] < RANK)
+        {
+            seen += buckets[bucket];
+            bucket++;
+        }
+
+        uint64_t value = mtPrivateGetBucketValue(bucket);
+        value = value < summary->min ? summary->min : value;
+        value = value > summary->max ? summary->max : value;
+        *results[q] = value;
+    }
+}
+
+uint32_t mtPrivateGetBucket(uint64_t value)
+{
+    if (value < METRICS_SUB_BUCKETS)
+    {
+        return (uint32_t)value;
+    }
+
+#if defined(_MSC_VER)
+    unsigned long msb;
+    _BitScanReverse64(&msb, value);
+    const uint32_t EXPONENT = (uint32_t)msb;
+#else
+    const uint32_t EXPONENT = 63 - (uint32_t)__builtin_clzll(value);
+#endif
+    const uint32_t SHIFT = EXPONENT - METRICS_SUB_BUCKET_BITS;
+    const uint32_t SUB_BUCKET = (uint32_t)(value >> SHIFT) & (METRICS_SUB_BUCKETS - 1);
+    return (SHIFT + 1) * METRICS_SUB_BUCKETS + SUB_BUCKET;
+}
+
+uint64_t mtPrivateGetBucketValue(uint32_t bucket)
+{
+    if (bucket < 2 * METRICS_SUB_BUCKETS)
+    {
+        return bucket;
+    }
+
+    const uint32_t SHIFT = bucket / METRICS_SUB_BUCKETS - 1;
+    const uint64_t LOW = (uint64_t)(METRICS_SUB_BUCKETS + bucket % METRICS_SUB_BUCKETS) << SHIFT;
+    return LOW + ((1ull << SHIFT) >> 1);
+}
+
+void mtPrivateWriteSnapshot(FILE *file, mtSnapshotFormat format)
+{
+    const uint32_t COUNT = CM_LOAD_RELAXED(&tracker.metricCount);
+    if (format == MT_SNAPSHOT_BINARY)
+    {
+        const uint32_t HEADER[] = {METRICS_SNAPSHOT_VERSION, COUNT};
+        fwrite(METRICS_SNAPSHOT_MAGIC, 1, strlen(METRICS_SNAPSHOT_MAGIC), file);
+        fwrite(HEADER, sizeof(HEADER), 1, file);
+    }
+    else
+    {
+        fprintf(file, "# smile metrics v%d\n", METRICS_SNAPSHOT_VERSION);
+    }
+
+    uint64_t buckets[METRICS_BUCKETS];
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+        const mtInternalMetric *METRIC = &tracker.metrics[i];
+        const uint8_t KIND = (uint8_t)METRIC->kind;
+        const uint16_t NAME_LENGTH = (uint16_t)strlen(METRIC->name);
+        if (format == MT_SNAPSHOT_BINARY)
+        {
+            fwrite(&KIND, sizeof(KIND), 1, file);
+            fwrite(&NAME_LENGTH, sizeof(NAME_LENGTH), 1, file);
+            fwrite(METRIC->name, 1, NAME_LENGTH, file);
+        }
+
+        if (METRIC->kind == MT_KIND_COUNTER)
+        {
+            const uint64_t VALUE = mtPrivateMergeCounter(i);
+            if (format == MT_SNAPSHOT_BINARY)
+            {
+                fwrite(&VALUE, sizeof(VALUE), 1, file);
+            }
+            else
+            {
+                fprintf(file, "counter %s %" PRIu64 "\n", METRIC->name, VALUE);
+            }
+            continue;
+        }
+
+        if (METRIC->kind == MT_KIND_GAUGE)
+        {
+            const int64_t VALUE = CM_LOAD_RELAXED(&METRIC->gauge);
+            if (format == MT_SNAPSHOT_BINARY)
+            {
+                fwrite(&VALUE, sizeof(VALUE), 1, file);
+            }
+            else
+            {
+                fprintf(file, "gauge %s %" PRId64 "\n", METRIC->name, VALUE);
+            }
+            continue;
+        }
+
+        mtHistogramSummary summary;
+        mtPrivateMergeHistogram(i, buckets, &summary);
+        if (format == MT_SNAPSHOT_TEXT)
+        {
+            fprintf(file,
+                    "histogram %s count=%" PRIu64 " sum=%" PRIu64 " min=%" PRIu64 " p50=%" PRIu64
+                    " p90=%" PRIu64 " p99=%" PRIu64 " max=%" PRIu64 "\n",
+                    METRIC->name, summary.count, summary.sum, summary.min, summary.p50,
+                    summary.p90, summary.p99, summary.max);
+            continue;
+        }
+
+        const uint64_t TOTALS[] = {summary.count, summary.sum, summary.min, summary.max};
+        fwrite(TOTALS, sizeof(TOTALS), 1, file);
+        uint16_t usedBuckets = 0;
+        for (uint32_t b = 0; b < METRICS_BUCKETS; b++)
+        {
+            usedBuckets += buckets[b] > 0;
+        }
+        fwrite(&usedBuckets, sizeof(usedBuckets), 1, file);
+        for (uint16_t b = 0; b < METRICS_BUCKETS; b++)
+        {
+            if (buckets[b] > 0)
+            {
+                fwrite(&b, sizeof(b), 1, file);
+                fwrite(&buckets[b], sizeof(buckets[b]), 1, file);
+            }
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file
+ * @brief Declarations of internal data types for the Metrics module.
+ *
+ * @see Metrics.c
+ *
+ * @author Vitor Betmann
+ */
+
+#ifndef SMILE_METRICS_INTERNAL_H
+#define SMILE_METRICS_INTERNAL_H
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <stdalign.h>
+#include <stdint.h>
+// Support
+#include "internal/Common/CommonThreads.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#define METRICS_MAX 256
+
+/* Values below 8 get a bucket each. Every power of two above that is split
+ * into 8 equal buckets, which bounds the relative error to 1/8.
+ */
+#define METRICS_SUB_BUCKET_BITS 3
+#define METRICS_SUB_BUCKETS (1 << METRICS_SUB_BUCKET_BITS)
+#define METRICS_BUCKETS ((64 - METRICS_SUB_BUCKET_BITS + 1) * METRICS_SUB_BUCKETS)
+
+#define METRICS_SNAPSHOT_MAGIC "SMMT"
+#define METRICS_SNAPSHOT_VERSION 1
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Metrics-specific result codes.
+ *
+ * @note Metrics-specific failures cover the following range: `-100..-199`.
+ *
+ * @see  src/internal/Common/Common.h for common result codes
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    RES_METRIC_KIND_MISMATCH = -100,
+    RES_METRIC_LIMIT_REACHED = -101,
+    RES_METRIC_NOT_FOUND = -102,
+} mtInternalResult;
+
+/**
+ * @brief What a metric measures. Also stored in binary snapshots.
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    MT_KIND_COUNTER,
+    MT_KIND_GAUGE,
+    MT_KIND_HISTOGRAM,
+} mtInternalKind;
+
+/**
+ * @brief One registered metric.
+ *
+ * Gauges keep their value here. Counters and histograms keep theirs in the
+ * slots of each thread that updated them.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    char *name;
+    mtInternalKind kind;
+    atomic_int_least64_t gauge;
+} mtInternalMetric;
+
+/**
+ * @brief Buckets one thread recorded into one histogram.
+ *
+ * Only the owning thread writes, so updates are plain relaxed stores and
+ * readers merging on another thread see each field whole. The count is the
+ * sum of the buckets, so it never disagrees with them mid-update.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    atomic_uint_least64_t sum;
+    atomic_uint_least64_t min;
+    atomic_uint_least64_t max;
+    atomic_uint_least64_t buckets[METRICS_BUCKETS];
+} mtInternalHistogram;
+
+/**
+ * @brief Values one thread recorded during one session, indexed by metric.
+ *
+ * Padded by a cache line on both ends so no two threads' slots share one. The
+ * heap only guarantees `max_align_t`, so alignment alone would not do.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct mtInternalThreadSlots
+{
+    char headPad[CM_CACHE_LINE_SIZE];
+    atomic_uint_least64_t counters[METRICS_MAX];
+    _Atomic(mtInternalHistogram *) histograms[METRICS_MAX];
+    struct mtInternalThreadSlots *next;
+    char tailPad[CM_CACHE_LINE_SIZE];
+} mtInternalThreadSlots;
+
+/**
+ * @brief Central bookkeeping for Metrics.
+ *
+ * Lives outside the heap, like the Profiler's, since threads outside Smile's
+ * control read `session` on every update. Handles carry the session they were
+ * created in, so handles from an earlier session are rejected.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    atomic_uint session;
+    uint32_t lastSession;
+    cmMutex lock; // guards the registry and the slot list
+    mtInternalMetric metrics[METRICS_MAX];
+    atomic_uint metricCount;
+    mtInternalThreadSlots *slots;
+} mtInternalTracker;
+
+
+#endif
@@ -0,0 +1,35 @@
+/**
+ * @file
+ * @brief Message definitions for the Metrics module.
+ *
+ * @see Metrics.c
+ *
+ * @author Vitor Betmann
+ */
+
+
+#ifndef SMILE_METRICS_MESSAGES_H
+#define SMILE_METRICS_MESSAGES_H
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Module Name
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#define ORI "Metrics"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Causes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Infos
+#define CSE_METRIC_CREATED "Metric Created"
+#define CSE_SNAPSHOT_WRITTEN "Snapshot Written"
+// Warnings
+#define CSE_METRIC_KIND_MISMATCH "Metric Name Used By Another Kind"
+#define CSE_METRIC_LIMIT_REACHED "Metric Limit Reached"
+#define CSE_METRIC_NOT_FOUND "Metric Not Found"
+
+
+#endif
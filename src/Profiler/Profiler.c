@@ -0,0 +1,721 @@
+/**
+ * @file
+ * @brief Implementation of the Profiler module.
+ *
+ * @see Profiler.h
+ * @see ProfilerInternal.h
+ * @see ProfilerMessages.h
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#define _GNU_SOURCE // dladdr, pthread_getattr_np and the ucontext register names
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define PROFILER_HAS_SAMPLING
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#endif
+// Module Related
+#include "Profiler.h"
+#include "ProfilerInternal.h"
+#include "ProfilerMessages.h"
+// Support
+#include "internal/Common/Common.h"
+#include "internal/Common/CommonMessages.h"
+#include "internal/Common/CommonThreads.h"
+#include "internal/Test/Test.h"
+#include "LogInternal.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Variables
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static pfInternalTracker tracker;
+static thread_local pfInternalThreadBuffer *threadBuffer;
+static thread_local uint32_t threadSession;
+
+#ifdef PROFILER_HAS_SAMPLING
+static struct sigaction previousAction; // restored once sampling stops
+#endif
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Prototypes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/* Returns the calling thread's buffer for the running session, creating and
+ * registering it on first use. Returns nullptr while stopped or if allocation
+ * fails.
+ */
+static pfInternalThreadBuffer *pfPrivateGetBuffer(void);
+
+// Writes a zone name as a JSON string, escaping quotes, backslashes and controls.
+static void pfPrivateWriteJsonString(FILE *file, const char *str);
+
+// Disarms the sampling timer and restores the previous SIGPROF handler.
+static void pfPrivateStopTimer(void);
+
+#ifdef PROFILER_HAS_SAMPLING
+/* SIGPROF handler. Walks the frame pointers of the interrupted code into the
+ * next free sample, touching nothing but preallocated memory and atomics.
+ */
+static void pfPrivateTakeSample(int signal, siginfo_t *info, void *context);
+#endif
+
+// Orders samples by tag, then frame by frame from the outermost.
+static int pfPrivateCompareSamples(const void *a, const void *b);
+
+// Writes one sample as `tag;outermost;...;innermost`, without its count.
+static void pfPrivateWriteFoldedStack(FILE *file, const pfInternalSample *sample);
+
+// Writes a name with the `;` and line breaks the folded format reserves replaced.
+static void pfPrivateWriteFoldedName(FILE *file, const char *name);
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Public
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Start Related
+
+int pfStart(void)
+{
+    if (pfIsRunning())
+    {
+        lgInternalLog(WARN, ORI, CSE_ALREADY_RUNNING, __func__, CSQ_ABORT);
+        return RES_ALREADY_RUNNING;
+    }
+
+    cmInitMutex(&tracker.lock);
+    tracker.buffers = nullptr;
+    tracker.nextThreadId = 0;
+    tracker.startNs = cmGetTimeNs();
+    tracker.lastSession++;
+    CM_STORE_RELEASE(&tracker.session, tracker.lastSession);
+
+    lgInternalLog(INFO, ORI, CSE_MODULE_START, __func__, CSQ_SUCCESS);
+    return RES_OK;
+}
+
+bool pfIsRunning(void) { return CM_LOAD_RELAXED(&tracker.session) != 0; }
+
+// Export Related
+
+int pfExportTrace(const char *path)
+{
+    if (!cmIsRunning(pfIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!path)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "path", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+    if (!path[0])
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_EMPTY_ARG, "path", __func__, CSQ_ABORT);
+        return RES_EMPTY_ARG;
+    }
+
+    FILE *file = tsFopen(path, "w");
+    if (!file)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_CREATE_FILE_FAIL, path, __func__, CSQ_ABORT);
+        return RES_CREATE_FILE_FAIL;
+    }
+
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file);
+
+    uint32_t droppedCount = 0;
+    const char *separator = "\n";
+    cmLockMutex(&tracker.lock);
+    for (pfInternalThreadBuffer *buffer = tracker.buffers; buffer; buffer = buffer->next)
+    {
+        fprintf(file,
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu32
+                ",\"args\":{\"name\":\"Thread %" PRIu32 "\"}}",
+                separator, buffer->threadId, buffer->threadId);
+        separator = ",\n";
+
+        const uint32_t COUNT = CM_LOAD_ACQUIRE(&buffer->count);
+        for (uint32_t i = 0; i < COUNT; i++)
+        {
+            const pfInternalEvent *EVENT = &buffer->events[i];
+            const int64_t NS = EVENT->ns - tracker.startNs;
+
+            // Ends close the innermost open zone, so only begins carry a name.
+            fputs(",\n{", file);
+            if (EVENT->isBegin)
+            {
+                fputs("\"name\":", file);
+                pfPrivateWriteJsonString(file, EVENT->name);
+                fputc(',', file);
+            }
+            fprintf(file, "\"ph\":\"%c\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%" PRId64
+                          ".%03" PRId64 "}",
+                    EVENT->isBegin ? 'B' : 'E', buffer->threadId, NS / PROFILER_NS_PER_US,
+                    NS % PROFILER_NS_PER_US);
+        }
+        droppedCount += CM_LOAD_RELAXED(&buffer->droppedCount);
+    }
+    cmUnlockMutex(&tracker.lock);
+
+    fputs("\n]}\n", file);
+    const bool HAS_WRITE_ERROR = ferror(file);
+    if (fclose(file) != 0 || HAS_WRITE_ERROR)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_CREATE_FILE_FAIL, path, __func__, CSQ_ABORT);
+        return RES_CREATE_FILE_FAIL;
+    }
+
+    if (droppedCount > 0)
+    {
+        lgInternalLog(WARN, ORI, CSE_ZONES_DROPPED, __func__, CSQ_PAUSE);
+    }
+    lgInternalLogWithArg(INFO, ORI, CSE_TRACE_EXPORTED, path, __func__, CSQ_SUCCESS);
+    return RES_OK;
+}
+
+// Sampling Related
+
+int pfStartSampling(int frequencyHz, const char *path)
+{
+    if (!cmIsRunning(pfIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (frequencyHz <= 0 || frequencyHz > PROFILER_SAMPLING_HZ_MAX)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "frequencyHz", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+    if (path && !path[0])
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_EMPTY_ARG, "path", __func__, CSQ_ABORT);
+        return RES_EMPTY_ARG;
+    }
+
+    if (pfIsSampling())
+    {
+        lgInternalLog(WARN, ORI, CSE_ALREADY_SAMPLING, __func__, CSQ_ABORT);
+        return RES_ALREADY_RUNNING;
+    }
+
+#ifndef PROFILER_HAS_SAMPLING
+    lgInternalLog(WARN, ORI, CSE_SAMPLING_UNSUPPORTED, __func__, CSQ_ABORT);
+    return RES_SAMPLING_UNSUPPORTED;
+#else
+    pfInternalSampler *sampler = &tracker.sampler;
+    pthread_attr_t attr;
+    void *stackAddress;
+    size_t stackSize;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0)
+    {
+        lgInternalLog(WARN, ORI, CSE_SAMPLING_UNSUPPORTED, __func__, CSQ_ABORT);
+        return RES_SAMPLING_UNSUPPORTED;
+    }
+    const int STACK_RESULT = pthread_attr_getstack(&attr, &stackAddress, &stackSize);
+    pthread_attr_destroy(&attr);
+    if (STACK_RESULT != 0)
+    {
+        lgInternalLog(WARN, ORI, CSE_SAMPLING_UNSUPPORTED, __func__, CSQ_ABORT);
+        return RES_SAMPLING_UNSUPPORTED;
+    }
+
+    if (!sampler->samples)
+    {
+        sampler->samples = tsMalloc(PROFILER_SAMPLES_MAX * sizeof(pfInternalSample));
+        if (!sampler->samples)
+        {
+            lgInternalLog(ERROR, ORI, CSE_MEM_ALLOC_FAIL, __func__, CSQ_ABORT);
+            return RES_MEM_ALLOC_FAIL;
+        }
+    }
+
+    char *pathCopy = nullptr;
+    if (path)
+    {
+        const size_t PATH_SIZE = strlen(path) + 1;
+        pathCopy = tsMalloc(PATH_SIZE);
+        if (!pathCopy)
+        {
+            lgInternalLog(ERROR, ORI, CSE_MEM_ALLOC_FAIL, __func__, CSQ_ABORT);
+            return RES_MEM_ALLOC_FAIL;
+        }
+        memcpy(pathCopy, path, PATH_SIZE);
+    }
+    tsFree(sampler->path);
+    sampler->path = pathCopy;
+
+    sampler->stackLow = (uintptr_t)stackAddress;
+    sampler->stackHigh = (uintptr_t)stackAddress + stackSize;
+    CM_STORE_RELAXED(&sampler->count, 0);
+    CM_STORE_RELAXED(&sampler->droppedCount, 0);
+    CM_STORE_RELEASE(&sampler->isSampling, true);
+
+    struct sigaction action = {.sa_sigaction = pfPrivateTakeSample, .sa_flags = SA_SIGINFO | SA_RESTART};
+    sigemptyset(&action.sa_mask);
+    const bool IS_HANDLER_SET = sigaction(SIGPROF, &action, &previousAction) == 0;
+
+    const long INTERVAL_US = 1000000L / frequencyHz;
+    const struct timeval INTERVAL = {.tv_sec = INTERVAL_US / 1000000L, .tv_usec = INTERVAL_US % 1000000L};
+    if (!IS_HANDLER_SET ||
+        setitimer(ITIMER_PROF, &(struct itimerval){.it_interval = INTERVAL, .it_value = INTERVAL},
+                  nullptr) != 0)
+    {
+        if (IS_HANDLER_SET)
+        {
+            sigaction(SIGPROF, &previousAction, nullptr);
+        }
+        CM_STORE_RELEASE(&sampler->isSampling, false);
+        tsFree(sampler->samples);
+        sampler->samples = nullptr;
+        tsFree(sampler->path);
+        sampler->path = nullptr;
+        lgInternalLog(ERROR, ORI, CSE_SAMPLING_TIMER_FAIL, __func__, CSQ_ABORT);
+        return RES_SAMPLING_TIMER_FAIL;
+    }
+
+    lgInternalLog(INFO, ORI, CSE_SAMPLING_STARTED, __func__, CSQ_SUCCESS);
+    return RES_OK;
+#endif
+}
+
+bool pfIsSampling(void) { return CM_LOAD_RELAXED(&tracker.sampler.isSampling); }
+
+int pfWriteFoldedStacks(const char *path)
+{
+    if (!cmIsRunning(pfIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!path)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "path", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+    if (!path[0])
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_EMPTY_ARG, "path", __func__, CSQ_ABORT);
+        return RES_EMPTY_ARG;
+    }
+
+    // Sort a snapshot, so identical stacks end up next to each other.
+    pfInternalSampler *sampler = &tracker.sampler;
+    const uint32_t COUNT = CM_LOAD_ACQUIRE(&sampler->count);
+    const pfInternalSample **sorted = nullptr;
+    if (COUNT > 0)
+    {
+        sorted = tsMalloc(COUNT * sizeof(*sorted));
+        if (!sorted)
+        {
+            lgInternalLog(ERROR, ORI, CSE_MEM_ALLOC_FAIL, __func__, CSQ_ABORT);
+            return RES_MEM_ALLOC_FAIL;
+        }
+        for (uint32_t i = 0; i < COUNT; i++)
+        {
+            sorted[i] = &sampler->samples[i];
+        }
+        qsort(sorted, COUNT, sizeof(*sorted), pfPrivateCompareSamples);
+    }
+
+    FILE *file = tsFopen(path, "w");
+    if (!file)
+    {
+        tsFree(sorted);
+        lgInternalLogWithArg(ERROR, ORI, CSE_CREATE_FILE_FAIL, path, __func__, CSQ_ABORT);
+        return RES_CREATE_FILE_FAIL;
+    }
+
+    for (uint32_t i = 0; i < COUNT;)
+    {
+        uint32_t end = i + 1;
+        while (end < COUNT && pfPrivateCompareSamples(&sorted[i], &sorted[end]) == 0)
+        {
+            end++;
+        }
+        pfPrivateWriteFoldedStack(file, sorted[i]);
+        fprintf(file, " %" PRIu32 "\n", end - i);
+        i = end;
+    }
+    tsFree(sorted);
+
+    const bool HAS_WRITE_ERROR = ferror(file);
+    if (fclose(file) != 0 || HAS_WRITE_ERROR)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_CREATE_FILE_FAIL, path, __func__, CSQ_ABORT);
+        return RES_CREATE_FILE_FAIL;
+    }
+
+    if (CM_LOAD_RELAXED(&sampler->droppedCount) > 0)
+    {
+        lgInternalLog(WARN, ORI, CSE_SAMPLES_DROPPED, __func__, CSQ_PAUSE);
+    }
+    lgInternalLogWithArg(INFO, ORI, CSE_STACKS_WRITTEN, path, __func__, CSQ_SUCCESS);
+    return RES_OK;
+}
+
+int pfStopSampling(void)
+{
+    if (!cmIsRunning(pfIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!pfIsSampling())
+    {
+        lgInternalLog(WARN, ORI, CSE_NOT_SAMPLING, __func__, CSQ_ABORT);
+        return RES_NOT_RUNNING;
+    }
+
+    pfPrivateStopTimer();
+    lgInternalLog(INFO, ORI, CSE_SAMPLING_STOPPED, __func__, CSQ_SUCCESS);
+    return RES_OK;
+}
+
+// Stop Related
+
+int pfStop(void)
+{
+    if (!cmIsRunning(pfIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    pfInternalSampler *sampler = &tracker.sampler;
+    if (pfIsSampling())
+    {
+        pfPrivateStopTimer();
+    }
+    tsFree(sampler->samples);
+    sampler->samples = nullptr;
+    tsFree(sampler->path);
+    sampler->path = nullptr;
+    CM_STORE_RELAXED(&sampler->count, 0);
+
+    CM_STORE_RELAXED(&tracker.session, 0);
+
+    pfInternalThreadBuffer *buffer = tracker.buffers;
+    while (buffer)
+    {
+        pfInternalThreadBuffer *next = buffer->next;
+        tsFree(buffer);
+        buffer = next;
+    }
+    tracker.buffers = nullptr;
+    cmDestroyMutex(&tracker.lock);
+
+    if (tsReportAllocations("Profiler") > 0)
+    {
+        lgInternalLog(WARN, ORI, CSE_MEMORY_LEAKED, __func__, CSQ_SUCCESS);
+    }
+
+    lgInternalLog(INFO, ORI, CSE_MODULE_STOP, __func__, CSQ_SUCCESS);
+    return RES_OK;
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Internal
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void pfInternalBeginZone(const char *name)
+{
+    pfInternalThreadBuffer *buffer = pfPrivateGetBuffer();
+    if (!buffer)
+    {
+        return;
+    }
+
+    // Room for this begin, its end, and the ends of every zone around it.
+    const uint32_t COUNT = CM_LOAD_RELAXED(&buffer->count);
+    if (buffer->skippedDepth > 0 || COUNT + buffer->openCount + 2 > PROFILER_EVENTS_PER_THREAD)
+    {
+        buffer->skippedDepth++;
+        CM_STORE_RELAXED(&buffer->droppedCount, CM_LOAD_RELAXED(&buffer->droppedCount) + 1);
+        return;
+    }
+
+    buffer->events[COUNT] = (pfInternalEvent){.name = name, .ns = cmGetTimeNs(), .isBegin = true};
+    buffer->openCount++;
+    CM_STORE_RELEASE(&buffer->count, COUNT + 1);
+}
+
+void pfInternalEndZone(void)
+{
+    pfInternalThreadBuffer *buffer = pfPrivateGetBuffer();
+    if (!buffer)
+    {
+        return;
+    }
+
+    if (buffer->skippedDepth > 0)
+    {
+        buffer->skippedDepth--;
+        return;
+    }
+    if (buffer->openCount == 0)
+    {
+        return; // Opened before the session started.
+    }
+
+    const uint32_t COUNT = CM_LOAD_RELAXED(&buffer->count);
+    buffer->events[COUNT] = (pfInternalEvent){.name = nullptr, .ns = cmGetTimeNs(), .isBegin = false};
+    buffer->openCount--;
+    CM_STORE_RELEASE(&buffer->count, COUNT + 1);
+}
+
+void pfInternalSetSampleTag(const char *tag)
+{
+    pfInternalSampler *sampler = &tracker.sampler;
+    if (!tag)
+    {
+        CM_STORE_RELAXED(&sampler->currentTag, 0);
+        return;
+    }
+
+    const uint32_t COUNT = CM_LOAD_RELAXED(&sampler->tagCount);
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+        if (strncmp(sampler->tags[i], tag, PROFILER_TAG_SIZE - 1) == 0)
+        {
+            CM_STORE_RELAXED(&sampler->currentTag, i + 1);
+            return;
+        }
+    }
+
+    if (COUNT == PROFILER_TAGS_MAX)
+    {
+        CM_STORE_RELAXED(&sampler->currentTag, 0);
+        return;
+    }
+
+    snprintf(sampler->tags[COUNT], PROFILER_TAG_SIZE, "%s", tag);
+    CM_STORE_RELEASE(&sampler->tagCount, COUNT + 1);
+    CM_STORE_RELAXED(&sampler->currentTag, COUNT + 1);
+}
+
+void pfInternalWriteSampledStacks(void)
+{
+    if (pfIsRunning() && tracker.sampler.path)
+    {
+        pfWriteFoldedStacks(tracker.sampler.path);
+    }
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Private
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+pfInternalThreadBuffer *pfPrivateGetBuffer(void)
+{
+    const uint32_t SESSION = CM_LOAD_ACQUIRE(&tracker.session);
+    if (SESSION == 0)
+    {
+        return nullptr;
+    }
+    if (threadSession == SESSION)
+    {
+        return threadBuffer;
+    }
+
+    // Cached only once allocated, so a failed allocation is retried on the next zone.
+    pfInternalThreadBuffer *buffer = tsMalloc(sizeof(pfInternalThreadBuffer));
+    if (!buffer)
+    {
+        return nullptr;
+    }
+    threadSession = SESSION;
+    threadBuffer = buffer;
+
+    atomic_init(&buffer->count, 0);
+    buffer->openCount = 0;
+    buffer->skippedDepth = 0;
+    atomic_init(&buffer->droppedCount, 0);
+
+    cmLockMutex(&tracker.lock);
+    buffer->threadId = tracker.nextThreadId++;
+    buffer->next = tracker.buffers;
+    tracker.buffers = buffer;
+    cmUnlockMutex(&tracker.lock);
+
+    return buffer;
+}
+
+void pfPrivateWriteJsonString(FILE *file, const char *str)
+{
+    fputc('"', file);
+    for (const unsigned char *c = (const unsigned char *)str; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            fputc('\\', file);
+            fputc(*c, file);
+        }
+        else if (*c < 0x20)
+        {
+            fprintf(file, "\\u%04x", *c);
+        }
+        else
+        {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+void pfPrivateStopTimer(void)
+{
+#ifdef PROFILER_HAS_SAMPLING
+    setitimer(ITIMER_PROF, &(struct itimerval){0}, nullptr);
+    // Ignoring SIGPROF discards a tick still pending, which the default action would turn fatal.
+    struct sigaction ignore = {.sa_handler = SIG_IGN};
+    sigemptyset(&ignore.sa_mask);
+    sigaction(SIGPROF, &ignore, nullptr);
+    sigaction(SIGPROF, &previousAction, nullptr);
+#endif
+    CM_STORE_RELEASE(&tracker.sampler.isSampling, false);
+}
+
+#ifdef PROFILER_HAS_SAMPLING
+void pfPrivateTakeSample(int signal, siginfo_t *info, void *context)
+{
+    (void)signal;
+    (void)info;
+
+    const mcontext_t *MACHINE = &((const ucontext_t *)context)->uc_mcontext;
+#if defined(__x86_64__)
+    const uintptr_t PC = (uintptr_t)MACHINE->gregs[REG_RIP];
+    const uintptr_t SP = (uintptr_t)MACHINE->gregs[REG_RSP];
+    uintptr_t fp = (uintptr_t)MACHINE->gregs[REG_RBP];
+#else
+    const uintptr_t PC = (uintptr_t)MACHINE->pc;
+    const uintptr_t SP = (uintptr_t)MACHINE->sp;
+    uintptr_t fp = (uintptr_t)MACHINE->regs[29];
+#endif
+
+    // The interrupted stack tells the sampled thread apart from every other one.
+    pfInternalSampler *sampler = &tracker.sampler;
+    if (!CM_LOAD_ACQUIRE(&sampler->isSampling) || SP < sampler->stackLow || SP >= sampler->stackHigh)
+    {
+        return;
+    }
+
+    const uint32_t COUNT = CM_LOAD_RELAXED(&sampler->count);
+    if (COUNT == PROFILER_SAMPLES_MAX)
+    {
+        CM_STORE_RELAXED(&sampler->droppedCount, CM_LOAD_RELAXED(&sampler->droppedCount) + 1);
+        return;
+    }
+
+    pfInternalSample *sample = &sampler->samples[COUNT];
+    sample->tag = CM_LOAD_RELAXED(&sampler->currentTag);
+    sample->frames[0] = PC;
+    uint32_t depth = 1;
+
+    /* Each frame record holds the caller's frame pointer, then the return
+     * address. Records only move up the stack, so a pointer that leaves the
+     * stack, goes down, or is misaligned means the chain is broken, e.g. by
+     * code built without frame pointers, and the walk stops before reading it.
+     */
+    while (depth < PROFILER_SAMPLE_DEPTH && fp >= SP && fp % sizeof(uintptr_t) == 0 &&
+           fp <= sampler->stackHigh - 2 * sizeof(uintptr_t))
+    {
+        const uintptr_t *RECORD = (const uintptr_t *)fp;
+        if (RECORD[1] == 0)
+        {
+            break;
+        }
+        sample->frames[depth++] = RECORD[1];
+        if (RECORD[0] <= fp)
+        {
+            break;
+        }
+        fp = RECORD[0];
+    }
+
+    sample->depth = depth;
+    CM_STORE_RELEASE(&sampler->count, COUNT + 1);
+}
+#endif
+
+int pfPrivateCompareSamples(const void *a, const void *b)
+{
+    const pfInternalSample *A = *(const pfInternalSample *const *)a;
+    const pfInternalSample *B = *(const pfInternalSample *const *)b;
+
+    if (A->tag != B->tag)
+    {
+        return A->tag < B->tag ? -1 : 1;
+    }
+    for (uint32_t i = 1; i <= A->depth && i <= B->depth; i++)
+    {
+        const uintptr_t FRAME_A = A->frames[A->depth - i];
+        const uintptr_t FRAME_B = B->frames[B->depth - i];
+        if (FRAME_A != FRAME_B)
+        {
+            return FRAME_A < FRAME_B ? -1 : 1;
+        }
+    }
+    return (A->depth > B->depth) - (A->depth < B->depth);
+}
+
+void pfPrivateWriteFoldedStack(FILE *file, const pfInternalSample *sample)
+{
+    const uint32_t TAG_COUNT = CM_LOAD_ACQUIRE(&tracker.sampler.tagCount);
+    pfPrivateWriteFoldedName(file, sample->tag > 0 && sample->tag <= TAG_COUNT
+                                       ? tracker.sampler.tags[sample->tag - 1]
+                                       : "(untagged)");
+
+    for (uint32_t i = sample->depth; i-- > 0;)
+    {
+        // Return addresses point past their call, which may already be the next function.
+        const uintptr_t ADDRESS = i == 0 ? sample->frames[i] : sample->frames[i] - 1;
+        fputc(';', file);
+
+#ifdef PROFILER_HAS_SAMPLING
+        Dl_info symbol;
+        const bool IS_MAPPED = dladdr((const void *)ADDRESS, &symbol) != 0;
+        if (IS_MAPPED && symbol.dli_sname)
+        {
+            pfPrivateWriteFoldedName(file, symbol.dli_sname);
+            continue;
+        }
+        if (IS_MAPPED && symbol.dli_fname)
+        {
+            const char *slash = strrchr(symbol.dli_fname, '/');
+            pfPrivateWriteFoldedName(file, slash ? slash + 1 : symbol.dli_fname);
+            fprintf(file, "+0x%" PRIxPTR, ADDRESS - (uintptr_t)symbol.dli_fbase);
+            continue;
+        }
+#endif
+        fprintf(file, "0x%" PRIxPTR, ADDRESS);
+    }
+}
+
+void pfPrivateWriteFoldedName(FILE *file, const char *name)
+{
+    for (const char *c = name; *c; c++)
+    {
+        fputc(*c == ';' ? ':' : *c == '\n' || *c == '\r' ? ' ' : *c, file);
+    }
+}
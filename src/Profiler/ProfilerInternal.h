@@ -0,0 +1,185 @@
+/**
+ * @file
+ * @brief Declarations of internal data types for the Profiler module.
+ *
+ * @see Profiler.c
+ *
+ * @author Vitor Betmann
+ */
+
+#ifndef SMILE_PROFILER_INTERNAL_H
+#define SMILE_PROFILER_INTERNAL_H
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <stdint.h>
+// Support
+#include "internal/Common/CommonThreads.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#define PROFILER_EVENTS_PER_THREAD 65536
+#define PROFILER_NS_PER_US 1000
+
+#define PROFILER_SAMPLES_MAX 16384
+#define PROFILER_SAMPLE_DEPTH 32
+#define PROFILER_SAMPLING_HZ_MAX 10000
+#define PROFILER_TAGS_MAX 64
+#define PROFILER_TAG_SIZE 64
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Profiler-specific result codes.
+ *
+ * @note Profiler-specific failures cover the following range: `-100..-199`.
+ *
+ * @see  src/internal/Common/Common.h for common result codes
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    RES_SAMPLING_UNSUPPORTED = -100,
+    RES_SAMPLING_TIMER_FAIL = -101,
+} pfInternalResult;
+
+/**
+ * @brief One zone boundary, exported as a Chrome `B` or `E` event.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    const char *name;
+    int64_t ns;
+    bool isBegin;
+} pfInternalEvent;
+
+/**
+ * @brief Events recorded by one thread during one session.
+ *
+ * Only the owning thread writes to a buffer. It publishes each event by storing
+ * `count` with release ordering, so the exporter can read every event below the
+ * count it loads without locking the writer out.
+ *
+ * A zone is only recorded if the buffer still has room for its end and the ends
+ * of every zone open around it, so the exported trace stays balanced. Once one
+ * zone is dropped, every later one is too.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct pfInternalThreadBuffer
+{
+    struct pfInternalThreadBuffer *next;
+    uint32_t threadId;
+    atomic_uint count;
+    uint32_t openCount;    // recorded zones not closed yet
+    uint32_t skippedDepth; // dropped zones not closed yet
+    atomic_uint droppedCount;
+    pfInternalEvent events[PROFILER_EVENTS_PER_THREAD];
+} pfInternalThreadBuffer;
+
+/**
+ * @brief One call stack captured by the sampling signal handler.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    uint32_t tag;   // index + 1 into the tag table, or 0 if untagged
+    uint32_t depth; // frames captured
+    uintptr_t frames[PROFILER_SAMPLE_DEPTH]; // innermost first
+} pfInternalSample;
+
+/**
+ * @brief State shared with the sampling signal handler.
+ *
+ * The handler may only touch what is here, and only through lock-free atomics,
+ * so everything it writes to is allocated before the timer is armed. Samples
+ * are published like zone events: the handler fills one and then stores
+ * `count` with release ordering.
+ *
+ * Only the thread that started sampling is unwound. The handler recognizes it
+ * by checking that the interrupted stack pointer lies within
+ * `[stackLow, stackHigh)`, which also bounds every frame pointer it follows.
+ *
+ * Tags outlive sessions, so the scene current before sampling starts is still
+ * known. Only the tagging thread appends to the table.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    atomic_bool isSampling;
+    pfInternalSample *samples;
+    atomic_uint count;
+    atomic_uint droppedCount;
+    uintptr_t stackLow;
+    uintptr_t stackHigh;
+    char *path; // written by pfInternalWriteSampledStacks, or nullptr
+    atomic_uint currentTag;
+    atomic_uint tagCount;
+    char tags[PROFILER_TAGS_MAX][PROFILER_TAG_SIZE];
+} pfInternalSampler;
+
+/**
+ * @brief Central bookkeeping for the Profiler.
+ *
+ * Lives outside the heap, since threads outside Smile's control read `session`
+ * on every zone. A session is `0` while stopped, so threads keep a buffer only
+ * while their cached session number matches.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    atomic_uint session;
+    uint32_t lastSession;
+    int64_t startNs;
+    cmMutex lock; // guards the buffer list and thread ids
+    pfInternalThreadBuffer *buffers;
+    uint32_t nextThreadId;
+    pfInternalSampler sampler;
+} pfInternalTracker;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Prototypes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Sets the tag later samples are filed under, e.g. the current scene.
+ *
+ * @param tag Tag to copy, truncated to `PROFILER_TAG_SIZE - 1` characters, or
+ *            nullptr to stop tagging. Samples go untagged once
+ *            `PROFILER_TAGS_MAX` distinct tags are in use.
+ *
+ * @note Works whether or not the Profiler is running. Call it from one thread
+ *       only.
+ *
+ * @author Vitor Betmann
+ */
+void pfInternalSetSampleTag(const char *tag);
+
+/**
+ * @brief Writes the folded stacks sampled so far to the path given to
+ *        `pfStartSampling()`, if any.
+ *
+ * @note Called by SceneManager as it stops.
+ *
+ * @author Vitor Betmann
+ */
+void pfInternalWriteSampledStacks(void);
+
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @file
+ * @brief Message definitions for the Profiler module.
+ *
+ * @see Profiler.c
+ *
+ * @author Vitor Betmann
+ */
+
+
+#ifndef SMILE_PROFILER_MESSAGES_H
+#define SMILE_PROFILER_MESSAGES_H
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Module Name
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#define ORI "Profiler"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Causes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Infos
+#define CSE_TRACE_EXPORTED "Trace Exported"
+#define CSE_SAMPLING_STARTED "Sampling Started"
+#define CSE_SAMPLING_STOPPED "Sampling Stopped"
+#define CSE_STACKS_WRITTEN "Folded Stacks Written"
+// Warnings
+#define CSE_ZONES_DROPPED "Zones Dropped After Thread Buffer Filled"
+#define CSE_SAMPLES_DROPPED "Samples Dropped After Sample Buffer Filled"
+#define CSE_ALREADY_SAMPLING "Sampling Already Running"
+#define CSE_NOT_SAMPLING "Sampling Not Running"
+#define CSE_SAMPLING_UNSUPPORTED "Sampling Unsupported On This Platform"
+#define CSE_SAMPLING_TIMER_FAIL "Failed To Set Up Sampling Timer"
+
+
+#endif
@@ -6,8 +6,6 @@
  * @see SceneManagerInternal.h
  * @see SceneManagerMessages.h
  *
- * @note TODO #16 [Feature] for [SceneManager] - Create a function to limit the
- *       game's FPS to a max value
  * @note TODO #27 [Feature] for [SceneManager] - Create Internal Trim Function
  *       and Integrate into SceneManager Name Validation
  *
@@ -22,6 +20,15 @@
 #include <string.h>
 #include <time.h>
 #include <uthash.h>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SM_HAS_TSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
 // Module Related
 #include "SceneManager.h"
 #include "SceneManagerInternal.h"
@@ -29,15 +36,29 @@
 #include "SceneManagerTestHooks.h"
 // Support
 #include "internal/Common/Common.h"
+#include "internal/Common/CommonJobs.h"
 #include "internal/Common/CommonMessages.h"
+#include "internal/Common/CommonPerf.h"
+#include "internal/Common/CommonThreads.h"
 #include "internal/Test/Test.h"
 #include "LogInternal.h"
+#include "Profiler.h"
+#include "ProfilerInternal.h"
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Variables
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 
 static smInternalTracker *tracker;
+static smInternalMessageQueue messageQueue;
+
+#ifdef SMILE_UNCHECKED
+static void smPrivateUpdateFallback(float dt);
+static void smPrivateDrawFallback(void);
+
+_Atomic(smUpdateFn) smInternalCachedUpdate = smPrivateUpdateFallback;
+smDrawFn smInternalCachedDraw = smPrivateDrawFallback;
+#endif
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Prototypes
@@ -50,6 +71,141 @@ static int smPrivateIsValidName(const char *name, const char *caller);
  */
 static void smPrivateAddScene(smInternalSceneMap *mapEntry);
 
+// Removes a scene from the map, freeing it unless it lives in a scene block.
+static void smPrivateRemoveScene(smInternalSceneMap *mapEntry);
+
+static void smPrivateEnterScene(smInternalScene *scene, void *args);
+
+static void smPrivateExitScene(smInternalScene *scene);
+
+/* Leaves the outgoing scene through its suspend callback when it fits the
+ * suspend budget, otherwise through its exit callback.
+ */
+static void smPrivateLeaveScene(smInternalScene *scene);
+
+static void smPrivateUnlinkSuspended(smInternalScene *scene);
+
+// Exits least recently suspended scenes until the cache fits the budget.
+static void smPrivateEvictOverBudget(void);
+
+/* Exits the scene waiting on its loader, since a loader may have acquired
+ * resources before the load was abandoned.
+ */
+static void smPrivateAbandonLoad(void);
+
+/* Calls the pending loader until it finishes or the load budget runs out, then
+ * activates the loaded scene.
+ */
+static void smPrivateStepLoad(void);
+
+/* Points the SMILE_UNCHECKED fast path at the active scene's callbacks, or back
+ * at the checked functions when they can't be called directly. Must run
+ * whenever anything it checks changes, e.g. the current or pending scene.
+ */
+static void smPrivateRefreshCachedCallbacks(void);
+
+// Creates the metrics SceneManager publishes, if Metrics is running.
+static void smPrivateCreateMetrics(void);
+
+/* Adds the counters elapsed since `before` to one of the scene's totals, unless
+ * SceneManager stopped, counters were turned off, or the scene was switched
+ * away from during the callback.
+ */
+static void smPrivateAddPerfSample(const smInternalScene *scene, bool isDraw,
+                                   const uint64_t *before);
+
+// Empties the message queue and resets its slots for a new run, then opens it.
+static void smPrivateOpenMessageQueue(void);
+
+/* Reserves the next free slot for a producer, or returns nullptr when the
+ * queue is full.
+ */
+static smInternalMessageCell *smPrivateClaimMessageCell(size_t *pos);
+
+/* Passes queued messages to the active scene's handler, stopping after one lap
+ * of the ring so handlers that post can't keep smUpdate() from returning.
+ */
+static void smPrivateDrainMessages(void);
+
+#ifdef SMILE_UNCHECKED
+// Whether a message is waiting at the head of the queue. Main thread only.
+static bool smPrivateHasMessages(void);
+#endif
+
+// Converts seconds to wheel ticks, rounding to the nearest tick but at least one.
+static uint32_t smPrivateToTicks(float seconds);
+
+// Doubles the timer pool and threads the new entries onto the free list.
+static int smPrivateGrowTimers(void);
+
+// Links a pending timer into the wheel slot matching how far away it expires.
+static void smPrivateScheduleTimer(uint32_t index);
+
+static void smPrivateUnscheduleTimer(uint32_t index);
+
+// Unlinks a timer from the wheel and its owner and returns it to the free list.
+static void smPrivateReleaseTimer(uint32_t index);
+
+/* Moves every timer in the current slot of a wheel level down to the level
+ * matching the time left until it expires.
+ */
+static void smPrivateCascadeTimers(int level);
+
+/* Advances the wheel tick by tick, firing timers as they come due. Stops early
+ * if a callback stops SceneManager.
+ */
+static void smPrivateAdvanceTimers(float dt);
+
+// Doubles a tween group's capacity, moving its arrays into one new block.
+static int smPrivateGrowTweenGroup(smInternalTweenGroup *group);
+
+// Doubles the tween slot table and threads the new slots onto the free list.
+static int smPrivateGrowTweenSlots(void);
+
+/* Removes a group entry by moving the group's last entry into its place, then
+ * frees the entry's handle slot.
+ */
+static void smPrivateRemoveTween(smInternalTweenGroup *group, size_t position);
+
+/* Advances, eases and writes the tweens of a group in [begin, end). Batches of
+ * one group touch disjoint entries, so they may run on different workers.
+ */
+static void smPrivateStepTweenBatch(void *args, size_t begin, size_t end);
+
+/* Steps a group, across the Common job pool when it is running and the group
+ * is large enough to pay for it, then retires finished tweens.
+ */
+static void smPrivateStepTweens(smInternalTweenGroup *group, smEasing easing, float dt);
+
+static void smPrivateAdvanceTweens(float dt);
+
+// Clamps, smooths, then snaps a raw delta time as configured by smSetDtFilter().
+static float smPrivateFilterDt(float dt);
+
+/* Calls queued idle tasks until the queue is empty or the deadline is
+ * reached, re-queueing the ones that are not done.
+ */
+static void smPrivateRunIdleTasks(int64_t deadlineNs);
+
+static void smPrivateSleepUntil(int64_t deadlineNs);
+
+/* Folds a frame's cost into the running average and moves the quality level
+ * one step once the average stays past a threshold for long enough.
+ */
+static void smPrivateGovernQuality(int64_t frameCostNs);
+
+// Maps a source to its POSIX clock, returning false if the platform has none.
+static bool smPrivateGetClockId(smClockSource source, clockid_t *clockId);
+
+static bool smPrivateIsClockSupported(smClockSource source);
+
+/* Measures the TSC frequency against CLOCK_MONOTONIC and anchors TSC readings
+ * to it, so switching to the TSC keeps the same timeline.
+ */
+static int smPrivateCalibrateTsc(void);
+
+static int64_t smPrivateToNs(struct timespec time);
+
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Functions - Public
 // —————————————————————————————————————————————————————————————————————————————————————————————————
@@ -71,9 +227,11 @@ int smStart(void)
         return RES_MEM_ALLOC_FAIL;
     }
 
-    tracker->fps = DEFAULT_FPS; /* Stored target FPS used by smGetDt() first-call fallback.
-                                 * Runtime FPS capping is not implemented.
-                                 */
+    tracker->fps = DEFAULT_FPS; // Paces smWaitForNextFrame() and seeds smGetDt()'s first call.
+    tracker->loadBudgetMs = DEFAULT_LOAD_BUDGET_MS;
+    tracker->qualityLevel = SM_QUALITY_FULL;
+    smPrivateOpenMessageQueue();
+    smPrivateCreateMetrics();
 
     lgInternalLog(INFO, ORI, CSE_MODULE_START, __func__,CSQ_SUCCESS);
     return RES_OK;
@@ -97,8 +255,7 @@ int smCreateScene(const char *name, smEnterFn enter, smUpdateFn update,
         return nameValidationResult;
     }
 
-    smInternalSceneMap *entry = smInternalGetEntry(name);
-    if (entry)
+    if (smInternalGetScene(name))
     {
         lgInternalLogWithArg(WARN, ORI, CSE_SCENE_ALREADY_EXISTS, name, __func__, CSQ_ABORT);
         return RES_SCENE_ALREADY_EXISTS;
@@ -126,11 +283,13 @@ int smCreateScene(const char *name, smEnterFn enter, smUpdateFn update,
     }
     memcpy(nameCopy, name, NAME_SIZE);
 
-    scene->name = nameCopy;
-    scene->enter = enter;
-    scene->update = update;
-    scene->draw = draw;
-    scene->exit = exit;
+    *scene = (smInternalScene){
+        .name = nameCopy,
+        .enter = enter,
+        .update = update,
+        .draw = draw,
+        .exit = exit,
+    };
 
     smInternalSceneMap *mapEntry = tsMalloc(sizeof(smInternalSceneMap));
     if (!mapEntry)
@@ -148,101 +307,188 @@ int smCreateScene(const char *name, smEnterFn enter, smUpdateFn update,
     return RES_OK;
 
 mapEntryError:
-    free(nameCopy);
+    tsFree(nameCopy);
 nameCopyError:
-    free(scene);
+    tsFree(scene);
     return RES_MEM_ALLOC_FAIL;
 }
 
-bool smSceneExists(const char *name)
+int smRegisterScenes(const smSceneDesc *descs, size_t count)
 {
     if (!cmIsRunning(smIsRunning, ORI, __func__))
     {
-        return false;
+        return RES_NOT_RUNNING;
     }
 
-    int nameValidationResult = smPrivateIsValidName(name, __func__);
-    if (nameValidationResult != RES_OK)
+    if (!descs)
     {
-        return false;
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "descs", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+    if (count == 0)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "count", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const smSceneDesc *desc = &descs[i];
+
+        int nameValidationResult = smPrivateIsValidName(desc->name, __func__);
+        if (nameValidationResult != RES_OK)
+        {
+            return nameValidationResult;
+        }
+
+        if (!desc->enter && !desc->update && !desc->draw && !desc->exit)
+        {
+            lgInternalLogWithArg(ERROR, ORI, CSE_NO_VALID_FUNCTIONS, desc->name, __func__,
+                                 CSQ_ABORT);
+            return RES_NO_VALID_FUNCS;
+        }
+    }
+
+    smInternalSceneBlock *block = tsMalloc(sizeof(smInternalSceneBlock) +
+                                           count * sizeof(block->slots[0]));
+    if (!block)
+    {
+        lgInternalLog(ERROR, ORI, CSE_MEM_ALLOC_FAIL, __func__, CSQ_ABORT);
+        return RES_MEM_ALLOC_FAIL;
+    }
+    block->count = count;
+
+    /* Existing and repeated names are caught while inserting, since the map
+     * already holds every name seen so far. On failure, the names inserted by
+     * this call are rolled back.
+     */
+    for (size_t i = 0; i < count; i++)
+    {
+        const smSceneDesc *desc = &descs[i];
+
+        const smInternalSceneMap *existing = smInternalGetEntry(desc->name);
+        if (existing || smInternalFindInRegistry(desc->name))
+        {
+            bool isRepeated = false;
+            for (size_t j = 0; j < i && !isRepeated; j++)
+            {
+                isRepeated = existing == &block->slots[j].entry;
+            }
+            lgInternalLogWithArg(WARN, ORI, isRepeated ? CSE_SCENE_REPEATED : CSE_SCENE_ALREADY_EXISTS,
+                                 desc->name, __func__, CSQ_ABORT);
+            while (i-- > 0)
+            {
+                HASH_DEL(tracker->sceneMap, &block->slots[i].entry);
+            }
+            tsFree(block);
+            return RES_SCENE_ALREADY_EXISTS;
+        }
+
+        smInternalScene *scene = &block->slots[i].scene;
+        *scene = (smInternalScene){
+            .name = desc->name,
+            .enter = desc->enter,
+            .update = desc->update,
+            .draw = desc->draw,
+            .exit = desc->exit,
+            .isStatic = true,
+        };
+
+        smInternalSceneMap *mapEntry = &block->slots[i].entry;
+        mapEntry->scene = scene;
+        mapEntry->name = scene->name;
+        smPrivateAddScene(mapEntry);
     }
 
-    return smInternalGetEntry(name);
+    block->next = tracker->sceneBlocks;
+    tracker->sceneBlocks = block;
+    tracker->sceneCount += (int)count;
+
+    lgInternalLog(INFO, ORI, CSE_SCENES_REGISTERED, __func__, CSQ_SUCCESS);
+    return RES_OK;
 }
 
-int smSetScene(const char *name, void *args)
+int smSetRegistry(const smSceneRegistry *registry)
 {
     if (!cmIsRunning(smIsRunning, ORI, __func__))
     {
         return RES_NOT_RUNNING;
     }
 
-    int nameValidationResult = smPrivateIsValidName(name, __func__);
-    if (nameValidationResult != RES_OK)
+    if (!registry || !registry->scenes || !registry->seeds)
     {
-        return nameValidationResult;
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "registry", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
     }
 
-    const smInternalScene *NEXT_SCENE = smInternalGetScene(name);
-    if (!NEXT_SCENE)
+    if (registry->sceneCount == 0 || registry->seedCount == 0)
     {
-        lgInternalLogWithArg(WARN, ORI, CSE_SCENE_NOT_FOUND, name, __func__,CSQ_ABORT);
-        return RES_SCENE_NOT_FOUND;
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "registry", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
     }
 
-    if (tracker->currScene && tracker->currScene->exit)
+    if (tracker->registry)
     {
-#ifdef SMILE_DEV
-        if (smTestExit)
+        lgInternalLog(ERROR, ORI, CSE_REGISTRY_ALREADY_SET, __func__, CSQ_ABORT);
+        return RES_REGISTRY_ALREADY_SET;
+    }
+
+    // Registries are usually set before any other scene, leaving nothing to check.
+    for (size_t i = 0; tracker->sceneMap && i < registry->sceneCount; i++)
+    {
+        if (smInternalGetEntry(registry->scenes[i].name))
         {
-            smTestExit(smMockData);
+            lgInternalLogWithArg(WARN, ORI, CSE_SCENE_ALREADY_EXISTS, registry->scenes[i].name,
+                                 __func__, CSQ_ABORT);
+            return RES_SCENE_ALREADY_EXISTS;
         }
-#endif
-        tracker->currScene->exit();
     }
 
-    tracker->currScene = NEXT_SCENE;
+    // The table is const, so per-scene runtime state lives next to it.
+    tracker->registryScenes = tsCalloc(registry->sceneCount, sizeof(smInternalScene));
+    if (!tracker->registryScenes)
+    {
+        lgInternalLog(ERROR, ORI, CSE_MEM_ALLOC_FAIL, __func__, CSQ_ABORT);
+        return RES_MEM_ALLOC_FAIL;
+    }
 
-    if (tracker->currScene && tracker->currScene->enter)
+    for (size_t i = 0; i < registry->sceneCount; i++)
     {
-#ifdef SMILE_DEV
-        if (args && smTestEnterWithArgs)
-        {
-            smTestEnterWithArgs(smMockData, args);
-        }
-        else if (smTestEnter)
-        {
-            smTestEnter(smMockData);
-        }
-#endif
-        tracker->currScene->enter(args);
+        const smSceneDesc *desc = &registry->scenes[i];
+        tracker->registryScenes[i] = (smInternalScene){
+            .name = desc->name,
+            .enter = desc->enter,
+            .update = desc->update,
+            .draw = desc->draw,
+            .exit = desc->exit,
+            .isStatic = true,
+        };
     }
 
-    lgInternalLogWithArg(INFO, ORI, CSE_SCENE_SET_TO, name, __func__,CSQ_SUCCESS);
+    tracker->registry = registry;
+    tracker->sceneCount += (int)registry->sceneCount;
+
+    lgInternalLog(INFO, ORI, CSE_REGISTRY_SET, __func__, CSQ_SUCCESS);
     return RES_OK;
 }
 
-const char *smGetCurrentSceneName(void)
+bool smSceneExists(const char *name)
 {
     if (!cmIsRunning(smIsRunning, ORI, __func__))
     {
-        return nullptr;
+        return false;
     }
 
-    return tracker->currScene ? tracker->currScene->name : nullptr;
-}
-
-int smGetSceneCount(void)
-{
-    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    int nameValidationResult = smPrivateIsValidName(name, __func__);
+    if (nameValidationResult != RES_OK)
     {
-        return RES_NOT_RUNNING;
+        return false;
     }
 
-    return tracker->sceneCount;
+    return smInternalGetScene(name);
 }
 
-int smDeleteScene(const char *name)
+int smSetScene(const char *name, void *args)
 {
     if (!cmIsRunning(smIsRunning, ORI, __func__))
     {
@@ -255,213 +501,2348 @@ int smDeleteScene(const char *name)
         return nameValidationResult;
     }
 
-    if (tracker->currScene && strcmp(name, tracker->currScene->name) == 0)
-    {
-        lgInternalLogWithArg(ERROR, ORI, CSE_CANT_DEL_CURR_SCENE, name, __func__, CSQ_ABORT);
-        return RES_CANT_DEL_CURR_SCENE;
-    }
-
-    smInternalSceneMap *entry = smInternalGetEntry(name);
-    if (!entry)
+    smInternalScene *nextScene = smInternalGetScene(name);
+    if (!nextScene)
     {
         lgInternalLogWithArg(WARN, ORI, CSE_SCENE_NOT_FOUND, name, __func__,CSQ_ABORT);
         return RES_SCENE_NOT_FOUND;
     }
 
-    HASH_DEL(tracker->sceneMap, entry);
-    free(entry->scene->name);
-    free(entry->scene);
-    free(entry);
+    if (tracker->pendingScene == nextScene)
+    {
+        tracker->pendingArgs = args;
+        return RES_OK;
+    }
 
-    tracker->sceneCount--;
+    if (tracker->pendingScene)
+    {
+        smPrivateAbandonLoad();
+    }
 
-    lgInternalLogWithArg(INFO, ORI, CSE_SCENE_DELETED, name, __func__,CSQ_SUCCESS);
-    return RES_OK;
-}
+    // Detach first so suspending the outgoing scene can never evict the target.
+    bool isResuming = nextScene->isSuspended;
+    if (isResuming)
+    {
+        smPrivateUnlinkSuspended(nextScene);
+    }
 
-// Lifecycle Functions
+    /* With a loader, the outgoing scene keeps running until loading completes
+     * unless a loading scene takes its place in the meantime.
+     */
+    bool isLoading = !isResuming && nextScene->load;
+    smInternalScene *standIn = isLoading ? tracker->loadingScene : nullptr;
+    if (isLoading && tracker->currScene != nextScene &&
+        (!standIn || tracker->currScene == standIn))
+    {
+        tracker->pendingScene = nextScene;
+        tracker->pendingArgs = args;
+        smPrivateRefreshCachedCallbacks();
+        lgInternalLogWithArg(INFO, ORI, CSE_SCENE_LOADING, name, __func__, CSQ_SUCCESS);
+        return RES_OK;
+    }
 
-int smUpdate(float dt)
-{
-    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    if (tracker->currScene)
     {
-        return RES_NOT_RUNNING;
+        if (tracker->currScene == nextScene)
+        {
+            smPrivateExitScene(tracker->currScene);
+        }
+        else
+        {
+            smPrivateLeaveScene(tracker->currScene);
+        }
     }
 
-    if (!tracker->currScene)
+    if (isLoading)
     {
-        lgInternalLog(ERROR, ORI, CSE_NULL_CURR_SCENE, __func__,CSQ_ABORT);
-        return RES_NO_CURR_SCENE;
+        tracker->currScene = standIn;
+        pfInternalSetSampleTag(standIn ? standIn->name : nullptr);
+        if (standIn && standIn->isSuspended)
+        {
+            smPrivateUnlinkSuspended(standIn);
+            if (standIn->resume)
+            {
+                standIn->resume(nullptr);
+            }
+        }
+        else if (standIn)
+        {
+            smPrivateEnterScene(standIn, nullptr);
+            if (!tracker)
+            {
+                return RES_OK; // The loading scene's enter stopped SceneManager.
+            }
+        }
+        tracker->pendingScene = nextScene;
+        tracker->pendingArgs = args;
+        smPrivateRefreshCachedCallbacks();
+        lgInternalLogWithArg(INFO, ORI, CSE_SCENE_LOADING, name, __func__, CSQ_SUCCESS);
+        return RES_OK;
     }
 
-    if (!tracker->currScene->update)
+    tracker->currScene = nextScene;
+    pfInternalSetSampleTag(nextScene->name);
+    smPrivateRefreshCachedCallbacks();
+    mtAddCounter(tracker->metrics.sceneSwitches, 1);
+
+    if (isResuming)
     {
-        lgInternalLogWithArg(WARN, ORI, CSE_NULL_SCENE_UPDATE_FN, tracker->currScene->name, __func__,
-                             CSQ_ABORT);
-        return RES_NO_UPDATE_FUNC;
+        if (nextScene->resume)
+        {
+            PF_BEGIN_ZONE("Scene Resume");
+            nextScene->resume(args);
+            PF_END_ZONE();
+        }
+    }
+    else
+    {
+        smPrivateEnterScene(nextScene, args);
     }
 
-    tracker->currScene->update(dt);
+    lgInternalLogWithArg(INFO, ORI, CSE_SCENE_SET_TO, name, __func__,CSQ_SUCCESS);
     return RES_OK;
 }
 
-float smGetDt(void)
+int smSetSceneSuspend(const char *name, smSuspendFn suspend, smResumeFn resume,
+                      size_t memoryCost)
 {
     if (!cmIsRunning(smIsRunning, ORI, __func__))
     {
         return RES_NOT_RUNNING;
     }
 
-    float dt;
-    struct timespec currentTime;
-
-#ifdef SMILE_DEV
-    if (smMockClockGettimeFails)
+    int nameValidationResult = smPrivateIsValidName(name, __func__);
+    if (nameValidationResult != RES_OK)
     {
-        lgInternalLog(ERROR, ORI, CSE_CLOCK_GETTIME_FAILED, __func__, CSQ_ABORT);
-        return RES_CLOCK_GETTIME_FAIL;
+        return nameValidationResult;
     }
-    currentTime = smMockCurrTime;
-#else
-    if (clock_gettime(CLOCK_MONOTONIC, &currentTime) != 0)
+
+    smInternalScene *scene = smInternalGetScene(name);
+    if (!scene)
     {
-        lgInternalLog(ERROR, ORI, CSE_CLOCK_GETTIME_FAILED, __func__,CSQ_ABORT);
-        return RES_CLOCK_GETTIME_FAIL;
+        lgInternalLogWithArg(WARN, ORI, CSE_SCENE_NOT_FOUND, name, __func__, CSQ_ABORT);
+        return RES_SCENE_NOT_FOUND;
     }
-#endif
 
-    /* On the first call, lastTime is zero-initialized, so we default to a delta
-     * time based on the target FPS. This prevents an abnormally large dt, since
-     * we don't know how long after program start clock_gettime() is invoked.
-     */
-    if (tracker->lastTime.tv_sec == 0 && tracker->lastTime.tv_nsec == 0)
+    if (scene->isSuspended)
     {
-        dt = (float)(1.0 / tracker->fps);
+        tracker->suspendedCost -= scene->suspendCost;
+        tracker->suspendedCost += memoryCost;
     }
-    else
+
+    scene->suspend = suspend;
+    scene->resume = resume;
+    scene->suspendCost = memoryCost;
+
+    if (scene->isSuspended && !suspend)
     {
-        double tempDt = currentTime.tv_sec - tracker->lastTime.tv_sec
-                        + (currentTime.tv_nsec - tracker->lastTime.tv_nsec) / 1e9;
-        dt = (float)tempDt;
+        smPrivateUnlinkSuspended(scene);
+        smPrivateExitScene(scene);
+        lgInternalLogWithArg(INFO, ORI, CSE_SCENE_EVICTED, name, __func__, CSQ_SUCCESS);
     }
+    smPrivateEvictOverBudget();
 
-    tracker->lastTime = currentTime;
-
-    return dt;
+    return RES_OK;
 }
 
-int smDraw(void)
+int smSetSuspendBudget(size_t budget)
 {
     if (!cmIsRunning(smIsRunning, ORI, __func__))
     {
         return RES_NOT_RUNNING;
     }
 
-    if (!tracker->currScene)
+    tracker->suspendBudget = budget;
+    smPrivateEvictOverBudget();
+
+    return RES_OK;
+}
+
+bool smIsSceneSuspended(const char *name)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
     {
-        lgInternalLog(ERROR, ORI, CSE_NULL_CURR_SCENE, __func__,CSQ_ABORT);
-        return RES_NO_CURR_SCENE;
+        return false;
     }
 
-    if (!tracker->currScene->draw)
+    int nameValidationResult = smPrivateIsValidName(name, __func__);
+    if (nameValidationResult != RES_OK)
     {
-        lgInternalLogWithArg(WARN, ORI, CSE_NULL_SCENE_DRAW_FN, tracker->currScene->name, __func__, CSQ_ABORT);
-        return RES_NO_DRAW_FUNC;
+        return false;
     }
 
-    tracker->currScene->draw();
-    return RES_OK;
+    const smInternalScene *scene = smInternalGetScene(name);
+    return scene && scene->isSuspended;
 }
 
-// Stop Related
-
-int smStop(void)
+int smSetSceneLoader(const char *name, smLoadFn load)
 {
     if (!cmIsRunning(smIsRunning, ORI, __func__))
     {
         return RES_NOT_RUNNING;
     }
 
-    if (tracker->currScene && tracker->currScene->exit)
+    int nameValidationResult = smPrivateIsValidName(name, __func__);
+    if (nameValidationResult != RES_OK)
     {
-#ifdef SMILE_DEV
-        if (smTestExit)
-        {
-            smTestExit(smMockData);
-        }
-#endif
-        tracker->currScene->exit();
+        return nameValidationResult;
     }
-    tracker->currScene = nullptr;
 
-    smInternalSceneMap *el, *tmp;
-    HASH_ITER(hh, tracker->sceneMap, el, tmp)
+    smInternalScene *scene = smInternalGetScene(name);
+    if (!scene)
     {
-        HASH_DEL(tracker->sceneMap, el);
-        free(el->scene->name);
-        free(el->scene);
-        free(el);
-        tracker->sceneCount--;
+        lgInternalLogWithArg(WARN, ORI, CSE_SCENE_NOT_FOUND, name, __func__, CSQ_ABORT);
+        return RES_SCENE_NOT_FOUND;
     }
 
-    bool isFatal = false;
-    if (smGetSceneCount() != 0)
+    scene->load = load;
+    return RES_OK;
+}
+
+int smSetLoadingScene(const char *name)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
     {
-        isFatal = true;
+        return RES_NOT_RUNNING;
     }
 
-    free(tracker);
-    tracker = nullptr;
+    if (!name)
+    {
+        tracker->loadingScene = nullptr;
+        return RES_OK;
+    }
 
-    if (isFatal)
+    int nameValidationResult = smPrivateIsValidName(name, __func__);
+    if (nameValidationResult != RES_OK)
     {
-        lgInternalLog(FATAL, ORI, CSE_FAILED_TO_FREE_ALL_SCENES, __func__,CSQ_ABORT);
-        return RES_FREE_ALL_SCENES_FAIL;
+        return nameValidationResult;
     }
 
-    lgInternalLog(INFO, ORI, CSE_MODULE_STOP, __func__,CSQ_SUCCESS);
-    return RES_OK;
+    smInternalScene *scene = smInternalGetScene(name);
+    if (!scene)
+    {
+        lgInternalLogWithArg(WARN, ORI, CSE_SCENE_NOT_FOUND, name, __func__, CSQ_ABORT);
+        return RES_SCENE_NOT_FOUND;
+    }
+
+    tracker->loadingScene = scene;
+    return RES_OK;
 }
 
-// —————————————————————————————————————————————————————————————————————————————————————————————————
-// Functions - Internal
-// —————————————————————————————————————————————————————————————————————————————————————————————————
+int smSetLoadBudget(float budgetMs)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (budgetMs < 0.0f)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "budgetMs", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    tracker->loadBudgetMs = budgetMs;
+    return RES_OK;
+}
+
+bool smIsSceneLoading(void)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return false;
+    }
+
+    return tracker->pendingScene;
+}
+
+const char *smGetCurrentSceneName(void)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return nullptr;
+    }
+
+    return tracker->currScene ? tracker->currScene->name : nullptr;
+}
+
+int smGetSceneCount(void)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    return tracker->sceneCount;
+}
 
-const smInternalScene *smInternalGetScene(const char *name)
+int smDeleteScene(const char *name)
 {
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    int nameValidationResult = smPrivateIsValidName(name, __func__);
+    if (nameValidationResult != RES_OK)
+    {
+        return nameValidationResult;
+    }
+
+    if ((tracker->currScene && strcmp(name, tracker->currScene->name) == 0) ||
+        (tracker->pendingScene && strcmp(name, tracker->pendingScene->name) == 0))
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_CANT_DEL_CURR_SCENE, name, __func__, CSQ_ABORT);
+        return RES_CANT_DEL_CURR_SCENE;
+    }
+
     smInternalSceneMap *entry = smInternalGetEntry(name);
-    return entry ? entry->scene : nullptr;
+    if (!entry && smInternalFindInRegistry(name))
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_CANT_DEL_REGISTRY_SCENE, name, __func__, CSQ_ABORT);
+        return RES_CANT_DEL_REGISTRY_SCENE;
+    }
+
+    if (!entry)
+    {
+        lgInternalLogWithArg(WARN, ORI, CSE_SCENE_NOT_FOUND, name, __func__,CSQ_ABORT);
+        return RES_SCENE_NOT_FOUND;
+    }
+
+    if (entry->scene->isSuspended)
+    {
+        smPrivateUnlinkSuspended(entry->scene);
+        smPrivateExitScene(entry->scene);
+    }
+
+    if (tracker->loadingScene == entry->scene)
+    {
+        tracker->loadingScene = nullptr;
+    }
+
+    smPrivateRemoveScene(entry);
+    tracker->sceneCount--;
+
+    lgInternalLogWithArg(INFO, ORI, CSE_SCENE_DELETED, name, __func__,CSQ_SUCCESS);
+    return RES_OK;
 }
 
-smInternalSceneMap *smInternalGetEntry(const char *name)
+// Lifecycle Functions
+
+#ifdef SMILE_UNCHECKED
+int smCheckedUpdate(float dt)
+#else
+int smUpdate(float dt)
+#endif
 {
-    smInternalSceneMap *entry;
-    HASH_FIND_STR(tracker->sceneMap, name, entry);
-    return entry;
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (dt > 0.0f)
+    {
+        mtRecordHistogram(tracker->metrics.frameNs, (uint64_t)(dt * NS_PER_S));
+    }
+
+    if (tracker->pendingScene)
+    {
+        smPrivateStepLoad();
+        if (!tracker)
+        {
+            return RES_OK; // The loader or the scene's enter stopped SceneManager.
+        }
+    }
+
+    if (tracker->currScene)
+    {
+        smPrivateDrainMessages();
+        if (!tracker)
+        {
+            return RES_OK; // A handler stopped SceneManager.
+        }
+    }
+
+    smPrivateAdvanceTimers(dt);
+    if (!tracker)
+    {
+        return RES_OK; // A timer callback stopped SceneManager.
+    }
+
+    PF_BEGIN_ZONE("Tweens");
+    smPrivateAdvanceTweens(dt);
+    PF_END_ZONE();
+
+    if (!tracker->currScene)
+    {
+        if (tracker->pendingScene)
+        {
+            return RES_OK;
+        }
+        lgInternalLog(ERROR, ORI, CSE_NULL_CURR_SCENE, __func__,CSQ_ABORT);
+        return RES_NO_CURR_SCENE;
+    }
+
+    if (!tracker->currScene->update)
+    {
+        lgInternalLogWithArg(WARN, ORI, CSE_NULL_SCENE_UPDATE_FN, tracker->currScene->name, __func__,
+                             CSQ_ABORT);
+        return RES_NO_UPDATE_FUNC;
+    }
+
+    // Read up front, since the callback may stop SceneManager.
+    const smInternalScene *SCENE = tracker->currScene;
+    const mtMetricId METRIC = tracker->metrics.updateNs;
+    const int64_t START_NS = METRIC ? cmGetTimeNs() : 0;
+    uint64_t perfBefore[CM_PERF_COUNTER_COUNT];
+    const bool IS_COUNTING = tracker->isPerfEnabled && cmReadPerfGroup(&tracker->perf, perfBefore);
+    PF_BEGIN_ZONE("Scene Update");
+    SCENE->update(dt);
+    PF_END_ZONE();
+    if (IS_COUNTING)
+    {
+        smPrivateAddPerfSample(SCENE, false, perfBefore);
+    }
+    if (METRIC)
+    {
+        mtRecordHistogram(METRIC, (uint64_t)(cmGetTimeNs() - START_NS));
+    }
+    return RES_OK;
 }
 
-// —————————————————————————————————————————————————————————————————————————————————————————————————
-// Functions - Private
-// —————————————————————————————————————————————————————————————————————————————————————————————————
+float smGetDt(void)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
 
-int smPrivateIsValidName(const char *name, const char *caller)
+    float dt;
+    int64_t nowNs;
+
+    if (smInternalGetTime(&nowNs, __func__) != RES_OK)
+    {
+        return RES_CLOCK_GETTIME_FAIL;
+    }
+
+    /* On the first call, lastTimeNs is zero-initialized, so we default to a
+     * delta time based on the target FPS. This prevents an abnormally large dt,
+     * since we don't know how long after program start the clock is read.
+     */
+    if (tracker->lastTimeNs == 0)
+    {
+        dt = 1.0f / (float)tracker->fps;
+    }
+    else
+    {
+        // Only the final difference is converted, so precision doesn't drop as uptime grows.
+        dt = (float)(nowNs - tracker->lastTimeNs) / (float)NS_PER_S;
+        dt = smPrivateFilterDt(dt);
+    }
+
+    tracker->lastTimeNs = nowNs;
+
+    return dt;
+}
+
+int smSetDtFilter(const smDtFilter *filter)
 {
-    if (!name)
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
     {
-        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "name", caller,CSQ_ABORT);
-        return RES_NULL_ARG;
+        return RES_NOT_RUNNING;
     }
 
-    if (strlen(name) == 0)
+    smDtFilter config = filter ? *filter : (smDtFilter){.mode = SM_DT_FILTER_NONE};
+
+    bool isValidMode = config.mode >= SM_DT_FILTER_NONE && config.mode <= SM_DT_FILTER_MEDIAN;
+    bool isValidSmoothing = config.mode != SM_DT_FILTER_EMA ||
+                            (config.smoothing > 0.0f && config.smoothing <= 1.0f);
+    if (!isValidMode || !isValidSmoothing || config.maxDt < 0.0f || config.snapInterval < 0.0f)
     {
-        lgInternalLogWithArg(ERROR, ORI, CSE_EMPTY_ARG, "name", caller,CSQ_ABORT);
-        return RES_EMPTY_ARG;
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "filter", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
     }
 
+    // History gathered under the previous settings would skew the new ones.
+    tracker->dtFilter = config;
+    tracker->dtHistoryCount = 0;
+    tracker->dtHistoryNext = 0;
+    tracker->smoothedDt = 0.0f;
+    tracker->dtResidual = 0.0f;
+
     return RES_OK;
 }
 
-void smPrivateAddScene(smInternalSceneMap *mapEntry)
+#ifdef SMILE_UNCHECKED
+int smCheckedDraw(void)
+#else
+int smDraw(void)
+#endif
 {
-    HASH_ADD_STR(tracker->sceneMap, name, mapEntry);
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!tracker->currScene)
+    {
+        if (tracker->pendingScene)
+        {
+            return RES_OK;
+        }
+        lgInternalLog(ERROR, ORI, CSE_NULL_CURR_SCENE, __func__,CSQ_ABORT);
+        return RES_NO_CURR_SCENE;
+    }
+
+    if (!tracker->currScene->draw)
+    {
+        lgInternalLogWithArg(WARN, ORI, CSE_NULL_SCENE_DRAW_FN, tracker->currScene->name, __func__, CSQ_ABORT);
+        return RES_NO_DRAW_FUNC;
+    }
+
+    const smInternalScene *SCENE = tracker->currScene;
+    const mtMetricId METRIC = tracker->metrics.drawNs;
+    const int64_t START_NS = METRIC ? cmGetTimeNs() : 0;
+    uint64_t perfBefore[CM_PERF_COUNTER_COUNT];
+    const bool IS_COUNTING = tracker->isPerfEnabled && cmReadPerfGroup(&tracker->perf, perfBefore);
+    PF_BEGIN_ZONE("Scene Draw");
+    SCENE->draw();
+    PF_END_ZONE();
+    if (IS_COUNTING)
+    {
+        smPrivateAddPerfSample(SCENE, true, perfBefore);
+    }
+    if (METRIC)
+    {
+        mtRecordHistogram(METRIC, (uint64_t)(cmGetTimeNs() - START_NS));
+    }
+    return RES_OK;
+}
+
+// Frame Pacing
+
+int smSetClockSource(smClockSource source)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (source < SM_CLOCK_MONOTONIC || source > SM_CLOCK_TSC)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "source", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    if (!smPrivateIsClockSupported(source))
+    {
+        lgInternalLog(ERROR, ORI, CSE_CLOCK_UNSUPPORTED, __func__, CSQ_ABORT);
+        return RES_CLOCK_UNSUPPORTED;
+    }
+
+    if (source == SM_CLOCK_TSC && tracker->tscHz == 0)
+    {
+        int calibrationResult = smPrivateCalibrateTsc();
+        if (calibrationResult != RES_OK)
+        {
+            return calibrationResult;
+        }
+    }
+
+    /* Sources may not share an epoch, so timestamps taken from the previous
+     * one are dropped and timing restarts as if on the first frame.
+     */
+    tracker->clockSource = source;
+    tracker->lastTimeNs = 0;
+    tracker->frameDeadlineNs = 0;
+
+    return RES_OK;
+}
+
+int smSetTargetFps(int fps)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (fps <= 0)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "fps", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    tracker->fps = fps;
+    return RES_OK;
+}
+
+int smWaitForNextFrame(void)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    int64_t nowNs;
+    if (smInternalGetTime(&nowNs, __func__) != RES_OK)
+    {
+        return RES_CLOCK_GETTIME_FAIL;
+    }
+
+    const int64_t FRAME_NS = NS_PER_S / tracker->fps;
+
+    // Only the scene's own work counts, not the idle tasks and sleep that follow.
+    if (tracker->frameDeadlineNs != 0)
+    {
+        smPrivateGovernQuality(nowNs - tracker->frameStartNs);
+    }
+
+    // Late frames restart the schedule rather than rushing the frames after them.
+    if (tracker->frameDeadlineNs == 0 || nowNs >= tracker->frameDeadlineNs)
+    {
+        tracker->frameDeadlineNs = nowNs + FRAME_NS;
+        tracker->frameStartNs = nowNs;
+        return RES_OK;
+    }
+
+    int64_t deadlineNs = tracker->frameDeadlineNs;
+    smPrivateRunIdleTasks(deadlineNs);
+    smPrivateSleepUntil(deadlineNs);
+
+    tracker->frameDeadlineNs = deadlineNs + FRAME_NS;
+    if (smInternalGetTime(&tracker->frameStartNs, __func__) != RES_OK)
+    {
+        tracker->frameStartNs = deadlineNs;
+    }
+    return RES_OK;
+}
+
+int smSetFrameBudget(float budgetMs)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (budgetMs < 0.0f)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "budgetMs", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    tracker->frameBudgetMs = budgetMs;
+    return RES_OK;
+}
+
+int smGetQualityLevel(void)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    return tracker->qualityLevel;
+}
+
+int smPostIdleTask(smIdleFn task, void *args)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!task)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "task", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+
+    if (tracker->idleCount == IDLE_QUEUE_CAPACITY)
+    {
+        lgInternalLog(WARN, ORI, CSE_IDLE_QUEUE_FULL, __func__, CSQ_ABORT);
+        return RES_IDLE_QUEUE_FULL;
+    }
+
+    size_t tail = (tracker->idleHead + tracker->idleCount) % IDLE_QUEUE_CAPACITY;
+    tracker->idleTasks[tail] = (smInternalIdleTask){
+        .task = task,
+        .args = args,
+        .owner = tracker->currScene,
+    };
+    tracker->idleCount++;
+
+    return RES_OK;
+}
+
+// Messaging
+
+int smSetSceneMessageHandler(const char *name, smMessageFn handleMessage)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    int nameValidationResult = smPrivateIsValidName(name, __func__);
+    if (nameValidationResult != RES_OK)
+    {
+        return nameValidationResult;
+    }
+
+    smInternalScene *scene = smInternalGetScene(name);
+    if (!scene)
+    {
+        lgInternalLogWithArg(WARN, ORI, CSE_SCENE_NOT_FOUND, name, __func__, CSQ_ABORT);
+        return RES_SCENE_NOT_FOUND;
+    }
+
+    scene->handleMessage = handleMessage;
+    smPrivateRefreshCachedCallbacks();
+    return RES_OK;
+}
+
+int smSetMessageMode(smMessageMode mode)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (mode != SM_MESSAGES_MPSC && mode != SM_MESSAGES_SPSC)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "mode", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    CM_STORE_RELAXED(&messageQueue.mode, mode);
+    return RES_OK;
+}
+
+int smPostMessage(uint32_t type, const void *data, size_t size)
+{
+    // Checks the queue rather than the tracker, which only the main thread may read.
+    if (!CM_LOAD_ACQUIRE(&messageQueue.isOpen))
+    {
+        lgInternalLog(ERROR, ORI, CSE_NOT_RUNNING, __func__, CSQ_ABORT);
+        return RES_NOT_RUNNING;
+    }
+
+    if (size > SM_MESSAGE_DATA_SIZE)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "size", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    if (!data && size > 0)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "data", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+
+    size_t pos;
+    smInternalMessageCell *cell = smPrivateClaimMessageCell(&pos);
+    if (!cell)
+    {
+        lgInternalLog(WARN, ORI, CSE_MESSAGE_QUEUE_FULL, __func__, CSQ_ABORT);
+        return RES_MESSAGE_QUEUE_FULL;
+    }
+
+    cell->message.type = type;
+    cell->message.size = (uint32_t)size;
+    if (size > 0)
+    {
+        memcpy(cell->message.data, data, size);
+    }
+
+    // Publishes the message; the consumer won't touch the slot before this.
+    CM_STORE_RELEASE(&cell->sequence, pos + 1);
+#ifdef SMILE_UNCHECKED
+    // Routes the next smUpdate() through the checked path, which drains the
+    // queue. Pairs with the fence in smPrivateRefreshCachedCallbacks().
+    atomic_thread_fence(memory_order_seq_cst);
+    CM_STORE_RELAXED(&smInternalCachedUpdate, smPrivateUpdateFallback);
+#endif
+    return RES_OK;
+}
+
+// Timers
+
+int smAddTimer(float delay, float interval, smTimerFn fn, void *args, smTimerId *id)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!fn)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "fn", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+
+    // Written as negations so NaN is rejected too.
+    if (!(delay >= 0.0f) || !(interval >= 0.0f))
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, !(delay >= 0.0f) ? "delay" : "interval",
+                             __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    if (!tracker->freeTimer)
+    {
+        int growResult = smPrivateGrowTimers();
+        if (growResult != RES_OK)
+        {
+            return growResult;
+        }
+    }
+
+    uint32_t index = tracker->freeTimer;
+    smInternalTimer *timer = &tracker->timers[index];
+    tracker->freeTimer = timer->next;
+
+    smInternalScene *owner = tracker->currScene;
+    *timer = (smInternalTimer){
+        .fn = fn,
+        .args = args,
+        .owner = owner,
+        .expiresTick = tracker->timerTick + smPrivateToTicks(delay),
+        .intervalTicks = interval > 0.0f ? smPrivateToTicks(interval) : 0,
+        .generation = timer->generation,
+        .isPending = true,
+    };
+
+    if (owner)
+    {
+        timer->ownerNext = owner->timerHead;
+        if (owner->timerHead)
+        {
+            tracker->timers[owner->timerHead].ownerPrev = index;
+        }
+        owner->timerHead = index;
+    }
+
+    smPrivateScheduleTimer(index);
+    if (tracker->timerCount++ == 0)
+    {
+        smPrivateRefreshCachedCallbacks();
+    }
+
+    if (id)
+    {
+        *id = (smTimerId)timer->generation << 32 | index;
+    }
+    return RES_OK;
+}
+
+int smCancelTimer(smTimerId id)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    uint32_t index = (uint32_t)id;
+    uint32_t generation = (uint32_t)(id >> 32);
+    if (index == 0 || index >= tracker->timerCapacity || !tracker->timers[index].isPending ||
+        tracker->timers[index].generation != generation)
+    {
+        lgInternalLog(WARN, ORI, CSE_TIMER_NOT_FOUND, __func__, CSQ_ABORT);
+        return RES_TIMER_NOT_FOUND;
+    }
+
+    smPrivateReleaseTimer(index);
+    return RES_OK;
+}
+
+// Tweens
+
+int smAddTween(float *target, float from, float to, float duration, smEasing easing,
+               smTweenId *id)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!target)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "target", __func__, CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+
+    // Written as a negation so NaN is rejected too.
+    if (!(duration > 0.0f))
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "duration", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    if (easing < SM_EASE_LINEAR || easing >= EASING_COUNT)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, "easing", __func__, CSQ_ABORT);
+        return RES_INVALID_ARG;
+    }
+
+    smInternalTweenGroup *group = &tracker->tweenGroups[easing];
+    if (group->count == group->capacity)
+    {
+        int growResult = smPrivateGrowTweenGroup(group);
+        if (growResult != RES_OK)
+        {
+            return growResult;
+        }
+    }
+
+    if (!tracker->freeTweenSlot)
+    {
+        int growResult = smPrivateGrowTweenSlots();
+        if (growResult != RES_OK)
+        {
+            return growResult;
+        }
+    }
+
+    uint32_t index = tracker->freeTweenSlot;
+    smInternalTweenSlot *slot = &tracker->tweenSlots[index];
+    tracker->freeTweenSlot = slot->nextFree;
+
+    size_t position = group->count++;
+    slot->easing = (uint32_t)easing;
+    slot->position = (uint32_t)position;
+    slot->isRunning = true;
+
+    group->targets[position] = target;
+    group->owners[position] = tracker->currScene;
+    group->from[position] = from;
+    group->to[position] = to;
+    group->elapsed[position] = 0.0f;
+    group->invDuration[position] = 1.0f / duration;
+    group->handles[position] = index;
+
+    if (tracker->tweenCount++ == 0)
+    {
+        smPrivateRefreshCachedCallbacks();
+    }
+
+    if (id)
+    {
+        *id = (smTweenId)slot->generation << 32 | index;
+    }
+    return RES_OK;
+}
+
+int smCancelTween(smTweenId id)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    uint32_t index = (uint32_t)id;
+    uint32_t generation = (uint32_t)(id >> 32);
+    if (index == 0 || index >= tracker->tweenSlotCapacity ||
+        !tracker->tweenSlots[index].isRunning ||
+        tracker->tweenSlots[index].generation != generation)
+    {
+        lgInternalLog(WARN, ORI, CSE_TWEEN_NOT_FOUND, __func__, CSQ_ABORT);
+        return RES_TWEEN_NOT_FOUND;
+    }
+
+    smInternalTweenSlot *slot = &tracker->tweenSlots[index];
+    smPrivateRemoveTween(&tracker->tweenGroups[slot->easing], slot->position);
+    return RES_OK;
+}
+
+int smSetParallelTweens(bool isEnabled)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (isEnabled == tracker->isTweenPoolHeld)
+    {
+        return RES_OK;
+    }
+
+    if (!isEnabled)
+    {
+        cmStopJobs();
+        tracker->isTweenPoolHeld = false;
+        return RES_OK;
+    }
+
+    const int RESULT = cmStartJobs(0);
+    if (RESULT != RES_OK)
+    {
+        lgInternalLog(WARN, ORI, CSE_JOBS_UNAVAILABLE, __func__, CSQ_ABORT);
+        return RESULT;
+    }
+
+    tracker->isTweenPoolHeld = true;
+    return RES_OK;
+}
+
+// Performance Counters
+
+int smSetPerfCounters(bool isEnabled)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (!isEnabled)
+    {
+        if (tracker->isPerfEnabled)
+        {
+            cmClosePerfGroup(&tracker->perf);
+            tracker->isPerfEnabled = false;
+            smPrivateRefreshCachedCallbacks();
+        }
+        return RES_OK;
+    }
+
+    if (tracker->isPerfEnabled)
+    {
+        return RES_OK;
+    }
+
+    if (cmOpenPerfGroup(&tracker->perf) != RES_OK)
+    {
+        lgInternalLog(WARN, ORI, CSE_PERF_UNAVAILABLE, __func__, CSQ_ABORT);
+        return RES_PERF_UNAVAILABLE;
+    }
+
+    for (int i = 0; i < CM_PERF_COUNTER_COUNT; i++)
+    {
+        if (!cmIsPerfCounterOpen(&tracker->perf, i))
+        {
+            lgInternalLog(WARN, ORI, CSE_PERF_PARTIAL, __func__, CSQ_PAUSE);
+            break;
+        }
+    }
+
+    tracker->isPerfEnabled = true;
+    smPrivateRefreshCachedCallbacks();
+    return RES_OK;
+}
+
+int smGetScenePerfCounters(const char *name, smPerfCounters *update, smPerfCounters *draw)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    int nameValidationResult = smPrivateIsValidName(name, __func__);
+    if (nameValidationResult != RES_OK)
+    {
+        return nameValidationResult;
+    }
+
+    const smInternalScene *SCENE = smInternalGetScene(name);
+    if (!SCENE)
+    {
+        lgInternalLogWithArg(WARN, ORI, CSE_SCENE_NOT_FOUND, name, __func__, CSQ_ABORT);
+        return RES_SCENE_NOT_FOUND;
+    }
+
+    if (update)
+    {
+        *update = SCENE->perf ? SCENE->perf->update : (smPerfCounters){0};
+    }
+    if (draw)
+    {
+        *draw = SCENE->perf ? SCENE->perf->draw : (smPerfCounters){0};
+    }
+    return RES_OK;
+}
+
+// Stop Related
+
+int smStop(void)
+{
+    if (!cmIsRunning(smIsRunning, ORI, __func__))
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (tracker->currScene)
+    {
+        smPrivateExitScene(tracker->currScene);
+    }
+    tracker->currScene = nullptr;
+    pfInternalSetSampleTag(nullptr);
+
+    if (tracker->pendingScene)
+    {
+        smPrivateAbandonLoad();
+    }
+
+    while (tracker->suspendedHead)
+    {
+        smInternalScene *scene = tracker->suspendedHead;
+        smPrivateUnlinkSuspended(scene);
+        smPrivateExitScene(scene);
+    }
+
+    // Every scene callback has run, so the session's profile is complete.
+    pfInternalWriteSampledStacks();
+
+    smInternalSceneMap *el, *tmp;
+    HASH_ITER(hh, tracker->sceneMap, el, tmp)
+    {
+        smPrivateRemoveScene(el);
+        tracker->sceneCount--;
+    }
+
+    while (tracker->sceneBlocks)
+    {
+        smInternalSceneBlock *block = tracker->sceneBlocks;
+        tracker->sceneBlocks = block->next;
+        tsFree(block);
+    }
+
+    if (tracker->registry)
+    {
+        tracker->sceneCount -= (int)tracker->registry->sceneCount;
+        for (size_t i = 0; i < tracker->registry->sceneCount; i++)
+        {
+            tsFree(tracker->registryScenes[i].perf);
+        }
+        tsFree(tracker->registryScenes);
+    }
+
+    bool isFatal = false;
+    if (smGetSceneCount() != 0)
+    {
+        isFatal = true;
+    }
+
+    CM_STORE_RELEASE(&messageQueue.isOpen, false);
+
+    if (tracker->isPerfEnabled)
+    {
+        cmClosePerfGroup(&tracker->perf);
+    }
+    if (tracker->isTweenPoolHeld)
+    {
+        cmStopJobs();
+    }
+    tsFree(tracker->timers);
+    for (int i = 0; i < EASING_COUNT; i++)
+    {
+        tsFree(tracker->tweenGroups[i].block);
+    }
+    tsFree(tracker->tweenSlots);
+    tsFree(tracker);
+    tracker = nullptr;
+    smPrivateRefreshCachedCallbacks();
+
+    if (tsReportAllocations("SceneManager") > 0)
+    {
+        lgInternalLog(WARN, ORI, CSE_MEMORY_LEAKED, __func__, CSQ_SUCCESS);
+    }
+
+    if (isFatal)
+    {
+        lgInternalLog(FATAL, ORI, CSE_FAILED_TO_FREE_ALL_SCENES, __func__,CSQ_ABORT);
+        return RES_FREE_ALL_SCENES_FAIL;
+    }
+
+    lgInternalLog(INFO, ORI, CSE_MODULE_STOP, __func__,CSQ_SUCCESS);
+    return RES_OK;
+}
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Internal
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+smInternalScene *smInternalGetScene(const char *name)
+{
+    smInternalScene *scene = smInternalFindInRegistry(name);
+    if (scene)
+    {
+        return scene;
+    }
+
+    smInternalSceneMap *entry = smInternalGetEntry(name);
+    return entry ? entry->scene : nullptr;
+}
+
+smInternalSceneMap *smInternalGetEntry(const char *name)
+{
+    smInternalSceneMap *entry;
+    HASH_FIND_STR(tracker->sceneMap, name, entry);
+    return entry;
+}
+
+smInternalScene *smInternalFindInRegistry(const char *name)
+{
+    const smSceneRegistry *registry = tracker->registry;
+    if (!registry)
+    {
+        return nullptr;
+    }
+
+    uint32_t seed = registry->seeds[cmHashString(name, 0) % registry->seedCount];
+    size_t index = cmHashString(name, seed) % registry->sceneCount;
+
+    return strcmp(registry->scenes[index].name, name) == 0
+               ? &tracker->registryScenes[index]
+               : nullptr;
+}
+
+// Clock Related
+
+int smInternalGetTime(int64_t *nowNs, const char *caller)
+{
+#ifdef SMILE_DEV
+    if (smMockClockGettimeFails)
+    {
+        lgInternalLog(ERROR, ORI, CSE_CLOCK_GETTIME_FAILED, caller, CSQ_ABORT);
+        return RES_CLOCK_GETTIME_FAIL;
+    }
+    // Only the default source is mocked, so tests can still read the others.
+    if (tracker->clockSource == SM_CLOCK_MONOTONIC)
+    {
+        *nowNs = smPrivateToNs(smMockCurrTime);
+        return RES_OK;
+    }
+#endif
+
+#ifdef SM_HAS_TSC
+    if (tracker->clockSource == SM_CLOCK_TSC)
+    {
+        uint64_t elapsedNs = smInternalTscToNs(__rdtsc() - tracker->tscBase, tracker->tscHz);
+        *nowNs = tracker->tscBaseNs + (int64_t)elapsedNs;
+        return RES_OK;
+    }
+#endif
+
+    clockid_t clockId;
+    smPrivateGetClockId(tracker->clockSource, &clockId);
+
+    struct timespec now;
+    if (clock_gettime(clockId, &now) != 0)
+    {
+        lgInternalLog(ERROR, ORI, CSE_CLOCK_GETTIME_FAILED, caller, CSQ_ABORT);
+        return RES_CLOCK_GETTIME_FAIL;
+    }
+    *nowNs = smPrivateToNs(now);
+
+    return RES_OK;
+}
+
+uint64_t smInternalTscToNs(uint64_t ticks, uint64_t tscHz)
+{
+    // Split so the multiplication can't overflow however long the game runs.
+    return ticks / tscHz * NS_PER_S + ticks % tscHz * NS_PER_S / tscHz;
+}
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Private
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int smPrivateIsValidName(const char *name, const char *caller)
+{
+    if (!name)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NULL_ARG, "name", caller,CSQ_ABORT);
+        return RES_NULL_ARG;
+    }
+
+    if (strlen(name) == 0)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_EMPTY_ARG, "name", caller,CSQ_ABORT);
+        return RES_EMPTY_ARG;
+    }
+
+    return RES_OK;
+}
+
+void smPrivateAddScene(smInternalSceneMap *mapEntry)
+{
+    HASH_ADD_STR(tracker->sceneMap, name, mapEntry);
+}
+
+void smPrivateRemoveScene(smInternalSceneMap *mapEntry)
+{
+    HASH_DEL(tracker->sceneMap, mapEntry);
+    tsFree(mapEntry->scene->perf);
+    mapEntry->scene->perf = nullptr;
+    if (mapEntry->scene->isStatic)
+    {
+        return;
+    }
+
+    tsFree((char *)mapEntry->scene->name);
+    tsFree(mapEntry->scene);
+    tsFree(mapEntry);
+}
+
+void smPrivateEnterScene(smInternalScene *scene, void *args)
+{
+    if (!scene->enter)
+    {
+        return;
+    }
+
+#ifdef SMILE_DEV
+    if (args && smTestEnterWithArgs)
+    {
+        smTestEnterWithArgs(smMockData, args);
+    }
+    else if (smTestEnter)
+    {
+        smTestEnter(smMockData);
+    }
+#endif
+    PF_BEGIN_ZONE("Scene Enter");
+    scene->enter(args);
+    PF_END_ZONE();
+}
+
+void smPrivateExitScene(smInternalScene *scene)
+{
+    while (scene->timerHead)
+    {
+        smPrivateReleaseTimer(scene->timerHead);
+    }
+
+    // Scans every tween, which is fine since scenes exit far less often than tweens step.
+    for (int i = 0; i < EASING_COUNT; i++)
+    {
+        smInternalTweenGroup *group = &tracker->tweenGroups[i];
+        for (size_t j = group->count; j-- > 0;)
+        {
+            if (group->owners[j] == scene)
+            {
+                smPrivateRemoveTween(group, j);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < tracker->idleCount; i++)
+    {
+        smInternalIdleTask *idle = &tracker->idleTasks[(tracker->idleHead + i) % IDLE_QUEUE_CAPACITY];
+        if (idle->owner == scene)
+        {
+            idle->task = nullptr;
+        }
+    }
+
+    if (!scene->exit)
+    {
+        return;
+    }
+
+#ifdef SMILE_DEV
+    if (smTestExit)
+    {
+        smTestExit(smMockData);
+    }
+#endif
+    PF_BEGIN_ZONE("Scene Exit");
+    scene->exit();
+    PF_END_ZONE();
+}
+
+void smPrivateLeaveScene(smInternalScene *scene)
+{
+    if (!scene->suspend || scene->suspendCost > tracker->suspendBudget)
+    {
+        smPrivateExitScene(scene);
+        return;
+    }
+
+    PF_BEGIN_ZONE("Scene Suspend");
+    scene->suspend();
+    PF_END_ZONE();
+
+    scene->isSuspended = true;
+    scene->prevSuspended = nullptr;
+    scene->nextSuspended = tracker->suspendedHead;
+    if (tracker->suspendedHead)
+    {
+        tracker->suspendedHead->prevSuspended = scene;
+    }
+    else
+    {
+        tracker->suspendedTail = scene;
+    }
+    tracker->suspendedHead = scene;
+    tracker->suspendedCost += scene->suspendCost;
+
+    smPrivateEvictOverBudget();
+}
+
+void smPrivateUnlinkSuspended(smInternalScene *scene)
+{
+    if (scene->prevSuspended)
+    {
+        scene->prevSuspended->nextSuspended = scene->nextSuspended;
+    }
+    else
+    {
+        tracker->suspendedHead = scene->nextSuspended;
+    }
+
+    if (scene->nextSuspended)
+    {
+        scene->nextSuspended->prevSuspended = scene->prevSuspended;
+    }
+    else
+    {
+        tracker->suspendedTail = scene->prevSuspended;
+    }
+
+    scene->prevSuspended = nullptr;
+    scene->nextSuspended = nullptr;
+    scene->isSuspended = false;
+    tracker->suspendedCost -= scene->suspendCost;
+}
+
+void smPrivateEvictOverBudget(void)
+{
+    while (tracker->suspendedTail && tracker->suspendedCost > tracker->suspendBudget)
+    {
+        smInternalScene *scene = tracker->suspendedTail;
+        smPrivateUnlinkSuspended(scene);
+        smPrivateExitScene(scene);
+        lgInternalLogWithArg(INFO, ORI, CSE_SCENE_EVICTED, scene->name, __func__, CSQ_SUCCESS);
+    }
+}
+
+void smPrivateAbandonLoad(void)
+{
+    smInternalScene *scene = tracker->pendingScene;
+    tracker->pendingScene = nullptr;
+    tracker->pendingArgs = nullptr;
+
+    smPrivateRefreshCachedCallbacks();
+    smPrivateExitScene(scene);
+    lgInternalLogWithArg(INFO, ORI, CSE_SCENE_LOAD_ABANDONED, scene->name, __func__, CSQ_SUCCESS);
+}
+
+void smPrivateStepLoad(void)
+{
+    smInternalScene *scene = tracker->pendingScene;
+
+    int64_t startNs, nowNs;
+    bool hasClock = smInternalGetTime(&startNs, __func__) == RES_OK;
+    const long BUDGET_NS = (long)(tracker->loadBudgetMs * NS_PER_MS);
+
+    // The loader always gets one call per frame so loading can't stall. It may
+    // also stop SceneManager or switch scenes, which abandons this load.
+    PF_BEGIN_ZONE("Scene Load");
+    bool isDone = !scene->load || scene->load(tracker->pendingArgs);
+    bool isAbandoned = !tracker || tracker->pendingScene != scene;
+    while (!isDone && !isAbandoned && hasClock && smInternalGetTime(&nowNs, __func__) == RES_OK)
+    {
+        if (nowNs - startNs >= BUDGET_NS)
+        {
+            break;
+        }
+        isDone = scene->load(tracker->pendingArgs);
+        isAbandoned = !tracker || tracker->pendingScene != scene;
+    }
+    PF_END_ZONE();
+
+    if (!isDone || isAbandoned)
+    {
+        return;
+    }
+
+    void *args = tracker->pendingArgs;
+    tracker->pendingScene = nullptr;
+    tracker->pendingArgs = nullptr;
+
+    if (tracker->currScene)
+    {
+        if (tracker->currScene == tracker->loadingScene)
+        {
+            smPrivateExitScene(tracker->currScene);
+        }
+        else
+        {
+            smPrivateLeaveScene(tracker->currScene);
+        }
+    }
+
+    tracker->currScene = scene;
+    pfInternalSetSampleTag(scene->name);
+    smPrivateRefreshCachedCallbacks();
+    mtAddCounter(tracker->metrics.sceneSwitches, 1);
+
+    // Logged first, since enter may stop SceneManager and free the scene.
+    lgInternalLogWithArg(INFO, ORI, CSE_SCENE_SET_TO, scene->name, __func__, CSQ_SUCCESS);
+    smPrivateEnterScene(scene, args);
+}
+
+void smPrivateRefreshCachedCallbacks(void)
+{
+#ifdef SMILE_UNCHECKED
+    const smInternalScene *scene = tracker ? tracker->currScene : nullptr;
+    bool isLoading = tracker && tracker->pendingScene;
+
+    bool hasTimers = tracker && (tracker->timerCount > 0 || tracker->tweenCount > 0);
+    // Counters are only read, and metrics only published, on the checked path.
+    bool isCounting = tracker && tracker->isPerfEnabled;
+    bool isTimingUpdate = tracker && (tracker->metrics.frameNs || tracker->metrics.updateNs);
+    bool isTimingDraw = tracker && tracker->metrics.drawNs;
+
+    if (!scene || !scene->update || scene->handleMessage || isLoading || hasTimers || isCounting ||
+        isTimingUpdate)
+    {
+        CM_STORE_RELAXED(&smInternalCachedUpdate, smPrivateUpdateFallback);
+    }
+    else
+    {
+        // Queued messages still need draining, which only the checked path
+        // does. Checked after the store, so a producer posting meanwhile
+        // either is seen here or overwrites it with the fallback.
+        CM_STORE_RELAXED(&smInternalCachedUpdate, scene->update);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (smPrivateHasMessages())
+        {
+            CM_STORE_RELAXED(&smInternalCachedUpdate, smPrivateUpdateFallback);
+        }
+    }
+    smInternalCachedDraw = scene && scene->draw && !isCounting && !isTimingDraw
+                               ? scene->draw
+                               : smPrivateDrawFallback;
+#endif
+}
+
+#ifdef SMILE_UNCHECKED
+void smPrivateUpdateFallback(float dt)
+{
+    smCheckedUpdate(dt);
+    // Returns to the fast path once e.g. the queue is drained or timers are done.
+    smPrivateRefreshCachedCallbacks();
+}
+
+void smPrivateDrawFallback(void)
+{
+    smCheckedDraw();
+}
+#endif
+
+float smPrivateFilterDt(float dt)
+{
+    const smDtFilter *filter = &tracker->dtFilter;
+
+    // Clamping first keeps a single hitch out of the smoothing history.
+    if (filter->maxDt > 0.0f && dt > filter->maxDt)
+    {
+        dt = filter->maxDt;
+    }
+
+    if (filter->mode == SM_DT_FILTER_EMA)
+    {
+        if (tracker->smoothedDt == 0.0f)
+        {
+            tracker->smoothedDt = dt;
+        }
+        else
+        {
+            tracker->smoothedDt += filter->smoothing * (dt - tracker->smoothedDt);
+        }
+        dt = tracker->smoothedDt;
+    }
+    else if (filter->mode == SM_DT_FILTER_MEDIAN)
+    {
+        tracker->dtHistory[tracker->dtHistoryNext] = dt;
+        tracker->dtHistoryNext = (tracker->dtHistoryNext + 1) % DT_MEDIAN_WINDOW;
+        if (tracker->dtHistoryCount < DT_MEDIAN_WINDOW)
+        {
+            tracker->dtHistoryCount++;
+        }
+
+        float sorted[DT_MEDIAN_WINDOW];
+        for (int i = 0; i < tracker->dtHistoryCount; i++)
+        {
+            int j = i;
+            for (; j > 0 && sorted[j - 1] > tracker->dtHistory[i]; j--)
+            {
+                sorted[j] = sorted[j - 1];
+            }
+            sorted[j] = tracker->dtHistory[i];
+        }
+        dt = sorted[tracker->dtHistoryCount / 2];
+    }
+
+    /* Time shaved off or added by snapping is carried into the next frame, so
+     * the snapped deltas still add up to the real elapsed time.
+     */
+    if (filter->snapInterval > 0.0f)
+    {
+        float raw = dt + tracker->dtResidual;
+        int frames = (int)(raw / filter->snapInterval + 0.5f);
+        float snapped = (float)frames * filter->snapInterval;
+        float error = raw - snapped;
+
+        bool isNearInterval = error < filter->snapInterval * DT_SNAP_TOLERANCE &&
+                              -error < filter->snapInterval * DT_SNAP_TOLERANCE;
+        if (frames > 0 && isNearInterval)
+        {
+            tracker->dtResidual = error;
+            dt = snapped;
+        }
+        else
+        {
+            tracker->dtResidual = 0.0f;
+            dt = raw;
+        }
+    }
+
+    return dt;
+}
+
+void smPrivateCreateMetrics(void)
+{
+    if (!mtIsRunning())
+    {
+        return;
+    }
+
+    // A metric that fails to register keeps a `0` handle and is skipped.
+    mtCreateCounter("sm.scene_switches", &tracker->metrics.sceneSwitches);
+    mtCreateHistogram("sm.frame_ns", &tracker->metrics.frameNs);
+    mtCreateHistogram("sm.update_ns", &tracker->metrics.updateNs);
+    mtCreateHistogram("sm.draw_ns", &tracker->metrics.drawNs);
+}
+
+void smPrivateAddPerfSample(const smInternalScene *scene, bool isDraw, const uint64_t *before)
+{
+    if (!tracker || !tracker->isPerfEnabled || tracker->currScene != scene)
+    {
+        return;
+    }
+
+    uint64_t after[CM_PERF_COUNTER_COUNT];
+    if (!cmReadPerfGroup(&tracker->perf, after))
+    {
+        return;
+    }
+
+    // Allocated on first measurement, so unmeasured scenes cost one pointer.
+    smInternalScene *target = tracker->currScene;
+    if (!target->perf)
+    {
+        target->perf = tsCalloc(1, sizeof(smInternalScenePerf));
+        if (!target->perf)
+        {
+            return;
+        }
+    }
+
+    smPerfCounters *totals = isDraw ? &target->perf->draw : &target->perf->update;
+    totals->calls++;
+    totals->cycles += after[CM_PERF_CYCLES] - before[CM_PERF_CYCLES];
+    totals->instructions += after[CM_PERF_INSTRUCTIONS] - before[CM_PERF_INSTRUCTIONS];
+    totals->cacheMisses += after[CM_PERF_CACHE_MISSES] - before[CM_PERF_CACHE_MISSES];
+    totals->branchMisses += after[CM_PERF_BRANCH_MISSES] - before[CM_PERF_BRANCH_MISSES];
+}
+
+void smPrivateOpenMessageQueue(void)
+{
+    // No thread may post while SceneManager is stopped, so plain resets are safe here.
+    for (size_t i = 0; i < MESSAGE_QUEUE_CAPACITY; i++)
+    {
+        CM_STORE_RELAXED(&messageQueue.cells[i].sequence, i);
+    }
+    CM_STORE_RELAXED(&messageQueue.tail, 0);
+    messageQueue.head = 0;
+    CM_STORE_RELAXED(&messageQueue.mode, SM_MESSAGES_MPSC);
+
+    CM_STORE_RELEASE(&messageQueue.isOpen, true);
+}
+
+smInternalMessageCell *smPrivateClaimMessageCell(size_t *pos)
+{
+    size_t tail = CM_LOAD_RELAXED(&messageQueue.tail);
+
+    if (CM_LOAD_RELAXED(&messageQueue.mode) == SM_MESSAGES_SPSC)
+    {
+        smInternalMessageCell *cell = &messageQueue.cells[tail & (MESSAGE_QUEUE_CAPACITY - 1)];
+        if (CM_LOAD_ACQUIRE(&cell->sequence) != tail)
+        {
+            return nullptr;
+        }
+
+        CM_STORE_RELAXED(&messageQueue.tail, tail + 1);
+        *pos = tail;
+        return cell;
+    }
+
+    while (true)
+    {
+        smInternalMessageCell *cell = &messageQueue.cells[tail & (MESSAGE_QUEUE_CAPACITY - 1)];
+        size_t sequence = CM_LOAD_ACQUIRE(&cell->sequence);
+        intptr_t lap = (intptr_t)(sequence - tail);
+
+        if (lap == 0)
+        {
+            // On failure, tail is reloaded with the position another producer left.
+            if (atomic_compare_exchange_weak_explicit(&messageQueue.tail, &tail, tail + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                *pos = tail;
+                return cell;
+            }
+            cmCpuRelax(); // back off before retrying against the other producers
+        }
+        else if (lap < 0)
+        {
+            return nullptr; // The slot still holds a message from the previous lap.
+        }
+        else
+        {
+            tail = CM_LOAD_RELAXED(&messageQueue.tail);
+        }
+    }
+}
+
+void smPrivateDrainMessages(void)
+{
+    for (size_t i = 0; i < MESSAGE_QUEUE_CAPACITY && tracker && tracker->currScene; i++)
+    {
+        size_t head = messageQueue.head;
+        smInternalMessageCell *cell = &messageQueue.cells[head & (MESSAGE_QUEUE_CAPACITY - 1)];
+        if (CM_LOAD_ACQUIRE(&cell->sequence) != head + 1)
+        {
+            return;
+        }
+
+        // Copied and released first, so the handler can post into this slot again.
+        smMessage message = cell->message;
+        CM_STORE_RELEASE(&cell->sequence, head + MESSAGE_QUEUE_CAPACITY);
+        messageQueue.head = head + 1;
+
+        if (tracker->currScene->handleMessage)
+        {
+            PF_BEGIN_ZONE("Scene Message");
+            tracker->currScene->handleMessage(&message);
+            PF_END_ZONE();
+        }
+    }
+}
+
+#ifdef SMILE_UNCHECKED
+bool smPrivateHasMessages(void)
+{
+    const size_t HEAD = messageQueue.head;
+    const smInternalMessageCell *CELL = &messageQueue.cells[HEAD & (MESSAGE_QUEUE_CAPACITY - 1)];
+    return CM_LOAD_ACQUIRE(&CELL->sequence) == HEAD + 1;
+}
+#endif
+
+uint32_t smPrivateToTicks(float seconds)
+{
+    float ticks = seconds * TIMER_TICKS_PER_S;
+    if (ticks >= (float)UINT32_MAX)
+    {
+        return UINT32_MAX;
+    }
+
+    // Rounded rather than truncated, since e.g. 0.05f seconds is 50.0000007 ticks.
+    uint32_t whole = (uint32_t)(ticks + 0.5f);
+    return whole > 0 ? whole : 1;
+}
+
+int smPrivateGrowTimers(void)
+{
+    // Index 0 is reserved as the list terminator, so a fresh pool starts at 1.
+    uint32_t first = tracker->timerCapacity ? tracker->timerCapacity : 1;
+    uint32_t capacity = tracker->timerCapacity ? tracker->timerCapacity * 2 : TIMER_INITIAL_CAPACITY;
+
+    smInternalTimer *timers = tsRealloc(tracker->timers, capacity * sizeof(smInternalTimer));
+    if (!timers)
+    {
+        lgInternalLog(ERROR, ORI, CSE_MEM_ALLOC_FAIL, __func__, CSQ_ABORT);
+        return RES_MEM_ALLOC_FAIL;
+    }
+
+    memset(&timers[first], 0, (capacity - first) * sizeof(smInternalTimer));
+    for (uint32_t i = first; i < capacity - 1; i++)
+    {
+        timers[i].next = i + 1;
+    }
+    timers[capacity - 1].next = tracker->freeTimer;
+
+    tracker->timers = timers;
+    tracker->timerCapacity = capacity;
+    tracker->freeTimer = first;
+    return RES_OK;
+}
+
+void smPrivateScheduleTimer(uint32_t index)
+{
+    smInternalTimer *timer = &tracker->timers[index];
+    const uint64_t SPAN = (uint64_t)1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS);
+
+    /* Timers beyond the wheel's span park in the top level at its far edge and
+     * are placed again each time that slot cascades.
+     */
+    uint64_t delta = timer->expiresTick - tracker->timerTick;
+    uint64_t slotTick = delta < SPAN ? timer->expiresTick : tracker->timerTick + SPAN - 1;
+
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >> (TIMER_WHEEL_BITS * (level + 1)) != 0)
+    {
+        level++;
+    }
+
+    uint32_t slot = level * TIMER_WHEEL_SLOTS +
+                    (uint32_t)(slotTick >> (TIMER_WHEEL_BITS * level) & TIMER_WHEEL_MASK);
+    timer->slot = slot;
+    timer->prev = 0;
+    timer->next = tracker->timerWheel[slot];
+    if (timer->next)
+    {
+        tracker->timers[timer->next].prev = index;
+    }
+    tracker->timerWheel[slot] = index;
+}
+
+void smPrivateUnscheduleTimer(uint32_t index)
+{
+    smInternalTimer *timer = &tracker->timers[index];
+
+    if (timer->prev)
+    {
+        tracker->timers[timer->prev].next = timer->next;
+    }
+    else
+    {
+        tracker->timerWheel[timer->slot] = timer->next;
+    }
+
+    if (timer->next)
+    {
+        tracker->timers[timer->next].prev = timer->prev;
+    }
+}
+
+void smPrivateReleaseTimer(uint32_t index)
+{
+    smInternalTimer *timer = &tracker->timers[index];
+    smPrivateUnscheduleTimer(index);
+
+    if (timer->owner)
+    {
+        if (timer->ownerPrev)
+        {
+            tracker->timers[timer->ownerPrev].ownerNext = timer->ownerNext;
+        }
+        else
+        {
+            timer->owner->timerHead = timer->ownerNext;
+        }
+
+        if (timer->ownerNext)
+        {
+            tracker->timers[timer->ownerNext].ownerPrev = timer->ownerPrev;
+        }
+    }
+
+    // Bumping the generation invalidates handles still held to this slot.
+    timer->isPending = false;
+    timer->generation++;
+    timer->next = tracker->freeTimer;
+    tracker->freeTimer = index;
+
+    if (--tracker->timerCount == 0)
+    {
+        smPrivateRefreshCachedCallbacks();
+    }
+}
+
+void smPrivateCascadeTimers(int level)
+{
+    uint32_t slot = level * TIMER_WHEEL_SLOTS +
+                    (uint32_t)(tracker->timerTick >> (TIMER_WHEEL_BITS * level) & TIMER_WHEEL_MASK);
+
+    // Detached first, since a timer a full lap away lands back in this slot.
+    uint32_t index = tracker->timerWheel[slot];
+    tracker->timerWheel[slot] = 0;
+
+    while (index)
+    {
+        uint32_t next = tracker->timers[index].next;
+        smPrivateScheduleTimer(index);
+        index = next;
+    }
+}
+
+void smPrivateAdvanceTimers(float dt)
+{
+    if (!(dt > 0.0f))
+    {
+        return;
+    }
+
+    // The sub-tick remainder carries over, so short frames still add up.
+    float ticks = tracker->timerRemainder + dt * TIMER_TICKS_PER_S;
+    uint64_t elapsed = (uint64_t)ticks;
+    tracker->timerRemainder = ticks - (float)elapsed;
+
+    for (; elapsed > 0; elapsed--)
+    {
+        if (tracker->timerCount == 0)
+        {
+            tracker->timerTick += elapsed;
+            return;
+        }
+
+        uint64_t tick = ++tracker->timerTick;
+
+        // Upper levels cascade first, so their timers can fall all the way down.
+        int level = 1;
+        while (level < TIMER_WHEEL_LEVELS &&
+               (tick & (((uint64_t)1 << (TIMER_WHEEL_BITS * level)) - 1)) == 0)
+        {
+            level++;
+        }
+        for (level--; level >= 1; level--)
+        {
+            smPrivateCascadeTimers(level);
+        }
+
+        // Callbacks may add, cancel, or release timers, so re-read the slot each time.
+        uint32_t slot = (uint32_t)(tick & TIMER_WHEEL_MASK);
+        while (tracker->timerWheel[slot])
+        {
+            uint32_t index = tracker->timerWheel[slot];
+            smInternalTimer *timer = &tracker->timers[index];
+            smTimerFn fn = timer->fn;
+            void *args = timer->args;
+
+            if (timer->intervalTicks)
+            {
+                smPrivateUnscheduleTimer(index);
+                timer->expiresTick += timer->intervalTicks;
+                smPrivateScheduleTimer(index);
+            }
+            else
+            {
+                smPrivateReleaseTimer(index);
+            }
+
+            PF_BEGIN_ZONE("Timer");
+            fn(args);
+            PF_END_ZONE();
+            if (!tracker)
+            {
+                return;
+            }
+        }
+    }
+}
+
+int smPrivateGrowTweenGroup(smInternalTweenGroup *group)
+{
+    size_t capacity = group->capacity ? group->capacity * 2 : TWEEN_INITIAL_CAPACITY;
+
+    // Pointer arrays go first, so every array in the block stays aligned.
+    const size_t POINTERS_SIZE = capacity * (sizeof(float *) + sizeof(smInternalScene *));
+    const size_t FLOATS_SIZE = capacity * 5 * sizeof(float);
+    unsigned char *block = tsMalloc(POINTERS_SIZE + FLOATS_SIZE + capacity * sizeof(uint32_t));
+    if (!block)
+    {
+        lgInternalLog(ERROR, ORI, CSE_MEM_ALLOC_FAIL, __func__, CSQ_ABORT);
+        return RES_MEM_ALLOC_FAIL;
+    }
+
+    smInternalTweenGroup grown = {
+        .targets = (float **)block,
+        .owners = (smInternalScene **)(block + capacity * sizeof(float *)),
+        .from = (float *)(block + POINTERS_SIZE),
+        .handles = (uint32_t *)(block + POINTERS_SIZE + FLOATS_SIZE),
+        .count = group->count,
+        .capacity = capacity,
+        .block = block,
+    };
+    grown.to = grown.from + capacity;
+    grown.elapsed = grown.to + capacity;
+    grown.invDuration = grown.elapsed + capacity;
+    grown.progress = grown.invDuration + capacity;
+
+    if (group->count > 0)
+    {
+        memcpy(grown.targets, group->targets, group->count * sizeof(float *));
+        memcpy(grown.owners, group->owners, group->count * sizeof(smInternalScene *));
+        memcpy(grown.from, group->from, group->count * sizeof(float));
+        memcpy(grown.to, group->to, group->count * sizeof(float));
+        memcpy(grown.elapsed, group->elapsed, group->count * sizeof(float));
+        memcpy(grown.invDuration, group->invDuration, group->count * sizeof(float));
+        memcpy(grown.handles, group->handles, group->count * sizeof(uint32_t));
+    }
+
+    tsFree(group->block);
+    *group = grown;
+    return RES_OK;
+}
+
+int smPrivateGrowTweenSlots(void)
+{
+    // Index 0 is reserved as the free-list terminator, so a fresh table starts at 1.
+    uint32_t first = tracker->tweenSlotCapacity ? tracker->tweenSlotCapacity : 1;
+    uint32_t capacity = tracker->tweenSlotCapacity ? tracker->tweenSlotCapacity * 2
+                                                   : TWEEN_INITIAL_CAPACITY;
+
+    smInternalTweenSlot *slots = tsRealloc(tracker->tweenSlots, capacity * sizeof(smInternalTweenSlot));
+    if (!slots)
+    {
+        lgInternalLog(ERROR, ORI, CSE_MEM_ALLOC_FAIL, __func__, CSQ_ABORT);
+        return RES_MEM_ALLOC_FAIL;
+    }
+
+    memset(&slots[first], 0, (capacity - first) * sizeof(smInternalTweenSlot));
+    for (uint32_t i = first; i < capacity - 1; i++)
+    {
+        slots[i].nextFree = i + 1;
+    }
+    slots[capacity - 1].nextFree = tracker->freeTweenSlot;
+
+    tracker->tweenSlots = slots;
+    tracker->tweenSlotCapacity = capacity;
+    tracker->freeTweenSlot = first;
+    return RES_OK;
+}
+
+void smPrivateRemoveTween(smInternalTweenGroup *group, size_t position)
+{
+    smInternalTweenSlot *slot = &tracker->tweenSlots[group->handles[position]];
+    slot->isRunning = false;
+    slot->generation++;
+    slot->nextFree = tracker->freeTweenSlot;
+    tracker->freeTweenSlot = group->handles[position];
+
+    size_t last = --group->count;
+    if (position != last)
+    {
+        group->targets[position] = group->targets[last];
+        group->owners[position] = group->owners[last];
+        group->from[position] = group->from[last];
+        group->to[position] = group->to[last];
+        group->elapsed[position] = group->elapsed[last];
+        group->invDuration[position] = group->invDuration[last];
+        group->handles[position] = group->handles[last];
+        tracker->tweenSlots[group->handles[position]].position = (uint32_t)position;
+    }
+
+    if (--tracker->tweenCount == 0)
+    {
+        smPrivateRefreshCachedCallbacks();
+    }
+}
+
+void smPrivateStepTweenBatch(void *args, size_t begin, size_t end)
+{
+    const smInternalTweenBatch *BATCH = args;
+    smInternalTweenGroup *group = BATCH->group;
+    const float DT = BATCH->dt;
+    float *restrict elapsed = group->elapsed;
+    const float *restrict invDuration = group->invDuration;
+    float *restrict progress = group->progress;
+
+    for (size_t i = begin; i < end; i++)
+    {
+        elapsed[i] += DT;
+        float t = elapsed[i] * invDuration[i];
+        progress[i] = t < 1.0f ? t : 1.0f;
+    }
+
+    // One loop per curve, so the curve is chosen once per batch, not per tween.
+    switch (BATCH->easing)
+    {
+        case SM_EASE_LINEAR:
+            break;
+        case SM_EASE_IN_QUAD:
+            for (size_t i = begin; i < end; i++)
+            {
+                float t = progress[i];
+                progress[i] = t * t;
+            }
+            break;
+        case SM_EASE_OUT_QUAD:
+            for (size_t i = begin; i < end; i++)
+            {
+                float u = 1.0f - progress[i];
+                progress[i] = 1.0f - u * u;
+            }
+            break;
+        case SM_EASE_IN_OUT_QUAD:
+            for (size_t i = begin; i < end; i++)
+            {
+                /* Mirrors the second half onto the first with arithmetic rather
+                 * than a branch, which keeps the loop vectorizable.
+                 */
+                float t = progress[i];
+                float isSecondHalf = (float)(t >= 0.5f);
+                float s = t + isSecondHalf * (1.0f - 2.0f * t);
+                float eased = 2.0f * s * s;
+                progress[i] = eased + isSecondHalf * (1.0f - 2.0f * eased);
+            }
+            break;
+        case SM_EASE_IN_CUBIC:
+            for (size_t i = begin; i < end; i++)
+            {
+                float t = progress[i];
+                progress[i] = t * t * t;
+            }
+            break;
+        case SM_EASE_OUT_CUBIC:
+            for (size_t i = begin; i < end; i++)
+            {
+                float u = 1.0f - progress[i];
+                progress[i] = 1.0f - u * u * u;
+            }
+            break;
+        case SM_EASE_IN_OUT_CUBIC:
+            for (size_t i = begin; i < end; i++)
+            {
+                float t = progress[i];
+                float isSecondHalf = (float)(t >= 0.5f);
+                float s = t + isSecondHalf * (1.0f - 2.0f * t);
+                float eased = 4.0f * s * s * s;
+                progress[i] = eased + isSecondHalf * (1.0f - 2.0f * eased);
+            }
+            break;
+        case SM_EASE_SMOOTHSTEP:
+            for (size_t i = begin; i < end; i++)
+            {
+                float t = progress[i];
+                progress[i] = t * t * (3.0f - 2.0f * t);
+            }
+            break;
+    }
+
+    // Lerped from both ends, so progress 0 and 1 give from and to exactly.
+    const float *restrict from = group->from;
+    const float *restrict to = group->to;
+    for (size_t i = begin; i < end; i++)
+    {
+        progress[i] = from[i] * (1.0f - progress[i]) + to[i] * progress[i];
+    }
+
+    // Kept apart from the math above, since scattered stores don't vectorize.
+    for (size_t i = begin; i < end; i++)
+    {
+        *group->targets[i] = progress[i];
+    }
+}
+
+void smPrivateStepTweens(smInternalTweenGroup *group, smEasing easing, float dt)
+{
+    const size_t COUNT = group->count;
+    smInternalTweenBatch batch = {.group = group, .easing = easing, .dt = dt};
+    if (COUNT >= TWEEN_PARALLEL_MIN && cmJobsIsRunning())
+    {
+        cmParallelFor(COUNT, TWEEN_PARALLEL_BATCH, smPrivateStepTweenBatch, &batch);
+    }
+    else
+    {
+        smPrivateStepTweenBatch(&batch, 0, COUNT);
+    }
+
+    // Back to front, so entries moved into a freed place were already checked.
+    for (size_t i = COUNT; i-- > 0;)
+    {
+        if (group->elapsed[i] * group->invDuration[i] >= 1.0f)
+        {
+            smPrivateRemoveTween(group, i);
+        }
+    }
+}
+
+void smPrivateAdvanceTweens(float dt)
+{
+    if (tracker->tweenCount == 0 || !(dt > 0.0f))
+    {
+        return;
+    }
+
+    for (int i = 0; i < EASING_COUNT; i++)
+    {
+        if (tracker->tweenGroups[i].count > 0)
+        {
+            smPrivateStepTweens(&tracker->tweenGroups[i], (smEasing)i, dt);
+        }
+    }
+}
+
+void smPrivateRunIdleTasks(int64_t deadlineNs)
+{
+    int64_t nowNs;
+    while (tracker->idleCount > 0 && smInternalGetTime(&nowNs, __func__) == RES_OK &&
+           nowNs < deadlineNs)
+    {
+        /* The task keeps its slot while it runs, so tasks it posts can't take
+         * the room it needs to be re-queued.
+         */
+        smInternalIdleTask *idle = &tracker->idleTasks[tracker->idleHead];
+        bool isDone = !idle->task || idle->task(idle->args);
+
+        // Copied after the call, since the task may have exited its own scene.
+        smInternalIdleTask next = *idle;
+        tracker->idleHead = (tracker->idleHead + 1) % IDLE_QUEUE_CAPACITY;
+        tracker->idleCount--;
+
+        if (!isDone && next.task)
+        {
+            size_t tail = (tracker->idleHead + tracker->idleCount) % IDLE_QUEUE_CAPACITY;
+            tracker->idleTasks[tail] = next;
+            tracker->idleCount++;
+        }
+    }
+}
+
+void smPrivateGovernQuality(int64_t frameCostNs)
+{
+    float costMs = (float)frameCostNs / NS_PER_MS;
+    float budgetMs = tracker->frameBudgetMs > 0.0f
+                         ? tracker->frameBudgetMs
+                         : 1000.0f / tracker->fps;
+
+    if (tracker->frameCostMs == 0.0f)
+    {
+        tracker->frameCostMs = costMs;
+    }
+    else
+    {
+        tracker->frameCostMs += GOVERNOR_SMOOTHING * (costMs - tracker->frameCostMs);
+    }
+
+    /* Lowering quality frees enough time to fall under the lower threshold, so
+     * the gap between the two thresholds keeps the level from flapping.
+     */
+    bool isOver = tracker->frameCostMs > budgetMs * GOVERNOR_LOWER_RATIO;
+    bool isUnder = tracker->frameCostMs < budgetMs * GOVERNOR_RAISE_RATIO;
+    tracker->overBudgetFrames = isOver ? tracker->overBudgetFrames + 1 : 0;
+    tracker->underBudgetFrames = isUnder ? tracker->underBudgetFrames + 1 : 0;
+
+    if (tracker->overBudgetFrames >= GOVERNOR_LOWER_FRAMES && tracker->qualityLevel > SM_QUALITY_LOW)
+    {
+        tracker->qualityLevel--;
+        tracker->overBudgetFrames = 0;
+        lgInternalLog(INFO, ORI, CSE_QUALITY_LOWERED, __func__, CSQ_SUCCESS);
+    }
+    else if (tracker->underBudgetFrames >= GOVERNOR_RAISE_FRAMES && tracker->qualityLevel < SM_QUALITY_FULL)
+    {
+        tracker->qualityLevel++;
+        tracker->underBudgetFrames = 0;
+        lgInternalLog(INFO, ORI, CSE_QUALITY_RAISED, __func__, CSQ_SUCCESS);
+    }
+}
+
+void smPrivateSleepUntil(int64_t deadlineNs)
+{
+#ifdef SMILE_DEV
+    // Tests observe the sleep through the mock clock instead of waiting.
+    if (tracker->clockSource == SM_CLOCK_MONOTONIC)
+    {
+        if (smPrivateToNs(smMockCurrTime) < deadlineNs)
+        {
+            smMockCurrTime.tv_sec = (time_t)(deadlineNs / NS_PER_S);
+            smMockCurrTime.tv_nsec = (long)(deadlineNs % NS_PER_S);
+        }
+        return;
+    }
+#endif
+    int64_t nowNs;
+    if (smInternalGetTime(&nowNs, __func__) == RES_OK)
+    {
+        cmSleepNs(deadlineNs - nowNs);
+    }
+}
+
+bool smPrivateGetClockId(smClockSource source, clockid_t *clockId)
+{
+    switch (source)
+    {
+        case SM_CLOCK_MONOTONIC:
+            *clockId = CLOCK_MONOTONIC;
+            return true;
+#ifdef CLOCK_MONOTONIC_RAW
+        case SM_CLOCK_MONOTONIC_RAW:
+            *clockId = CLOCK_MONOTONIC_RAW;
+            return true;
+#endif
+#ifdef CLOCK_BOOTTIME
+        case SM_CLOCK_BOOTTIME:
+            *clockId = CLOCK_BOOTTIME;
+            return true;
+#endif
+        default:
+            *clockId = CLOCK_MONOTONIC;
+            return false;
+    }
+}
+
+bool smPrivateIsClockSupported(smClockSource source)
+{
+    if (source == SM_CLOCK_TSC)
+    {
+        // Only an invariant TSC ticks at a fixed rate across power states and cores.
+#if defined(SM_HAS_TSC) && defined(_MSC_VER)
+        int registers[4];
+        __cpuid(registers, 0x80000000);
+        if ((unsigned)registers[0] < 0x80000007u)
+        {
+            return false;
+        }
+        __cpuid(registers, 0x80000007);
+        return registers[3] & (1 << 8);
+#elif defined(SM_HAS_TSC)
+        unsigned eax, ebx, ecx, edx;
+        return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8));
+#else
+        return false;
+#endif
+    }
+
+    // The kernel may still lack a clock the headers declare.
+    clockid_t clockId;
+    struct timespec probe;
+    return smPrivateGetClockId(source, &clockId) && clock_gettime(clockId, &probe) == 0;
+}
+
+int smPrivateCalibrateTsc(void)
+{
+#ifdef SM_HAS_TSC
+    struct timespec start, end;
+    if (clock_gettime(CLOCK_MONOTONIC, &start) != 0)
+    {
+        lgInternalLog(ERROR, ORI, CSE_CLOCK_GETTIME_FAILED, __func__, CSQ_ABORT);
+        return RES_CLOCK_GETTIME_FAIL;
+    }
+    uint64_t startTicks = __rdtsc();
+
+    cmSleepNs(TSC_CALIBRATION_NS);
+
+    uint64_t endTicks = __rdtsc();
+    if (clock_gettime(CLOCK_MONOTONIC, &end) != 0)
+    {
+        lgInternalLog(ERROR, ORI, CSE_CLOCK_GETTIME_FAILED, __func__, CSQ_ABORT);
+        return RES_CLOCK_GETTIME_FAIL;
+    }
+
+    int64_t elapsedNs = smPrivateToNs(end) - smPrivateToNs(start);
+    tracker->tscHz = (endTicks - startTicks) * NS_PER_S / (uint64_t)elapsedNs;
+    tracker->tscBase = endTicks;
+    tracker->tscBaseNs = smPrivateToNs(end);
+#endif
+
+    return RES_OK;
+}
+
+int64_t smPrivateToNs(struct timespec time)
+{
+    return (int64_t)time.tv_sec * NS_PER_S + time.tv_nsec;
 }
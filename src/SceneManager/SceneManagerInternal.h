@@ -18,8 +18,14 @@
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 
 // External
+#include <stdalign.h>
+#include <stdint.h>
 #include <time.h>
 #include <uthash.h>
+// Support
+#include "internal/Common/CommonPerf.h"
+#include "internal/Common/CommonThreads.h"
+#include "Metrics.h"
 
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
@@ -27,6 +33,35 @@
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 
 #define DEFAULT_FPS 60
+#define DEFAULT_LOAD_BUDGET_MS 4.0f
+#define IDLE_QUEUE_CAPACITY 64
+#define MESSAGE_QUEUE_CAPACITY 256 // Must be a power of two.
+
+#define TIMER_TICKS_PER_S 1000
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_INITIAL_CAPACITY 64
+
+#define EASING_COUNT (SM_EASE_SMOOTHSTEP + 1)
+#define TWEEN_INITIAL_CAPACITY 64
+#define TWEEN_PARALLEL_MIN 4096 // smaller groups step faster on one thread
+#define TWEEN_PARALLEL_BATCH 1024
+
+#define GOVERNOR_SMOOTHING 0.1f
+#define GOVERNOR_LOWER_RATIO 0.95f
+#define GOVERNOR_RAISE_RATIO 0.7f
+#define GOVERNOR_LOWER_FRAMES 10
+#define GOVERNOR_RAISE_FRAMES 120
+
+#define NS_PER_S 1000000000L
+#define NS_PER_MS 1000000L
+
+#define TSC_CALIBRATION_NS 10000000L
+
+#define DT_MEDIAN_WINDOW 5
+#define DT_SNAP_TOLERANCE 0.1f
 
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
@@ -52,23 +87,60 @@ typedef enum
     RES_NO_UPDATE_FUNC = -105,
     RES_NO_DRAW_FUNC = -106,
     RES_FREE_ALL_SCENES_FAIL = -107,
+    RES_REGISTRY_ALREADY_SET = -108,
+    RES_CANT_DEL_REGISTRY_SCENE = -109,
+    RES_IDLE_QUEUE_FULL = -110,
+    RES_CLOCK_UNSUPPORTED = -111,
+    RES_MESSAGE_QUEUE_FULL = -112,
+    RES_TIMER_NOT_FOUND = -113,
+    RES_TWEEN_NOT_FOUND = -114,
 } smInternalResult;
 
+/**
+ * @brief Hardware counter totals of one scene, allocated the first time one of
+ *        its callbacks is measured.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    smPerfCounters update;
+    smPerfCounters draw;
+} smInternalScenePerf;
+
 /**
  * @brief Represents an individual scene within SceneManager.
  *
  * Each scene includes optional lifecycle functions for handling entry,
- * update, drawing, and exit logic.
+ * update, drawing, and exit logic, plus an optional incremental loader that
+ * replaces enter. Scenes with a suspend callback can be kept
+ * in the suspended-scene cache, an intrusive LRU list ordered from most to
+ * least recently suspended.
  *
  * @author Vitor Betmann
  */
-typedef struct
+typedef struct smInternalScene
 {
-    char *name;
+    const char *name;
     smEnterFn enter;
     smUpdateFn update;
     smDrawFn draw;
     smExitFn exit;
+
+    smLoadFn load;
+    smMessageFn handleMessage;
+
+    smSuspendFn suspend;
+    smResumeFn resume;
+    size_t suspendCost;
+    bool isSuspended;
+    struct smInternalScene *prevSuspended;
+    struct smInternalScene *nextSuspended;
+
+    bool isStatic;
+
+    uint32_t timerHead;
+    smInternalScenePerf *perf;
 } smInternalScene;
 
 /**
@@ -81,27 +153,249 @@ typedef struct
  */
 typedef struct
 {
-    char *name;
+    const char *name;
     smInternalScene *scene;
     UT_hash_handle hh;
 } smInternalSceneMap;
 
+/**
+ * @brief Single allocation backing a table registered with
+ *        `smRegisterScenes()`.
+ *
+ * Scenes and map entries live side by side in `slots`. They are not freed
+ * individually; the whole block is released by `smStop()`.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct smInternalSceneBlock
+{
+    struct smInternalSceneBlock *next;
+    size_t count;
+    struct
+    {
+        smInternalScene scene;
+        smInternalSceneMap entry;
+    } slots[];
+} smInternalSceneBlock;
+
+/**
+ * @brief Task waiting in the idle queue.
+ *
+ * A task whose owner exits has its `task` cleared and is discarded when it
+ * reaches the front of the queue, so queued tasks never move while one runs.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    smIdleFn task;
+    void *args;
+    smInternalScene *owner;
+} smInternalIdleTask;
+
+/**
+ * @brief Running tweens that share an easing curve, stored as parallel arrays.
+ *
+ * Entry `i` of every array describes the same tween. Removing a tween moves the
+ * last entry into its place, so the arrays stay dense and each update is a few
+ * straight loops over them. All arrays live in `block`, a single allocation.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    float **targets;
+    smInternalScene **owners;
+    float *from;
+    float *to;
+    float *elapsed;
+    float *invDuration;
+    float *progress;
+    uint32_t *handles;
+    size_t count;
+    size_t capacity;
+    void *block;
+} smInternalTweenGroup;
+
+/**
+ * @brief Arguments shared by every batch of one group's step.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    smInternalTweenGroup *group;
+    smEasing easing;
+    float dt;
+} smInternalTweenBatch;
+
+/**
+ * @brief Handles of the metrics SceneManager publishes.
+ *
+ * All `0`, which Metrics ignores, unless Metrics was running when SceneManager
+ * started.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    mtMetricId sceneSwitches;
+    mtMetricId frameNs;
+    mtMetricId updateNs;
+    mtMetricId drawNs;
+} smInternalMetrics;
+
+/**
+ * @brief Stable handle slot for a tween, pointing at its entry in a group.
+ *
+ * Index `0` is never used, so it ends the free list, which `nextFree` links.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    uint32_t generation;
+    uint32_t easing;
+    uint32_t position;
+    uint32_t nextFree;
+    bool isRunning;
+} smInternalTweenSlot;
+
+/**
+ * @brief Slot in the message queue.
+ *
+ * `sequence` tells producers and the consumer whose turn the slot is: it equals
+ * the slot's next write position while free, that position plus one once the
+ * message is written, and the next lap's position after it is consumed.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    atomic_size_t sequence;
+    smMessage message;
+} smInternalMessageCell;
+
+/**
+ * @brief Bounded lock-free ring of messages posted to the active scene.
+ *
+ * Lives outside the tracker, since other threads may post while `smStart()` or
+ * `smStop()` runs and must not read a tracker pointer that is being swapped.
+ * Positions only ever grow and wrap through the slot mask. Producer and
+ * consumer positions sit on separate cache lines so posting threads don't
+ * invalidate the line `smUpdate()` reads.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    alignas(CM_CACHE_LINE_SIZE) atomic_bool isOpen;
+    atomic_int mode;
+    alignas(CM_CACHE_LINE_SIZE) atomic_size_t tail;
+    alignas(CM_CACHE_LINE_SIZE) size_t head;
+    smInternalMessageCell cells[MESSAGE_QUEUE_CAPACITY];
+} smInternalMessageQueue;
+
+/**
+ * @brief Timer in the timing-wheel pool.
+ *
+ * Timers refer to each other by pool index rather than by pointer, since the
+ * pool moves when it grows. Index `0` is never used, so it marks the end of a
+ * list. While pending, a timer is linked into one wheel slot, identified by
+ * `slot`, and into its owner's list. While free, `next` links the free list.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    smTimerFn fn;
+    void *args;
+    smInternalScene *owner;
+    uint64_t expiresTick;
+    uint32_t intervalTicks;
+    uint32_t generation;
+    uint32_t slot;
+    uint32_t prev;
+    uint32_t next;
+    uint32_t ownerPrev;
+    uint32_t ownerNext;
+    bool isPending;
+} smInternalTimer;
+
 /**
  * @brief Tracks the current SceneManager context.
  *
  * Contains all runtime information such as registered scenes, the current
- * active scene, frame rate settings, and timing data used for delta time
- * calculations.
+ * active scene, frame rate settings, timing data used for delta time
+ * calculations and filtering, frame pacing with its idle-task ring buffer, the quality
+ * governor, the suspended-scene cache, incremental loading state, the timer
+ * wheel, tweens, and the optional generated scene registry.
  *
  * @author Vitor Betmann
  */
 typedef struct
 {
     smInternalSceneMap *sceneMap;
-    const smInternalScene *currScene;
+    smInternalSceneBlock *sceneBlocks;
+    const smSceneRegistry *registry;
+    smInternalScene *registryScenes;
+    smInternalScene *currScene;
     int sceneCount;
     int fps;
-    struct timespec lastTime;
+    smClockSource clockSource;
+    uint64_t tscHz;
+    uint64_t tscBase;
+    int64_t tscBaseNs;
+    int64_t lastTimeNs;
+
+    smDtFilter dtFilter;
+    float dtHistory[DT_MEDIAN_WINDOW];
+    int dtHistoryCount;
+    int dtHistoryNext;
+    float smoothedDt;
+    float dtResidual;
+    int64_t frameDeadlineNs;
+    int64_t frameStartNs;
+
+    float frameBudgetMs;
+    float frameCostMs;
+    int qualityLevel;
+    int overBudgetFrames;
+    int underBudgetFrames;
+
+    smInternalIdleTask idleTasks[IDLE_QUEUE_CAPACITY];
+    size_t idleHead;
+    size_t idleCount;
+
+    smInternalScene *suspendedHead;
+    smInternalScene *suspendedTail;
+    size_t suspendedCost;
+    size_t suspendBudget;
+
+    smInternalScene *pendingScene;
+    void *pendingArgs;
+    smInternalScene *loadingScene;
+    float loadBudgetMs;
+
+    smInternalTimer *timers;
+    uint32_t timerCapacity;
+    uint32_t freeTimer;
+    size_t timerCount;
+    uint32_t timerWheel[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS];
+    uint64_t timerTick;
+    float timerRemainder;
+
+    smInternalTweenGroup tweenGroups[EASING_COUNT];
+    smInternalTweenSlot *tweenSlots;
+    uint32_t tweenSlotCapacity;
+    uint32_t freeTweenSlot;
+    size_t tweenCount;
+    bool isTweenPoolHeld;
+
+    smInternalMetrics metrics;
+
+    bool isPerfEnabled;
+    cmPerfGroup perf;
 } smInternalTracker;
 
 
@@ -112,13 +406,15 @@ typedef struct
 /**
  * @brief Retrieves a pointer to a scene by name.
  *
+ * Looks in the scene registry first, then in the runtime scene map.
+ *
  * @param name The name of the scene to look up.
  *
  * @return Pointer to the matching scene, or NULL if not found.
  *
  * @author Vitor Betmann
  */
-const smInternalScene *smInternalGetScene(const char *name);
+smInternalScene *smInternalGetScene(const char *name);
 
 /**
  * @brief Retrieves a pointer to a scene-map entry by name.
@@ -131,5 +427,51 @@ const smInternalScene *smInternalGetScene(const char *name);
  */
 smInternalSceneMap *smInternalGetEntry(const char *name);
 
+/**
+ * @brief Retrieves a pointer to a registry scene by name.
+ *
+ * Hashes @p name with seed `0` to pick a bucket, then with the bucket's seed to
+ * get the candidate index, and confirms it with a single string comparison.
+ *
+ * @param name The name of the scene to look up.
+ *
+ * @return Pointer to the matching registry scene, or NULL if no registry is set
+ *         or the name is not in it.
+ *
+ * @author Vitor Betmann
+ */
+smInternalScene *smInternalFindInRegistry(const char *name);
+
+/**
+ * @brief Reads the selected clock source, in nanoseconds.
+ *
+ * With `SMILE_DEV`, `SM_CLOCK_MONOTONIC` reads the mock clock instead, while
+ * every other source still reads the real one.
+ *
+ * @param nowNs Output for the current time.
+ * @param caller Name of the calling function, for logging.
+ *
+ * @return `RES_OK` on success, or `RES_CLOCK_GETTIME_FAIL` if the clock can't
+ *         be read.
+ *
+ * @author Vitor Betmann
+ */
+int smInternalGetTime(int64_t *nowNs, const char *caller);
+
+/**
+ * @brief Converts TSC ticks to nanoseconds.
+ *
+ * Scales the whole seconds and the remainder apart, so no tick count overflows
+ * the multiplication.
+ *
+ * @param ticks Ticks since the TSC anchor.
+ * @param tscHz Calibrated TSC frequency. Must not be zero.
+ *
+ * @return The elapsed nanoseconds, rounded down.
+ *
+ * @author Vitor Betmann
+ */
+uint64_t smInternalTscToNs(uint64_t ticks, uint64_t tscHz);
+
 
 #endif
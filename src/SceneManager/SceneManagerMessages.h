@@ -24,19 +24,37 @@
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 
 // Infos
+#define CSE_SCENES_REGISTERED "Scenes Registered"
+#define CSE_REGISTRY_SET "Registry Set"
 #define CSE_SCENE_CREATED "Scene Created"
 #define CSE_SCENE_SET_TO "Scene Set To"
 #define CSE_SCENE_DELETED "Scene Deleted"
+#define CSE_SCENE_EVICTED "Scene Evicted"
+#define CSE_SCENE_LOADING "Scene Loading"
+#define CSE_SCENE_LOAD_ABANDONED "Scene Load Abandoned"
+#define CSE_QUALITY_LOWERED "Quality Level Lowered"
+#define CSE_QUALITY_RAISED "Quality Level Raised"
 // Warnings
 #define CSE_SCENE_ALREADY_EXISTS "Scene already exists"
+#define CSE_SCENE_REPEATED "Scene repeated in table"
 #define CSE_SCENE_NOT_FOUND "Scene not found"
 #define CSE_NULL_SCENE_UPDATE_FN "Scene Has Null Update"
 #define CSE_NULL_SCENE_DRAW_FN "Scene Has Null Draw"
+#define CSE_IDLE_QUEUE_FULL "Idle Task Queue Is Full"
+#define CSE_MESSAGE_QUEUE_FULL "Message Queue Is Full"
+#define CSE_TIMER_NOT_FOUND "Timer Not Found"
+#define CSE_TWEEN_NOT_FOUND "Tween Not Found"
+#define CSE_PERF_UNAVAILABLE "Performance Counters Unavailable"
+#define CSE_JOBS_UNAVAILABLE "Worker Pool Unavailable"
+#define CSE_PERF_PARTIAL "Some Performance Counters Unavailable"
 // Errors
 #define CSE_NULL_CURR_SCENE "Current Scene Is Null"
 #define CSE_NO_VALID_FUNCTIONS "Scene Has No Valid Functions"
 #define CSE_CANT_DEL_CURR_SCENE "Cannot Delete Current Scene"
+#define CSE_REGISTRY_ALREADY_SET "Registry Already Set"
+#define CSE_CANT_DEL_REGISTRY_SCENE "Cannot Delete Registry Scene"
 #define CSE_CLOCK_GETTIME_FAILED "Clock Gettime Failed"
+#define CSE_CLOCK_UNSUPPORTED "Clock Source Unsupported"
 // Fatals
 #define CSE_FAILED_TO_FREE_ALL_SCENES "Failed to Free All Scenes"
 
@@ -18,6 +18,12 @@ typedef struct
 {
     int enterCount;
     int exitCount;
+    int suspendCount;
+    int resumeCount;
+    int loadCount;
+    int idleCount;
+    int messageCount;
+    int timerCount;
 } MockData;
 
 /**
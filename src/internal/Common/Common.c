@@ -18,9 +18,14 @@
 #include <errno.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #ifdef _WIN32
 #include <direct.h>
+#define NOGDI // wingdi.h defines ERROR, which clashes with the log levels
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
 #else
+#include <dirent.h>
 #include <unistd.h>
 #endif
 #include <sys/stat.h>
@@ -218,3 +223,120 @@ int cmDeleteDir(const char *path)
 
     return RES_OK;
 }
+
+int cmListDir(const char *path, cmListDirFn fn, void *ctx)
+{
+    if (!fn)
+    {
+        return RES_NULL_ARG;
+    }
+
+    int result = cmValidatePath(path);
+    if (result != RES_OK)
+    {
+        return result;
+    }
+
+#ifdef _WIN32
+    char pattern[CM_PATH_MAX];
+    snprintf(pattern, sizeof(pattern), "%s\\*", path);
+
+    WIN32_FIND_DATAA entry;
+    HANDLE dir = FindFirstFileA(pattern, &entry);
+    if (dir == INVALID_HANDLE_VALUE)
+    {
+        return RES_DIR_NOT_FOUND;
+    }
+
+    do
+    {
+        if (strcmp(entry.cFileName, ".") != 0 && strcmp(entry.cFileName, "..") != 0)
+        {
+            fn(entry.cFileName, ctx);
+        }
+    } while (FindNextFileA(dir, &entry));
+    FindClose(dir);
+#else
+    DIR *dir = opendir(path);
+    if (!dir)
+    {
+        return RES_DIR_NOT_FOUND;
+    }
+
+    const struct dirent *entry;
+    while ((entry = readdir(dir)))
+    {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+        {
+            fn(entry->d_name, ctx);
+        }
+    }
+    closedir(dir);
+#endif
+
+    return RES_OK;
+}
+
+// Hashing
+
+uint32_t cmHashString(const char *str, uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ seed * 16777619u;
+    for (const unsigned char *c = (const unsigned char *)str; *c; c++)
+    {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+
+    // Final mix from MurmurHash3, so nearby seeds don't give related hashes.
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+// Time
+
+void cmSleepNs(int64_t ns)
+{
+    if (ns <= 0)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    Sleep((DWORD)(ns / 1000000));
+#else
+    struct timespec remaining = {
+        .tv_sec = (time_t)(ns / 1000000000),
+        .tv_nsec = (long)(ns % 1000000000),
+    };
+    while (nanosleep(&remaining, &remaining) != 0 && errno == EINTR)
+    {
+    }
+#endif
+}
+
+
+int64_t cmGetTimeNs(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    // Split so the multiplication can't overflow for long uptimes.
+    return counter.QuadPart / frequency.QuadPart * 1000000000 +
+           counter.QuadPart % frequency.QuadPart * 1000000000 / frequency.QuadPart;
+#else
+    struct timespec now;
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+    {
+        return 0;
+    }
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
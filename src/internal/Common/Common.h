@@ -10,6 +10,12 @@
 #ifndef SMILE_COMMON_H
 #define SMILE_COMMON_H
 
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <stdint.h>
+
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Defines
 // —————————————————————————————————————————————————————————————————————————————————————————————————
@@ -45,6 +51,8 @@ typedef enum
     RES_CREATE_FILE_FAIL = -12,
     RES_DIR_NOT_FOUND = -13,
     RES_DEL_DIR_FAIL = -14,
+    RES_THREAD_CREATE_FAIL = -15,
+    RES_PERF_UNAVAILABLE = -16,
 } cmResult;
 
 /**
@@ -56,6 +64,16 @@ typedef enum
  */
 typedef bool (*cmIsRunningFn)(void);
 
+/**
+ * @brief Function pointer called by `cmListDir` once per directory entry.
+ *
+ * @param name Name of the entry, without the directory path.
+ * @param ctx  Caller-provided context passed to `cmListDir`.
+ *
+ * @author Vitor Betmann
+ */
+typedef void (*cmListDirFn)(const char *name, void *ctx);
+
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Functions - Internal
@@ -174,5 +192,70 @@ int cmDeleteFile(const char *path);
  */
 int cmDeleteDir(const char *path);
 
+/**
+ * @brief Calls a function for every entry of a directory.
+ *
+ * Entries are visited in the order the filesystem returns them. The `.` and
+ * `..` entries are skipped.
+ *
+ * @param path Relative path of the directory to list.
+ * @param fn   Function called once per entry.
+ * @param ctx  Context forwarded to @p fn.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: @p fn is null (`RES_NULL_ARG`); the path is invalid (see
+ *       `cmValidatePath`); or the directory cannot be opened
+ *       (`RES_DIR_NOT_FOUND`).
+ *
+ * @author Vitor Betmann
+ */
+int cmListDir(const char *path, cmListDirFn fn, void *ctx);
+
+// Hashing
+
+/**
+ * @brief Hashes a null-terminated string with a seed.
+ *
+ * FNV-1a over the bytes of @p str, starting from a seed-dependent basis and
+ * followed by a final avalanche step so that different seeds give
+ * independent-looking results. Used to build and query perfect hash tables,
+ * so the result must stay stable across builds and platforms.
+ *
+ * @param str  String to hash.
+ * @param seed Seed selecting the hash function.
+ *
+ * @return The 32-bit hash of @p str.
+ *
+ * @author Vitor Betmann
+ */
+uint32_t cmHashString(const char *str, uint32_t seed);
+
+// Time
+
+/**
+ * @brief Suspends the calling thread for at least the given duration.
+ *
+ * Sleeps are resumed after signal interruptions. The actual duration depends on
+ * the scheduler; on Windows it is rounded down to whole milliseconds.
+ *
+ * @param ns Duration in nanoseconds. Non-positive values return immediately.
+ *
+ * @author Vitor Betmann
+ */
+void cmSleepNs(int64_t ns);
+
+/**
+ * @brief Reads a monotonic clock in nanoseconds.
+ *
+ * The clock has an unspecified origin and is only meaningful for differences.
+ * Uses `CLOCK_MONOTONIC` on POSIX and `QueryPerformanceCounter` on Windows.
+ *
+ * @return The current time in nanoseconds, or `0` if the clock can't be read.
+ *
+ * @author Vitor Betmann
+ */
+int64_t cmGetTimeNs(void);
+
 
 #endif
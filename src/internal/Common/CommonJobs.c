@@ -0,0 +1,542 @@
+/**
+ * @file
+ * @brief Implementation of the shared work-stealing job system.
+ *
+ * @see CommonJobs.h
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+// Module Related
+#include "Common.h"
+#include "CommonJobs.h"
+#include "CommonThreads.h"
+// Support
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#define DEQUE_MASK (CM_JOBS_DEQUE_CAPACITY - 1)
+#define IDLE_SPINS 64
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+typedef struct
+{
+    cmJobFn fn;
+    void *args;
+    cmJobCounter *counter;
+} cmJob;
+
+// Thieves may read a slot while its owner overwrites it; they discard what they
+// read unless their claim on `top` succeeds, so relaxed atomics are enough.
+typedef struct
+{
+    _Atomic(cmJobFn) fn;
+    _Atomic(void *) args;
+    _Atomic(cmJobCounter *) counter;
+} cmJobSlot;
+
+typedef struct
+{
+    char headPad[CM_CACHE_LINE_SIZE];
+    _Atomic int64_t top;
+    char topPad[CM_CACHE_LINE_SIZE - sizeof(_Atomic int64_t)];
+    _Atomic int64_t bottom;
+    char bottomPad[CM_CACHE_LINE_SIZE - sizeof(_Atomic int64_t)];
+    cmJobSlot slots[CM_JOBS_DEQUE_CAPACITY];
+} cmJobDeque;
+
+typedef struct
+{
+    cmJobRangeFn fn;
+    void *args;
+    size_t count;
+    size_t batchSize;
+    atomic_size_t next;
+} cmJobRange;
+
+typedef struct
+{
+    cmJobDeque *deques; // workerCount + 1; deque 0 belongs to the starting thread
+    cmThread threads[CM_JOBS_MAX_WORKERS];
+    int workerCount;
+    int userCount;
+    atomic_bool isStopping;
+    atomic_int queued;
+    atomic_int sleepers;
+    atomic_int wakeEpoch; // bumped to wake sleepers out of cmWaitOnAddress()
+} cmJobPool;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Variables
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static cmJobPool *pool;
+static thread_local int workerIndex = -1;
+static thread_local uint32_t victimSeed;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Prototypes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static bool cmPrivatePush(cmJobDeque *deque, const cmJob *job);
+
+/* Owner-side pop from the bottom. Returns false if the deque is empty or a
+ * thief claimed its last job first.
+ */
+static bool cmPrivatePop(cmJobDeque *deque, cmJob *job);
+
+// Thief-side steal from the top. Returns false if empty or another thread won.
+static bool cmPrivateSteal(cmJobDeque *deque, cmJob *job);
+
+// Pops from the worker's own deque, then steals starting at a random victim.
+static bool cmPrivateFindJob(int index, cmJob *job);
+
+static void cmPrivateRunJob(const cmJob *job);
+
+static void cmPrivateWakeWorker(void);
+
+/* Thread entry of a spawned worker: runs jobs until the pool stops, sleeping
+ * when there is nothing to steal. args carries the worker's index.
+ */
+static void cmPrivateRunWorker(void *args);
+
+// Claims and runs batches of a cmParallelFor() range until none are left.
+static void cmPrivateRunRange(void *args);
+
+// Stops the workers, joins the first threadCount of them and frees the pool.
+static void cmPrivateDestroyPool(int threadCount);
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Internal
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Start Related
+
+int cmStartJobs(int workerCount)
+{
+    if (workerCount < 0 || workerCount > CM_JOBS_MAX_WORKERS)
+    {
+        return RES_INVALID_ARG;
+    }
+
+    if (pool)
+    {
+        pool->userCount++;
+        return RES_OK;
+    }
+
+    if (workerCount == 0)
+    {
+        workerCount = cmGetProcessorCount() - 1;
+        if (workerCount > CM_JOBS_MAX_WORKERS)
+        {
+            workerCount = CM_JOBS_MAX_WORKERS;
+        }
+    }
+
+    pool = tsCalloc(1, sizeof(cmJobPool));
+    if (!pool)
+    {
+        return RES_MEM_ALLOC_FAIL;
+    }
+
+    pool->deques = tsCalloc((size_t)workerCount + 1, sizeof(cmJobDeque));
+    if (!pool->deques)
+    {
+        tsFree(pool);
+        pool = nullptr;
+        return RES_MEM_ALLOC_FAIL;
+    }
+
+    pool->workerCount = workerCount;
+    pool->userCount = 1;
+
+    workerIndex = 0;
+    for (int i = 0; i < workerCount; i++)
+    {
+        const int RESULT = cmCreateThread(&pool->threads[i], cmPrivateRunWorker,
+                                          (void *)(intptr_t)(i + 1));
+        if (RESULT != RES_OK)
+        {
+            cmPrivateDestroyPool(i);
+            return RESULT;
+        }
+    }
+
+    return RES_OK;
+}
+
+
+bool cmJobsIsRunning(void)
+{
+    return pool;
+}
+
+
+int cmGetJobWorkerCount(void)
+{
+    return pool ? pool->workerCount : 0;
+}
+
+// Job Related
+
+int cmSubmitJob(cmJobFn fn, void *args, cmJobCounter *counter)
+{
+    if (!fn)
+    {
+        return RES_NULL_ARG;
+    }
+
+    if (counter)
+    {
+        atomic_fetch_add_explicit(&counter->pending, 1, memory_order_relaxed);
+    }
+
+    const cmJob JOB = {.fn = fn, .args = args, .counter = counter};
+    if (!pool || workerIndex < 0)
+    {
+        cmPrivateRunJob(&JOB);
+        return RES_OK;
+    }
+
+    // Counted before the push so a worker never sees the job without the count.
+    atomic_fetch_add(&pool->queued, 1);
+    if (!cmPrivatePush(&pool->deques[workerIndex], &JOB))
+    {
+        atomic_fetch_sub(&pool->queued, 1);
+        cmPrivateRunJob(&JOB);
+        return RES_OK;
+    }
+
+    cmPrivateWakeWorker();
+    return RES_OK;
+}
+
+
+int cmWaitJobs(cmJobCounter *counter)
+{
+    if (!counter)
+    {
+        return RES_NULL_ARG;
+    }
+
+    int spins = 0;
+    while (atomic_load_explicit(&counter->pending, memory_order_acquire) > 0)
+    {
+        cmJob job;
+        if (pool && workerIndex >= 0 && cmPrivateFindJob(workerIndex, &job))
+        {
+            cmPrivateRunJob(&job);
+            spins = 0;
+        }
+        else if (++spins < IDLE_SPINS)
+        {
+            cmCpuRelax();
+        }
+        else
+        {
+            cmYieldThread();
+            spins = 0;
+        }
+    }
+
+    return RES_OK;
+}
+
+
+int cmParallelFor(size_t count, size_t batchSize, cmJobRangeFn fn, void *args)
+{
+    if (!fn)
+    {
+        return RES_NULL_ARG;
+    }
+    if (batchSize == 0)
+    {
+        return RES_INVALID_ARG;
+    }
+
+    if (count == 0)
+    {
+        return RES_OK;
+    }
+    if (!pool || count <= batchSize)
+    {
+        fn(args, 0, count);
+        return RES_OK;
+    }
+
+    cmJobRange range = {.fn = fn, .args = args, .count = count, .batchSize = batchSize};
+    atomic_init(&range.next, 0);
+
+    // The caller takes batches too, so one helper fewer than batches suffices.
+    size_t helperCount = (count - 1) / batchSize;
+    if (helperCount > (size_t)pool->workerCount)
+    {
+        helperCount = (size_t)pool->workerCount;
+    }
+
+    cmJobCounter counter = {0};
+    for (size_t i = 0; i < helperCount; i++)
+    {
+        cmSubmitJob(cmPrivateRunRange, &range, &counter);
+    }
+    cmPrivateRunRange(&range);
+
+    return cmWaitJobs(&counter);
+}
+
+// Stop Related
+
+int cmStopJobs(void)
+{
+    if (!pool)
+    {
+        return RES_NOT_RUNNING;
+    }
+
+    if (--pool->userCount > 0)
+    {
+        return RES_OK;
+    }
+
+    cmPrivateDestroyPool(pool->workerCount);
+    return RES_OK;
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Private
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+bool cmPrivatePush(cmJobDeque *deque, const cmJob *job)
+{
+    const int64_t BOTTOM = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    const int64_t TOP = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if (BOTTOM - TOP >= CM_JOBS_DEQUE_CAPACITY)
+    {
+        return false;
+    }
+
+    cmJobSlot *slot = &deque->slots[BOTTOM & DEQUE_MASK];
+    atomic_store_explicit(&slot->fn, job->fn, memory_order_relaxed);
+    atomic_store_explicit(&slot->args, job->args, memory_order_relaxed);
+    atomic_store_explicit(&slot->counter, job->counter, memory_order_relaxed);
+
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, BOTTOM + 1, memory_order_relaxed);
+    return true;
+}
+
+
+bool cmPrivatePop(cmJobDeque *deque, cmJob *job)
+{
+    const int64_t BOTTOM = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, BOTTOM, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > BOTTOM)
+    {
+        atomic_store_explicit(&deque->bottom, BOTTOM + 1, memory_order_relaxed);
+        return false;
+    }
+
+    cmJobSlot *slot = &deque->slots[BOTTOM & DEQUE_MASK];
+    job->fn = atomic_load_explicit(&slot->fn, memory_order_relaxed);
+    job->args = atomic_load_explicit(&slot->args, memory_order_relaxed);
+    job->counter = atomic_load_explicit(&slot->counter, memory_order_relaxed);
+    if (top < BOTTOM)
+    {
+        return true;
+    }
+
+    // Last job: race the thieves for it through `top`.
+    const bool IS_WON = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                                memory_order_seq_cst,
+                                                                memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, BOTTOM + 1, memory_order_relaxed);
+    return IS_WON;
+}
+
+
+bool cmPrivateSteal(cmJobDeque *deque, cmJob *job)
+{
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    const int64_t BOTTOM = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= BOTTOM)
+    {
+        return false;
+    }
+
+    cmJobSlot *slot = &deque->slots[top & DEQUE_MASK];
+    job->fn = atomic_load_explicit(&slot->fn, memory_order_relaxed);
+    job->args = atomic_load_explicit(&slot->args, memory_order_relaxed);
+    job->counter = atomic_load_explicit(&slot->counter, memory_order_relaxed);
+
+    return atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                   memory_order_seq_cst, memory_order_relaxed);
+}
+
+bool cmPrivateFindJob(int index, cmJob *job)
+{
+    if (cmPrivatePop(&pool->deques[index], job))
+    {
+        atomic_fetch_sub(&pool->queued, 1);
+        return true;
+    }
+
+    const int DEQUE_COUNT = pool->workerCount + 1;
+    if (DEQUE_COUNT == 1)
+    {
+        return false;
+    }
+
+    // xorshift32; seeded per thread so workers spread over different victims.
+    if (victimSeed == 0)
+    {
+        victimSeed = 0x9E3779B9u * (uint32_t)(index + 1);
+    }
+    victimSeed ^= victimSeed << 13;
+    victimSeed ^= victimSeed >> 17;
+    victimSeed ^= victimSeed << 5;
+
+    const int START = (int)(victimSeed % (uint32_t)DEQUE_COUNT);
+    for (int i = 0; i < DEQUE_COUNT; i++)
+    {
+        const int VICTIM = (START + i) % DEQUE_COUNT;
+        if (VICTIM != index && cmPrivateSteal(&pool->deques[VICTIM], job))
+        {
+            atomic_fetch_sub(&pool->queued, 1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void cmPrivateRunJob(const cmJob *job)
+{
+    job->fn(job->args);
+    if (job->counter)
+    {
+        atomic_fetch_sub_explicit(&job->counter->pending, 1, memory_order_release);
+    }
+}
+
+
+void cmPrivateWakeWorker(void)
+{
+    // Pairs with the sleeper registering itself before re-checking `queued`.
+    if (atomic_load(&pool->sleepers) == 0)
+    {
+        return;
+    }
+
+    atomic_fetch_add(&pool->wakeEpoch, 1);
+    cmWakeAddress(&pool->wakeEpoch, false);
+}
+
+
+void cmPrivateRunWorker(void *args)
+{
+    const int INDEX = (int)(intptr_t)args;
+    workerIndex = INDEX;
+
+    int spins = 0;
+    while (true)
+    {
+        cmJob job;
+        if (cmPrivateFindJob(INDEX, &job))
+        {
+            cmPrivateRunJob(&job);
+            spins = 0;
+            continue;
+        }
+
+        // Queued jobs are drained before exiting, even when stopping.
+        if (atomic_load(&pool->queued) <= 0 && atomic_load(&pool->isStopping))
+        {
+            return;
+        }
+        if (++spins < IDLE_SPINS)
+        {
+            cmCpuRelax();
+            continue;
+        }
+        spins = 0;
+
+        // The epoch is read before re-checking, so a wake after the check makes
+        // the wait return at once instead of being lost.
+        atomic_fetch_add(&pool->sleepers, 1);
+        const int EPOCH = atomic_load(&pool->wakeEpoch);
+        if (atomic_load(&pool->queued) <= 0 && !atomic_load(&pool->isStopping))
+        {
+            cmWaitOnAddress(&pool->wakeEpoch, EPOCH);
+        }
+        atomic_fetch_sub(&pool->sleepers, 1);
+    }
+}
+
+
+void cmPrivateRunRange(void *args)
+{
+    cmJobRange *range = args;
+    while (true)
+    {
+        const size_t BEGIN = atomic_fetch_add_explicit(&range->next, range->batchSize,
+                                                       memory_order_relaxed);
+        if (BEGIN >= range->count)
+        {
+            return;
+        }
+
+        const size_t REMAINING = range->count - BEGIN;
+        range->fn(range->args, BEGIN,
+                  BEGIN + (REMAINING < range->batchSize ? REMAINING : range->batchSize));
+    }
+}
+
+
+void cmPrivateDestroyPool(int threadCount)
+{
+    atomic_store(&pool->isStopping, true);
+    atomic_fetch_add(&pool->wakeEpoch, 1);
+    cmWakeAddress(&pool->wakeEpoch, true);
+    for (int i = 0; i < threadCount; i++)
+    {
+        cmJoinThread(&pool->threads[i]);
+    }
+
+    // Without workers nobody else drains the starting thread's deque.
+    cmJob job;
+    while (cmPrivatePop(&pool->deques[0], &job))
+    {
+        cmPrivateRunJob(&job);
+    }
+
+    workerIndex = -1;
+    tsFree(pool->deques);
+    tsFree(pool);
+    pool = nullptr;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file
+ * @brief Internal declarations of the shared work-stealing job system.
+ *
+ * One pool of worker threads is shared by every Smile module that needs to
+ * spread work across cores. Each worker owns a Chase-Lev deque: it pushes and
+ * pops jobs at the bottom, while idle workers steal from the top of the others.
+ *
+ * @author Vitor Betmann
+ */
+
+
+#ifndef SMILE_COMMON_JOBS_H
+#define SMILE_COMMON_JOBS_H
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#define CM_JOBS_MAX_WORKERS 63
+#define CM_JOBS_DEQUE_CAPACITY 1024
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Function pointer run by a worker for each submitted job.
+ *
+ * @param args Caller-provided context passed to `cmSubmitJob`.
+ *
+ * @author Vitor Betmann
+ */
+typedef void (*cmJobFn)(void *args);
+
+/**
+ * @brief Function pointer run by `cmParallelFor` for each batch of indices.
+ *
+ * @param args  Caller-provided context passed to `cmParallelFor`.
+ * @param begin First index of the batch.
+ * @param end   One past the last index of the batch.
+ *
+ * @author Vitor Betmann
+ */
+typedef void (*cmJobRangeFn)(void *args, size_t begin, size_t end);
+
+/**
+ * @brief Counts the jobs submitted against it that have not finished yet.
+ *
+ * Zero-initialise a counter, pass it to every job it should track, then wait on
+ * it with `cmWaitJobs`. A job may itself wait on a counter, which is how job
+ * dependencies are expressed.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    atomic_int pending;
+} cmJobCounter;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Internal
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Start Related
+
+/**
+ * @brief Starts the shared worker pool, or adds a user to an already running
+ *        one.
+ *
+ * The pool is reference counted so every module can start and stop it
+ * independently; only the first start spawns threads. The thread that first
+ * starts the pool joins it as worker `0` and runs jobs while it waits.
+ *
+ * @param workerCount Threads to spawn, or `0` for one less than the number of
+ *                    online processors. Ignored if the pool is already running.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: @p workerCount is negative or above `CM_JOBS_MAX_WORKERS`
+ *       (`RES_INVALID_ARG`); memory allocation fails (`RES_MEM_ALLOC_FAIL`); or
+ *       a worker thread cannot be created (`RES_THREAD_CREATE_FAIL`).
+ *
+ * @author Vitor Betmann
+ */
+int cmStartJobs(int workerCount);
+
+/**
+ * @brief Checks whether the shared worker pool is running.
+ *
+ * @return `true` if the pool is running, `false` otherwise.
+ *
+ * @author Vitor Betmann
+ */
+bool cmJobsIsRunning(void);
+
+/**
+ * @brief Returns the number of spawned worker threads.
+ *
+ * @return The spawned worker count, or `0` if the pool is not running.
+ *
+ * @author Vitor Betmann
+ */
+int cmGetJobWorkerCount(void);
+
+// Job Related
+
+/**
+ * @brief Queues a job on the calling worker's deque.
+ *
+ * @param fn      Function to run.
+ * @param args    Context forwarded to @p fn.
+ * @param counter Optional counter incremented now and decremented once @p fn
+ *                returns.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: @p fn is null (`RES_NULL_ARG`).
+ * @note Runs @p fn inline when the pool is not running, when the caller is not
+ *       one of the pool's threads, or when the caller's deque is full.
+ *
+ * @author Vitor Betmann
+ */
+int cmSubmitJob(cmJobFn fn, void *args, cmJobCounter *counter);
+
+/**
+ * @brief Runs queued jobs on the calling thread until a counter reaches zero.
+ *
+ * @param counter Counter to wait on.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: @p counter is null (`RES_NULL_ARG`).
+ *
+ * @author Vitor Betmann
+ */
+int cmWaitJobs(cmJobCounter *counter);
+
+/**
+ * @brief Splits `[0, count)` into batches and runs them across the pool.
+ *
+ * Workers claim batches from a shared cursor, so uneven batches balance
+ * themselves. Returns once every batch has run.
+ *
+ * @param count     Number of indices.
+ * @param batchSize Indices handed to @p fn per call.
+ * @param fn        Function run for each batch.
+ * @param args      Context forwarded to @p fn.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: @p fn is null (`RES_NULL_ARG`); or @p batchSize is zero
+ *       (`RES_INVALID_ARG`).
+ * @note Runs every batch inline when the pool is not running.
+ *
+ * @author Vitor Betmann
+ */
+int cmParallelFor(size_t count, size_t batchSize, cmJobRangeFn fn, void *args);
+
+// Stop Related
+
+/**
+ * @brief Removes a user from the shared worker pool, joining the workers once
+ *        the last user stops.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: the pool is not running (`RES_NOT_RUNNING`).
+ * @note Jobs still queued when the last user stops are run before the workers
+ *       exit.
+ *
+ * @author Vitor Betmann
+ */
+int cmStopJobs(void);
+
+
+#endif
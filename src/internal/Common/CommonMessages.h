@@ -23,6 +23,7 @@
 #define CSE_DIR_DELETE "Directory Deleted"
 // Warnings
 #define CSE_ALREADY_RUNNING  "Module Already Running"
+#define CSE_MEMORY_LEAKED "Memory Leaked"
 // Errors
 #define CSE_MEM_ALLOC_FAIL  "Memory Allocation Failed"
 #define CSE_NOT_RUNNING  "Module Not Running"
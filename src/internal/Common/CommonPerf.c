@@ -0,0 +1,166 @@
+/**
+ * @file
+ * @brief Implementation of the hardware performance counter layer.
+ *
+ * @see CommonPerf.h
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+// Module Related
+#include "Common.h"
+#include "CommonPerf.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Variables
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef __linux__
+// The generic hardware events behind each cmPerfCounter.
+static const uint64_t PERF_EVENTS[CM_PERF_COUNTER_COUNT] = {
+    [CM_PERF_CYCLES] = PERF_COUNT_HW_CPU_CYCLES,
+    [CM_PERF_INSTRUCTIONS] = PERF_COUNT_HW_INSTRUCTIONS,
+    [CM_PERF_CACHE_MISSES] = PERF_COUNT_HW_CACHE_MISSES,
+    [CM_PERF_BRANCH_MISSES] = PERF_COUNT_HW_BRANCH_MISSES,
+};
+#endif
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Internal
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int cmOpenPerfGroup(cmPerfGroup *group)
+{
+    if (!group)
+    {
+        return RES_NULL_ARG;
+    }
+
+    group->leaderFd = -1;
+    group->openCount = 0;
+    for (int i = 0; i < CM_PERF_COUNTER_COUNT; i++)
+    {
+        group->fds[i] = -1;
+        group->slots[i] = -1;
+    }
+
+#ifdef __linux__
+    for (int i = 0; i < CM_PERF_COUNTER_COUNT; i++)
+    {
+        struct perf_event_attr attr = {
+            .type = PERF_TYPE_HARDWARE,
+            .size = sizeof(attr),
+            .config = PERF_EVENTS[i],
+            .read_format = PERF_FORMAT_GROUP,
+            .disabled = group->leaderFd == -1, // the leader starts the whole group
+            .exclude_kernel = 1,
+            .exclude_hv = 1,
+        };
+
+        // A counter the CPU lacks, or can't fit next to the others, is left out.
+        const int FD = (int)syscall(SYS_perf_event_open, &attr, 0, -1, group->leaderFd, 0);
+        if (FD < 0)
+        {
+            continue;
+        }
+
+        if (group->leaderFd == -1)
+        {
+            group->leaderFd = FD;
+        }
+        group->fds[i] = FD;
+        group->slots[i] = group->openCount++;
+    }
+
+    if (group->leaderFd == -1)
+    {
+        return RES_PERF_UNAVAILABLE;
+    }
+
+    ioctl(group->leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group->leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return RES_OK;
+#else
+    return RES_PERF_UNAVAILABLE;
+#endif
+}
+
+
+bool cmIsPerfCounterOpen(const cmPerfGroup *group, cmPerfCounter counter)
+{
+    return group && counter >= 0 && counter < CM_PERF_COUNTER_COUNT && group->fds[counter] != -1;
+}
+
+
+bool cmReadPerfGroup(const cmPerfGroup *group, uint64_t values[CM_PERF_COUNTER_COUNT])
+{
+#ifdef __linux__
+    if (group->leaderFd == -1)
+    {
+        return false;
+    }
+
+    // A group read returns the number of counters, then each value in open order.
+    uint64_t buffer[1 + CM_PERF_COUNTER_COUNT];
+    const ssize_t SIZE = read(group->leaderFd, buffer, sizeof(buffer));
+    if (SIZE < (ssize_t)((1 + group->openCount) * sizeof(uint64_t)))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < CM_PERF_COUNTER_COUNT; i++)
+    {
+        values[i] = group->slots[i] == -1 ? 0 : buffer[1 + group->slots[i]];
+    }
+    return true;
+#else
+    (void)group;
+    (void)values;
+    return false;
+#endif
+}
+
+
+void cmClosePerfGroup(cmPerfGroup *group)
+{
+#ifdef __linux__
+    if (group->leaderFd != -1)
+    {
+        ioctl(group->leaderFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    // Members first, so the leader is the last of the group to go.
+    for (int i = CM_PERF_COUNTER_COUNT - 1; i >= 0; i--)
+    {
+        if (group->fds[i] != -1 && group->fds[i] != group->leaderFd)
+        {
+            close(group->fds[i]);
+        }
+    }
+    if (group->leaderFd != -1)
+    {
+        close(group->leaderFd);
+    }
+#endif
+    group->leaderFd = -1;
+    group->openCount = 0;
+    for (int i = 0; i < CM_PERF_COUNTER_COUNT; i++)
+    {
+        group->fds[i] = -1;
+        group->slots[i] = -1;
+    }
+}
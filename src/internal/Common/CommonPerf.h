@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @brief Internal declarations of the hardware performance counter layer.
+ *
+ * Opens the CPU's cycle, instruction, cache-miss and branch-miss counters for
+ * the calling thread through Linux's `perf_event_open`, as one group read by a
+ * single syscall. Elsewhere, or when the kernel refuses, opening reports
+ * `RES_PERF_UNAVAILABLE` and callers carry on without counters.
+ *
+ * @author Vitor Betmann
+ */
+
+
+#ifndef SMILE_COMMON_PERF_H
+#define SMILE_COMMON_PERF_H
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <stdint.h>
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Counters a `cmPerfGroup` tries to open, in read order.
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    CM_PERF_CYCLES,
+    CM_PERF_INSTRUCTIONS,
+    CM_PERF_CACHE_MISSES,
+    CM_PERF_BRANCH_MISSES,
+    CM_PERF_COUNTER_COUNT,
+} cmPerfCounter;
+
+/**
+ * @brief Counters opened together for the calling thread.
+ *
+ * Counters the kernel or CPU does not offer are left out of the group, and
+ * read as `0`.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    int leaderFd;                     // `-1` while closed
+    int fds[CM_PERF_COUNTER_COUNT];   // `-1` for counters left out
+    int slots[CM_PERF_COUNTER_COUNT]; // position of each counter in a group read
+    int openCount;
+} cmPerfGroup;
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Internal
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Opens and starts every available counter for the calling thread.
+ *
+ * Counts user-space work only, which unprivileged processes may measure under
+ * the default `perf_event_paranoid` setting.
+ *
+ * @param group Group to open. Closed again, even on failure, by
+ *              `cmClosePerfGroup`.
+ *
+ * @return `RES_OK` if at least one counter opened, or a negative error code.
+ *
+ * @note Fails if: @p group is null (`RES_NULL_ARG`); or no counter can be
+ *       opened, including on platforms other than Linux
+ *       (`RES_PERF_UNAVAILABLE`).
+ *
+ * @author Vitor Betmann
+ */
+int cmOpenPerfGroup(cmPerfGroup *group);
+
+/**
+ * @brief Checks whether one counter made it into an open group.
+ *
+ * @param group Group filled by `cmOpenPerfGroup`.
+ * @param counter Counter to check.
+ *
+ * @return `true` if the counter is being counted, `false` otherwise.
+ *
+ * @author Vitor Betmann
+ */
+bool cmIsPerfCounterOpen(const cmPerfGroup *group, cmPerfCounter counter);
+
+/**
+ * @brief Reads every counter of the group at once.
+ *
+ * Must be called on the thread that opened the group, since only that
+ * thread's work is counted.
+ *
+ * @param group Group filled by `cmOpenPerfGroup`.
+ * @param values Receives the running total of each counter, indexed by
+ *               `cmPerfCounter`. Counters left out read as `0`.
+ *
+ * @return `true` on success, `false` if the group is closed or the read fails.
+ *
+ * @author Vitor Betmann
+ */
+bool cmReadPerfGroup(const cmPerfGroup *group, uint64_t values[CM_PERF_COUNTER_COUNT]);
+
+/**
+ * @brief Stops and closes every counter of the group.
+ *
+ * @param group Group to close. Closing a closed group does nothing.
+ *
+ * @author Vitor Betmann
+ */
+void cmClosePerfGroup(cmPerfGroup *group);
+
+
+#endif
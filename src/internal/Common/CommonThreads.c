@@ -0,0 +1,309 @@
+/**
+ * @file
+ * @brief Implementation of the portable threading layer.
+ *
+ * @see CommonThreads.h
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <stdint.h>
+#ifdef _WIN32
+#define NOGDI // wingdi.h defines ERROR, which clashes with the log levels
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+// Module Related
+#include "Common.h"
+#include "CommonThreads.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#if !defined(_WIN32) && !defined(__linux__)
+#define CM_PARKING_BUCKETS 64
+#endif
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Variables
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef CM_PARKING_BUCKETS
+// Sleepers of the address-wait fallback, spread over buckets by address.
+static struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} parkingLot[CM_PARKING_BUCKETS];
+static pthread_once_t parkingLotOnce = PTHREAD_ONCE_INIT;
+#endif
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Prototypes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef _WIN32
+static DWORD WINAPI cmPrivateThreadMain(LPVOID args);
+#else
+static void *cmPrivateThreadMain(void *args);
+#endif
+
+#ifdef CM_PARKING_BUCKETS
+static void cmPrivateInitParkingLot(void);
+
+static size_t cmPrivateGetParkingBucket(const atomic_int *address);
+#endif
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Internal
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Processor Related
+
+void cmYieldThread(void)
+{
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+
+int cmGetProcessorCount(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const long COUNT = (long)info.dwNumberOfProcessors;
+#else
+    const long COUNT = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return COUNT > 1 ? (int)COUNT : 1;
+}
+
+// Thread Related
+
+int cmCreateThread(cmThread *thread, cmThreadFn fn, void *args)
+{
+    if (!thread || !fn)
+    {
+        return RES_NULL_ARG;
+    }
+
+    thread->fn = fn;
+    thread->args = args;
+#ifdef _WIN32
+    thread->handle = CreateThread(nullptr, 0, cmPrivateThreadMain, thread, 0, nullptr);
+    return thread->handle ? RES_OK : RES_THREAD_CREATE_FAIL;
+#else
+    return pthread_create(&thread->handle, nullptr, cmPrivateThreadMain, thread) == 0
+               ? RES_OK
+               : RES_THREAD_CREATE_FAIL;
+#endif
+}
+
+
+void cmJoinThread(cmThread *thread)
+{
+#ifdef _WIN32
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, nullptr);
+#endif
+}
+
+// Mutex Related
+
+void cmInitMutex(cmMutex *mutex)
+{
+#ifdef _WIN32
+    InitializeSRWLock((PSRWLOCK)&mutex->lock);
+#else
+    pthread_mutex_init(&mutex->lock, nullptr);
+#endif
+}
+
+
+void cmLockMutex(cmMutex *mutex)
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive((PSRWLOCK)&mutex->lock);
+#else
+    pthread_mutex_lock(&mutex->lock);
+#endif
+}
+
+
+void cmUnlockMutex(cmMutex *mutex)
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive((PSRWLOCK)&mutex->lock);
+#else
+    pthread_mutex_unlock(&mutex->lock);
+#endif
+}
+
+
+void cmDestroyMutex(cmMutex *mutex)
+{
+#ifndef _WIN32
+    pthread_mutex_destroy(&mutex->lock);
+#endif
+}
+
+// Condition Related
+
+void cmInitCond(cmCond *cond)
+{
+#ifdef _WIN32
+    InitializeConditionVariable((PCONDITION_VARIABLE)&cond->cond);
+#else
+    pthread_cond_init(&cond->cond, nullptr);
+#endif
+}
+
+
+void cmWaitCond(cmCond *cond, cmMutex *mutex)
+{
+#ifdef _WIN32
+    SleepConditionVariableSRW((PCONDITION_VARIABLE)&cond->cond, (PSRWLOCK)&mutex->lock,
+                              INFINITE, 0);
+#else
+    pthread_cond_wait(&cond->cond, &mutex->lock);
+#endif
+}
+
+
+void cmSignalCond(cmCond *cond)
+{
+#ifdef _WIN32
+    WakeConditionVariable((PCONDITION_VARIABLE)&cond->cond);
+#else
+    pthread_cond_signal(&cond->cond);
+#endif
+}
+
+
+void cmBroadcastCond(cmCond *cond)
+{
+#ifdef _WIN32
+    WakeAllConditionVariable((PCONDITION_VARIABLE)&cond->cond);
+#else
+    pthread_cond_broadcast(&cond->cond);
+#endif
+}
+
+
+void cmDestroyCond(cmCond *cond)
+{
+#ifndef _WIN32
+    pthread_cond_destroy(&cond->cond);
+#endif
+}
+
+// Address Waits
+
+void cmWaitOnAddress(atomic_int *address, int expected)
+{
+#if defined(_WIN32)
+    WaitOnAddress((volatile VOID *)address, &expected, sizeof(expected), INFINITE);
+#elif defined(__linux__)
+    syscall(SYS_futex, (int *)address, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    pthread_once(&parkingLotOnce, cmPrivateInitParkingLot);
+    const size_t BUCKET = cmPrivateGetParkingBucket(address);
+    pthread_mutex_lock(&parkingLot[BUCKET].lock);
+    if (atomic_load(address) == expected)
+    {
+        pthread_cond_wait(&parkingLot[BUCKET].cond, &parkingLot[BUCKET].lock);
+    }
+    pthread_mutex_unlock(&parkingLot[BUCKET].lock);
+#endif
+}
+
+
+void cmWakeAddress(atomic_int *address, bool wakeAll)
+{
+#if defined(_WIN32)
+    if (wakeAll)
+    {
+        WakeByAddressAll((PVOID)address);
+    }
+    else
+    {
+        WakeByAddressSingle((PVOID)address);
+    }
+#elif defined(__linux__)
+    syscall(SYS_futex, (int *)address, FUTEX_WAKE_PRIVATE, wakeAll ? INT32_MAX : 1, nullptr,
+            nullptr, 0);
+#else
+    // Buckets are shared between addresses, so waking one sleeper could pick
+    // the wrong one.
+    (void)wakeAll;
+    pthread_once(&parkingLotOnce, cmPrivateInitParkingLot);
+    const size_t BUCKET = cmPrivateGetParkingBucket(address);
+    pthread_mutex_lock(&parkingLot[BUCKET].lock);
+    pthread_cond_broadcast(&parkingLot[BUCKET].cond);
+    pthread_mutex_unlock(&parkingLot[BUCKET].lock);
+#endif
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Private
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef _WIN32
+DWORD WINAPI cmPrivateThreadMain(LPVOID args)
+{
+    cmThread *thread = args;
+    thread->fn(thread->args);
+    return 0;
+}
+#else
+void *cmPrivateThreadMain(void *args)
+{
+    cmThread *thread = args;
+    thread->fn(thread->args);
+    return nullptr;
+}
+#endif
+
+
+#ifdef CM_PARKING_BUCKETS
+void cmPrivateInitParkingLot(void)
+{
+    for (size_t i = 0; i < CM_PARKING_BUCKETS; i++)
+    {
+        pthread_mutex_init(&parkingLot[i].lock, nullptr);
+        pthread_cond_init(&parkingLot[i].cond, nullptr);
+    }
+}
+
+
+size_t cmPrivateGetParkingBucket(const atomic_int *address)
+{
+    // Drops the low bits, which are equal for every aligned int.
+    return ((uintptr_t)address >> 2) % CM_PARKING_BUCKETS;
+}
+#endif
@@ -0,0 +1,300 @@
+/**
+ * @file
+ * @brief Internal declarations of the portable threading layer.
+ *
+ * Wraps the platform's threads, mutexes, condition variables and address waits
+ * behind one interface, so modules that need them don't carry their own
+ * `#ifdef` branches. Atomics are plain C11 `<stdatomic.h>`, which this header
+ * includes together with shorthands for the orderings lock-free code uses most.
+ *
+ * @author Vitor Betmann
+ */
+
+
+#ifndef SMILE_COMMON_THREADS_H
+#define SMILE_COMMON_THREADS_H
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Apple's arm64 cores fetch lines in pairs, so pad to 128 bytes there.
+#if defined(__APPLE__) && defined(__aarch64__)
+#define CM_CACHE_LINE_SIZE 128
+#else
+#define CM_CACHE_LINE_SIZE 64
+#endif
+
+#define CM_LOAD_RELAXED(ptr) atomic_load_explicit((ptr), memory_order_relaxed)
+#define CM_LOAD_ACQUIRE(ptr) atomic_load_explicit((ptr), memory_order_acquire)
+#define CM_STORE_RELAXED(ptr, value) atomic_store_explicit((ptr), (value), memory_order_relaxed)
+#define CM_STORE_RELEASE(ptr, value) atomic_store_explicit((ptr), (value), memory_order_release)
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Function pointer run on a thread created with `cmCreateThread`.
+ *
+ * @param args Caller-provided context passed to `cmCreateThread`.
+ *
+ * @author Vitor Betmann
+ */
+typedef void (*cmThreadFn)(void *args);
+
+/**
+ * @brief Handle to a thread created with `cmCreateThread`.
+ *
+ * Must stay at the same address until `cmJoinThread` returns, since the new
+ * thread reads its function and arguments from it.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+#ifdef _WIN32
+    void *handle;
+#else
+    pthread_t handle;
+#endif
+    cmThreadFn fn;
+    void *args;
+} cmThread;
+
+/**
+ * @brief Non-recursive mutex.
+ *
+ * @note On Windows this is an `SRWLOCK`, kept opaque so that `windows.h` stays
+ *       out of Smile's headers.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+#ifdef _WIN32
+    void *lock;
+#else
+    pthread_mutex_t lock;
+#endif
+} cmMutex;
+
+/**
+ * @brief Condition variable paired with a `cmMutex`.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+#ifdef _WIN32
+    void *cond;
+#else
+    pthread_cond_t cond;
+#endif
+} cmCond;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Internal
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Processor Related
+
+/**
+ * @brief Hints the processor that the calling thread is spin-waiting.
+ *
+ * Lowers the cost of a spin loop on the sibling hyper-thread and on power. Does
+ * not give up the time slice; see `cmYieldThread` for that.
+ *
+ * @author Vitor Betmann
+ */
+static inline void cmCpuRelax(void)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * @brief Gives up the rest of the calling thread's time slice.
+ *
+ * @author Vitor Betmann
+ */
+void cmYieldThread(void);
+
+/**
+ * @brief Returns the number of online processors.
+ *
+ * @return The processor count, at least `1`.
+ *
+ * @author Vitor Betmann
+ */
+int cmGetProcessorCount(void);
+
+// Thread Related
+
+/**
+ * @brief Starts a thread running a function.
+ *
+ * @param thread Receives the handle. Must outlive the thread (see `cmThread`).
+ * @param fn     Function to run.
+ * @param args   Context forwarded to @p fn.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: @p thread or @p fn is null (`RES_NULL_ARG`); or the thread
+ *       cannot be created (`RES_THREAD_CREATE_FAIL`).
+ *
+ * @author Vitor Betmann
+ */
+int cmCreateThread(cmThread *thread, cmThreadFn fn, void *args);
+
+/**
+ * @brief Waits for a thread to return and releases its handle.
+ *
+ * @param thread Handle filled by `cmCreateThread`.
+ *
+ * @author Vitor Betmann
+ */
+void cmJoinThread(cmThread *thread);
+
+// Mutex Related
+
+/**
+ * @brief Initialises a mutex.
+ *
+ * @param mutex Mutex to initialise.
+ *
+ * @author Vitor Betmann
+ */
+void cmInitMutex(cmMutex *mutex);
+
+/**
+ * @brief Blocks until the calling thread holds a mutex.
+ *
+ * @param mutex Mutex to lock.
+ *
+ * @author Vitor Betmann
+ */
+void cmLockMutex(cmMutex *mutex);
+
+/**
+ * @brief Releases a mutex held by the calling thread.
+ *
+ * @param mutex Mutex to unlock.
+ *
+ * @author Vitor Betmann
+ */
+void cmUnlockMutex(cmMutex *mutex);
+
+/**
+ * @brief Releases the resources of an unlocked mutex.
+ *
+ * @param mutex Mutex to destroy.
+ *
+ * @author Vitor Betmann
+ */
+void cmDestroyMutex(cmMutex *mutex);
+
+// Condition Related
+
+/**
+ * @brief Initialises a condition variable.
+ *
+ * @param cond Condition variable to initialise.
+ *
+ * @author Vitor Betmann
+ */
+void cmInitCond(cmCond *cond);
+
+/**
+ * @brief Atomically releases a mutex and sleeps until woken, then re-locks it.
+ *
+ * @param cond  Condition variable to sleep on.
+ * @param mutex Mutex held by the calling thread.
+ *
+ * @note May return spuriously, so call it in a loop that re-checks the
+ *       condition.
+ *
+ * @author Vitor Betmann
+ */
+void cmWaitCond(cmCond *cond, cmMutex *mutex);
+
+/**
+ * @brief Wakes one thread sleeping on a condition variable, if any.
+ *
+ * @param cond Condition variable to signal.
+ *
+ * @author Vitor Betmann
+ */
+void cmSignalCond(cmCond *cond);
+
+/**
+ * @brief Wakes every thread sleeping on a condition variable.
+ *
+ * @param cond Condition variable to broadcast.
+ *
+ * @author Vitor Betmann
+ */
+void cmBroadcastCond(cmCond *cond);
+
+/**
+ * @brief Releases the resources of a condition variable nobody sleeps on.
+ *
+ * @param cond Condition variable to destroy.
+ *
+ * @author Vitor Betmann
+ */
+void cmDestroyCond(cmCond *cond);
+
+// Address Waits
+
+/**
+ * @brief Sleeps while an atomic integer still holds an expected value.
+ *
+ * Futex-style wait: a thread that changes @p address and then calls
+ * `cmWakeAddress` cannot be missed, since the value is re-checked atomically
+ * with going to sleep.
+ *
+ * @param address  Integer to watch.
+ * @param expected Value to sleep on.
+ *
+ * @note Uses `futex` on Linux and `WaitOnAddress` on Windows. Elsewhere it falls
+ *       back to a mutex and condition variable picked by hashing @p address.
+ * @note May return spuriously, so call it in a loop that re-checks the value.
+ *
+ * @author Vitor Betmann
+ */
+void cmWaitOnAddress(atomic_int *address, int expected);
+
+/**
+ * @brief Wakes threads sleeping in `cmWaitOnAddress` on an address.
+ *
+ * @param address Integer the threads are watching.
+ * @param wakeAll `true` to wake every sleeper, `false` to wake one.
+ *
+ * @author Vitor Betmann
+ */
+void cmWakeAddress(atomic_int *address, bool wakeAll);
+
+
+#endif
@@ -12,8 +12,11 @@
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 
 // External
+#include <stdalign.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #ifdef _WIN32
 #include <direct.h>
 #include <io.h>
@@ -23,6 +26,86 @@
 #endif
 // Module Related
 #include "Test.h"
+// Support
+#include "internal/Common/Common.h"
+#include "internal/Common/CommonThreads.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#define ALLOC_CANARY_LIVE 0x5AFEB10C5AFEB10CULL
+#define ALLOC_CANARY_FREED 0xDEADF7EEDEADF7EEULL
+#define ALLOC_CANARY_TAIL 0x7A117A117A117A11ULL
+#define ALLOC_MODULES_MAX 32
+#define ALLOC_MODULE_NAME_SIZE 32
+#define ALLOC_QUARANTINE_SIZE 256 // freed blocks held back so a second free still finds the canary
+#define NO_ALLOC_REPORTS_MAX 16 // lines written per region, so a loop that allocates can't flood stderr
+
+#define TEST_LIST_ENV "SMILE_TEST_LIST"
+#define TEST_ONLY_ENV "SMILE_TEST_ONLY"
+
+#define BENCH_RESULTS_MAX 256
+#define BENCH_NAME_SIZE 96
+#define BENCH_SAMPLES 200
+#define BENCH_MIN_SAMPLES 100 // below 100 samples, the p99 by nearest rank is just the slowest
+#define BENCH_BATCH_NS 1000000LL // 1 ms, long enough that reading the clock is noise
+#define BENCH_WARMUP_NS 50000000LL // 50 ms
+#define BENCH_MAX_NS 2000000000LL // 2 s of samples, so slow benchmarks still finish
+#define BENCH_GROWTH_MAX 10
+
+// Keeps the memory after the header aligned for any type.
+#define ALLOC_HEADER_SIZE                                                                          \
+    ((sizeof(tsInternalBlock) + alignof(max_align_t) - 1) / alignof(max_align_t) *                 \
+     alignof(max_align_t))
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Header placed in front of every block under SMILE_DEBUG_ALLOC.
+ *
+ * A second canary follows the block itself, so writes past its end are found
+ * when it is freed.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct tsInternalBlock
+{
+    uint64_t canary;
+    struct tsInternalBlock *prev;
+    struct tsInternalBlock *next;
+    const char *file;
+    int line;
+    int module;
+    size_t size;
+} tsInternalBlock;
+
+/**
+ * @brief Allocation totals of the files in one directory.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    char name[ALLOC_MODULE_NAME_SIZE];
+    tsAllocStats stats;
+} tsInternalModule;
+
+/**
+ * @brief A benchmark result kept for tsBenchWriteJson().
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    char name[BENCH_NAME_SIZE];
+    tsBenchResult result;
+    double samples[BENCH_SAMPLES];
+} tsInternalBenchRecord;
 
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
@@ -41,6 +124,63 @@ static unsigned int reallocNum;
 static unsigned int fopenNum;
 static unsigned int mkdirNum;
 
+// Test selection, read from the environment on the first tsRunTest() call.
+static bool isTestEnvRead;
+static bool isTestListed;
+static const char *onlyTest;
+
+// Debug allocator state. Modules allocate from worker threads, so it is locked.
+static atomic_flag allocLock = ATOMIC_FLAG_INIT;
+static tsInternalModule modules[ALLOC_MODULES_MAX];
+static int moduleCount;
+#ifdef SMILE_DEBUG_ALLOC
+static tsInternalBlock *liveBlocks;
+static tsInternalBlock *quarantine[ALLOC_QUARANTINE_SIZE];
+static size_t quarantineNext;
+#endif
+static atomic_uint_least64_t allocCount;
+
+// No-allocation region state. The flag is read on every allocation, the rest under the lock.
+static atomic_bool isNoAllocOpen;
+static size_t noAllocCount;
+static tsAllocSite noAllocFirst;
+
+static tsInternalBenchRecord benchRecords[BENCH_RESULTS_MAX];
+static size_t benchRecordCount;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Prototypes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef SMILE_DEBUG_ALLOC
+// Allocates a block with a header and tail canary, zeroed if `isZeroed`.
+static void *tsPrivateAllocTracked(size_t size, bool isZeroed, const char *file, int line);
+
+// Checks a block's canaries, then unlinks it and moves it into quarantine.
+static void tsPrivateFreeTracked(void *ptr, const char *file, int line);
+
+// Returns the totals of the directory `file` lives in, adding them if new.
+static tsInternalModule *tsPrivateGetModule(const char *file);
+#endif
+
+// Returns the totals registered under `name`, or nullptr.
+static tsInternalModule *tsPrivateFindModule(const char *name);
+
+static void tsPrivateLock(void);
+
+static void tsPrivateUnlock(void);
+
+// Counts a successful allocation for tsGetAllocCount() and any open
+// no-allocation region, then passes `ptr` through.
+static void *tsPrivateCountAlloc(void *ptr, size_t size, const char *file, int line);
+
+// Runs `iterations` of a benchmark and returns how long it took, or -1.
+static int64_t tsPrivateTimeBatch(tsBenchFn fn, void *args, uint64_t iterations);
+
+// Orders doubles ascending, for qsort.
+static int tsPrivateCompareDoubles(const void *a, const void *b);
+
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Functions
@@ -51,6 +191,26 @@ void tsPass(const char *fnName)
     printf("\t[PASS] %s\n", fnName);
 }
 
+void tsRunTest(const char *name, const tsTestFn fn)
+{
+    if (!isTestEnvRead)
+    {
+        isTestListed = getenv(TEST_LIST_ENV) != nullptr;
+        onlyTest = getenv(TEST_ONLY_ENV);
+        isTestEnvRead = true;
+    }
+
+    if (isTestListed)
+    {
+        printf("\t[TEST] %s\n", name);
+        return;
+    }
+    if (!onlyTest || strcmp(onlyTest, name) == 0)
+    {
+        fn();
+    }
+}
+
 bool tsDisable(tsSysFn fnName, unsigned int at)
 {
     if (at == 0)
@@ -82,7 +242,20 @@ bool tsDisable(tsSysFn fnName, unsigned int at)
     }
 }
 
-void *tsMalloc(const size_t size)
+// Names are parenthesized so the SMILE_DEBUG_ALLOC call-site macros leave them alone.
+
+void *(tsMalloc)(const size_t size) { return tsMallocAt(size, nullptr, 0); }
+
+void *(tsCalloc)(const size_t nitems, const size_t size)
+{
+    return tsCallocAt(nitems, size, nullptr, 0);
+}
+
+void *(tsRealloc)(void *ptr, const size_t size) { return tsReallocAt(ptr, size, nullptr, 0); }
+
+void (tsFree)(void *ptr) { tsFreeAt(ptr, nullptr, 0); }
+
+void *tsMallocAt(const size_t size, const char *file, const int line)
 {
     mallocNum--;
     if (!canMalloc && mallocNum == 0)
@@ -90,10 +263,14 @@ void *tsMalloc(const size_t size)
         canMalloc = true;
         return nullptr;
     }
-    return malloc(size);
+#ifdef SMILE_DEBUG_ALLOC
+    return tsPrivateCountAlloc(tsPrivateAllocTracked(size, false, file, line), size, file, line);
+#else
+    return tsPrivateCountAlloc(malloc(size), size, file, line);
+#endif
 }
 
-void *tsCalloc(const size_t nitems, const size_t size)
+void *tsCallocAt(const size_t nitems, const size_t size, const char *file, const int line)
 {
     callocNum--;
     if (!canCalloc && callocNum == 0)
@@ -101,10 +278,19 @@ void *tsCalloc(const size_t nitems, const size_t size)
         canCalloc = true;
         return nullptr;
     }
-    return calloc(nitems, size);
+#ifdef SMILE_DEBUG_ALLOC
+    if (size != 0 && nitems > SIZE_MAX / size)
+    {
+        return nullptr;
+    }
+    return tsPrivateCountAlloc(tsPrivateAllocTracked(nitems * size, true, file, line),
+                               nitems * size, file, line);
+#else
+    return tsPrivateCountAlloc(calloc(nitems, size), nitems * size, file, line);
+#endif
 }
 
-void *tsRealloc(void *ptr, const size_t size)
+void *tsReallocAt(void *ptr, const size_t size, const char *file, const int line)
 {
     reallocNum--;
     if (!canRealloc && reallocNum == 0)
@@ -112,7 +298,74 @@ void *tsRealloc(void *ptr, const size_t size)
         canRealloc = true;
         return nullptr;
     }
-    return realloc(ptr, size);
+#ifdef SMILE_DEBUG_ALLOC
+    // Always moves, so stale pointers to the old block hit its canary.
+    void *moved = tsPrivateAllocTracked(size, false, file, line);
+    if (moved && ptr)
+    {
+        const tsInternalBlock *OLD = (const tsInternalBlock *)((unsigned char *)ptr - ALLOC_HEADER_SIZE);
+        memcpy(moved, ptr, OLD->size < size ? OLD->size : size);
+        tsPrivateFreeTracked(ptr, file, line);
+    }
+    return tsPrivateCountAlloc(moved, size, file, line);
+#else
+    return tsPrivateCountAlloc(realloc(ptr, size), size, file, line);
+#endif
+}
+
+void tsFreeAt(void *ptr, const char *file, const int line)
+{
+#ifdef SMILE_DEBUG_ALLOC
+    tsPrivateFreeTracked(ptr, file, line);
+#else
+    (void)file;
+    (void)line;
+    free(ptr);
+#endif
+}
+
+bool tsGetAllocStats(const char *module, tsAllocStats *stats)
+{
+    tsPrivateLock();
+    const tsInternalModule *FOUND = tsPrivateFindModule(module);
+    if (FOUND)
+    {
+        *stats = FOUND->stats;
+    }
+    tsPrivateUnlock();
+    return FOUND != nullptr;
+}
+
+size_t tsReportAllocations(const char *module)
+{
+#ifdef SMILE_DEBUG_ALLOC
+    tsPrivateLock();
+    const tsInternalModule *FOUND = tsPrivateFindModule(module);
+    if (!FOUND)
+    {
+        tsPrivateUnlock();
+        return 0;
+    }
+
+    const tsAllocStats STATS = FOUND->stats;
+    fprintf(stderr,
+            "[Smile alloc] %s: peak %zu B, %zu B live in %zu blocks, %zu allocations, %zu bad frees\n",
+            module, STATS.peakBytes, STATS.liveBytes, STATS.liveBlocks, STATS.totalBlocks,
+            STATS.badFrees);
+    for (const tsInternalBlock *block = liveBlocks; block; block = block->next)
+    {
+        if (&modules[block->module] == FOUND)
+        {
+            fprintf(stderr, "[Smile alloc] %s: leaked %zu B allocated at %s:%d\n", module,
+                    block->size, block->file, block->line);
+        }
+    }
+    tsPrivateUnlock();
+    return STATS.liveBlocks;
+#else
+    (void)module;
+    return 0;
+#endif
 }
 
 FILE *tsFopen(const char *path, const char *mode)
@@ -168,3 +421,394 @@ void tsReset(void)
     fopenNum = 0;
     mkdirNum = 0;
 }
+
+uint64_t tsGetAllocCount(void) { return atomic_load_explicit(&allocCount, memory_order_relaxed); }
+
+void tsBeginNoAlloc(void)
+{
+    tsPrivateLock();
+    noAllocCount = 0;
+    noAllocFirst = (tsAllocSite){0};
+    atomic_store(&isNoAllocOpen, true);
+    tsPrivateUnlock();
+}
+
+size_t tsEndNoAlloc(tsAllocSite *first)
+{
+    tsPrivateLock();
+    atomic_store(&isNoAllocOpen, false);
+    const size_t COUNT = noAllocCount;
+    if (first)
+    {
+        *first = noAllocFirst;
+    }
+    tsPrivateUnlock();
+
+    if (COUNT > NO_ALLOC_REPORTS_MAX)
+    {
+        fprintf(stderr, "[Smile alloc] %zu allocations inside a no-allocation region\n", COUNT);
+    }
+    return COUNT;
+}
+
+bool tsBench(const char *name, const tsBenchFn fn, void *args, tsBenchResult *result)
+{
+    if (!name || !fn)
+    {
+        return false;
+    }
+
+    // Warms up while growing the batch until it takes BENCH_BATCH_NS.
+    uint64_t iterations = 1;
+    const int64_t WARMUP_START = cmGetTimeNs();
+    for (;;)
+    {
+        const int64_t ELAPSED = tsPrivateTimeBatch(fn, args, iterations);
+        if (ELAPSED < 0)
+        {
+            return false;
+        }
+        if (ELAPSED < BENCH_BATCH_NS)
+        {
+            uint64_t next = ELAPSED == 0
+                                ? iterations * BENCH_GROWTH_MAX
+                                : iterations * (uint64_t)BENCH_BATCH_NS / (uint64_t)ELAPSED + 1;
+            iterations = next > iterations * BENCH_GROWTH_MAX ? iterations * BENCH_GROWTH_MAX : next;
+            continue;
+        }
+        if (cmGetTimeNs() - WARMUP_START >= BENCH_WARMUP_NS)
+        {
+            break;
+        }
+    }
+
+    tsInternalBenchRecord scratch;
+    tsInternalBenchRecord *record = benchRecordCount < BENCH_RESULTS_MAX
+                                        ? &benchRecords[benchRecordCount++]
+                                        : &scratch;
+    snprintf(record->name, sizeof(record->name), "%s", name);
+
+    size_t count = 0;
+    int64_t totalNs = 0;
+    const uint64_t ALLOCS_BEFORE = tsGetAllocCount();
+    while (count < BENCH_SAMPLES && (count < BENCH_MIN_SAMPLES || totalNs < BENCH_MAX_NS))
+    {
+        const int64_t ELAPSED = tsPrivateTimeBatch(fn, args, iterations);
+        if (ELAPSED < 0)
+        {
+            return false;
+        }
+        record->samples[count++] = (double)ELAPSED / (double)iterations;
+        totalNs += ELAPSED;
+    }
+    const uint64_t ALLOCS = tsGetAllocCount() - ALLOCS_BEFORE;
+
+    double sorted[BENCH_SAMPLES];
+    memcpy(sorted, record->samples, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), tsPrivateCompareDoubles);
+
+    record->result = (tsBenchResult){
+        .name = record->name,
+        .iterations = iterations,
+        .sampleCount = count,
+        .minNs = sorted[0],
+        .medianNs = count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2,
+        .p99Ns = tsPercentile(sorted, count, 99),
+        .allocsPerOp = (double)ALLOCS / (double)(iterations * count),
+    };
+
+    printf("\t[BENCH] %-48s min %10.1f ns  median %10.1f ns  p99 %10.1f ns  %6.2f allocs/op\n",
+           name, record->result.minNs, record->result.medianNs, record->result.p99Ns,
+           record->result.allocsPerOp);
+
+    if (result)
+    {
+        *result = record->result;
+        result->name = name;
+    }
+    return true;
+}
+
+double tsPercentile(const double *sorted, size_t count, unsigned percent)
+{
+    if (!sorted || count == 0 || percent > 100)
+    {
+        return 0.0;
+    }
+
+    // Nearest rank, so the result is always a sample that was measured.
+    const size_t RANK = (count * percent + 99) / 100;
+    return sorted[RANK > 0 ? RANK - 1 : 0];
+}
+
+bool tsBenchWriteJson(const char *path)
+{
+    if (!path)
+    {
+        return false;
+    }
+
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    fputs("{\n  \"benchmarks\": [", file);
+    for (size_t i = 0; i < benchRecordCount; i++)
+    {
+        const tsInternalBenchRecord *RECORD = &benchRecords[i];
+        const tsBenchResult *RESULT = &RECORD->result;
+
+        // Names are chosen by benchmarks, so only quotes and backslashes need escaping.
+        fputs(i ? ",\n    {\"name\": \"" : "\n    {\"name\": \"", file);
+        for (const char *c = RECORD->name; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                fputc('\\', file);
+            }
+            fputc(*c, file);
+        }
+        fprintf(file,
+                "\", \"iterations\": %llu, \"min_ns\": %.3f, \"median_ns\": %.3f, "
+                "\"p99_ns\": %.3f, \"allocs_per_op\": %.4f, \"samples_ns\": [",
+                (unsigned long long)RESULT->iterations, RESULT->minNs, RESULT->medianNs,
+                RESULT->p99Ns, RESULT->allocsPerOp);
+        for (size_t j = 0; j < RESULT->sampleCount; j++)
+        {
+            fprintf(file, j ? ", %.3f" : "%.3f", RECORD->samples[j]);
+        }
+        fputs("]}", file);
+    }
+    fputs("\n  ]\n}\n", file);
+
+    return fclose(file) == 0;
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions - Private
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef SMILE_DEBUG_ALLOC
+void *tsPrivateAllocTracked(const size_t size, const bool isZeroed, const char *file, const int line)
+{
+    if (size > SIZE_MAX - ALLOC_HEADER_SIZE - sizeof(uint64_t))
+    {
+        return nullptr;
+    }
+
+    const size_t TOTAL = ALLOC_HEADER_SIZE + size + sizeof(uint64_t);
+    unsigned char *raw = isZeroed ? calloc(1, TOTAL) : malloc(TOTAL);
+    if (!raw)
+    {
+        return nullptr;
+    }
+
+    tsInternalBlock *block = (tsInternalBlock *)raw;
+    unsigned char *ptr = raw + ALLOC_HEADER_SIZE;
+    const uint64_t TAIL = ALLOC_CANARY_TAIL;
+    memcpy(ptr + size, &TAIL, sizeof(TAIL));
+
+    block->canary = ALLOC_CANARY_LIVE;
+    block->file = file ? file : "(unknown)";
+    block->line = line;
+    block->size = size;
+    block->prev = nullptr;
+
+    tsPrivateLock();
+    tsInternalModule *module = tsPrivateGetModule(block->file);
+    block->module = (int)(module - modules);
+    module->stats.liveBytes += size;
+    module->stats.liveBlocks++;
+    module->stats.totalBlocks++;
+    if (module->stats.liveBytes > module->stats.peakBytes)
+    {
+        module->stats.peakBytes = module->stats.liveBytes;
+    }
+
+    block->next = liveBlocks;
+    if (liveBlocks)
+    {
+        liveBlocks->prev = block;
+    }
+    liveBlocks = block;
+    tsPrivateUnlock();
+
+    return ptr;
+}
+
+void tsPrivateFreeTracked(void *ptr, const char *file, const int line)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    tsInternalBlock *block = (tsInternalBlock *)((unsigned char *)ptr - ALLOC_HEADER_SIZE);
+    file = file ? file : "(unknown)";
+
+    tsPrivateLock();
+    if (block->canary != ALLOC_CANARY_LIVE)
+    {
+        const bool IS_DOUBLE_FREE = block->canary == ALLOC_CANARY_FREED;
+        tsInternalModule *module = IS_DOUBLE_FREE ? &modules[block->module] : tsPrivateGetModule(file);
+        module->stats.badFrees++;
+        if (IS_DOUBLE_FREE)
+        {
+            fprintf(stderr, "[Smile alloc] %s: double free at %s:%d of %zu B allocated at %s:%d\n",
+                    module->name, file, line, block->size, block->file, block->line);
+        }
+        else
+        {
+            fprintf(stderr, "[Smile alloc] %s: free of unknown pointer %p at %s:%d\n", module->name,
+                    ptr, file, line);
+        }
+        tsPrivateUnlock();
+        return; // Leaked rather than risk corrupting the heap.
+    }
+
+    tsInternalModule *module = &modules[block->module];
+    uint64_t tail;
+    memcpy(&tail, (unsigned char *)ptr + block->size, sizeof(tail));
+    if (tail != ALLOC_CANARY_TAIL)
+    {
+        module->stats.badFrees++;
+        fprintf(stderr, "[Smile alloc] %s: overrun past %zu B allocated at %s:%d, found at %s:%d\n",
+                module->name, block->size, block->file, block->line, file, line);
+    }
+
+    module->stats.liveBytes -= block->size;
+    module->stats.liveBlocks--;
+    if (block->prev)
+    {
+        block->prev->next = block->next;
+    }
+    else
+    {
+        liveBlocks = block->next;
+    }
+    if (block->next)
+    {
+        block->next->prev = block->prev;
+    }
+    block->canary = ALLOC_CANARY_FREED;
+
+    tsInternalBlock *evicted = quarantine[quarantineNext];
+    quarantine[quarantineNext] = block;
+    quarantineNext = (quarantineNext + 1) % ALLOC_QUARANTINE_SIZE;
+    tsPrivateUnlock();
+
+    free(evicted);
+}
+
+tsInternalModule *tsPrivateGetModule(const char *file)
+{
+    // The module is the last directory in the path, e.g. "SceneManager" in "src/SceneManager/SceneManager.c".
+    const char *end = strrchr(file, '/');
+    const char *backslash = strrchr(file, '\\');
+    end = backslash > end ? backslash : end;
+    const char *start = file;
+    if (end)
+    {
+        start = end;
+        while (start > file && start[-1] != '/' && start[-1] != '\\')
+        {
+            start--;
+        }
+    }
+    else
+    {
+        end = file + strlen(file);
+    }
+
+    char name[ALLOC_MODULE_NAME_SIZE];
+    const size_t LENGTH = (size_t)(end - start) < sizeof(name) - 1 ? (size_t)(end - start) : sizeof(name) - 1;
+    memcpy(name, start, LENGTH);
+    name[LENGTH] = '\0';
+
+    tsInternalModule *module = tsPrivateFindModule(name);
+    if (module)
+    {
+        return module;
+    }
+
+    // The last slot collects every module past the limit.
+    module = &modules[moduleCount < ALLOC_MODULES_MAX ? moduleCount++ : ALLOC_MODULES_MAX - 1];
+    if (module->name[0] == '\0')
+    {
+        memcpy(module->name, name, LENGTH + 1);
+    }
+    return module;
+}
+#endif
+
+tsInternalModule *tsPrivateFindModule(const char *name)
+{
+    for (int i = 0; i < moduleCount; i++)
+    {
+        if (strcmp(modules[i].name, name) == 0)
+        {
+            return &modules[i];
+        }
+    }
+    return nullptr;
+}
+
+void tsPrivateLock(void)
+{
+    while (atomic_flag_test_and_set_explicit(&allocLock, memory_order_acquire))
+    {
+        cmCpuRelax();
+    }
+}
+
+void tsPrivateUnlock(void) { atomic_flag_clear_explicit(&allocLock, memory_order_release); }
+
+void *tsPrivateCountAlloc(void *ptr, const size_t size, const char *file, const int line)
+{
+    if (!ptr)
+    {
+        return nullptr;
+    }
+    atomic_fetch_add_explicit(&allocCount, 1, memory_order_relaxed);
+    if (!atomic_load_explicit(&isNoAllocOpen, memory_order_relaxed))
+    {
+        return ptr;
+    }
+
+    tsPrivateLock();
+    const bool IS_REPORTED = atomic_load(&isNoAllocOpen) && noAllocCount++ < NO_ALLOC_REPORTS_MAX;
+    if (IS_REPORTED && noAllocCount == 1)
+    {
+        noAllocFirst = (tsAllocSite){.file = file, .line = line, .size = size};
+    }
+    tsPrivateUnlock();
+
+    if (IS_REPORTED && file)
+    {
+        fprintf(stderr, "[Smile alloc] %zu B allocated inside a no-allocation region at %s:%d\n", size,
+                file, line);
+    }
+    else if (IS_REPORTED)
+    {
+        fprintf(stderr, "[Smile alloc] %zu B allocated inside a no-allocation region\n", size);
+    }
+    return ptr;
+}
+
+int64_t tsPrivateTimeBatch(const tsBenchFn fn, void *args, const uint64_t iterations)
+{
+    const int64_t START = cmGetTimeNs();
+    fn(iterations, args);
+    const int64_t END = cmGetTimeNs();
+    return START == 0 || END == 0 ? -1 : END - START;
+}
+
+int tsPrivateCompareDoubles(const void *a, const void *b)
+{
+    const double A = *(const double *)a;
+    const double B = *(const double *)b;
+    return (A > B) - (A < B);
+}
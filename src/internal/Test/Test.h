@@ -13,6 +13,8 @@
 // Includes
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
 
@@ -37,6 +39,77 @@ typedef enum
     MKDIR,
 } tsSysFn;
 
+/**
+ * @brief Allocation totals of one module, kept with SMILE_DEBUG_ALLOC.
+ *
+ * A module is the directory of the file that allocated, e.g. `SceneManager`
+ * or `Common`.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    size_t liveBytes;
+    size_t peakBytes;
+    size_t liveBlocks;
+    size_t totalBlocks;
+    size_t badFrees; // double frees, unknown pointers and overruns caught
+} tsAllocStats;
+
+/**
+ * @brief Where an allocation inside a no-allocation region was made.
+ *
+ * `file` is nullptr if the allocating file was built without call sites,
+ * i.e. without SMILE_DEV or SMILE_DEBUG_ALLOC.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    const char *file;
+    int line;
+    size_t size;
+} tsAllocSite;
+
+/**
+ * @brief Body of a benchmark, timed by tsBench().
+ *
+ * Runs the operation under test @p iterations times in a loop, so the timer
+ * is read once per batch rather than once per operation.
+ *
+ * @param iterations Number of times to run the operation.
+ * @param args Pointer passed to tsBench().
+ *
+ * @author Vitor Betmann
+ */
+typedef void (*tsBenchFn)(uint64_t iterations, void *args);
+
+/**
+ * @brief A test case, run by tsRunTest().
+ *
+ * @author Vitor Betmann
+ */
+typedef void (*tsTestFn)(void);
+
+/**
+ * @brief Timings of one benchmark, per operation.
+ *
+ * Each sample is one batch of `iterations` operations, divided by
+ * `iterations`. `allocsPerOp` counts calls to the allocation wrappers.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    const char *name;
+    uint64_t iterations;
+    size_t sampleCount;
+    double minNs;
+    double medianNs;
+    double p99Ns;
+    double allocsPerOp;
+} tsBenchResult;
+
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Functions -
 // —————————————————————————————————————————————————————————————————————————————————————————————————
@@ -50,6 +123,21 @@ typedef enum
  */
 void tsPass(const char *fnName);
 
+/**
+ * @brief Runs a test case from a test executable's main, or lets TestRunner
+ *        find and select it.
+ *
+ * With SMILE_TEST_LIST set in the environment, prints the name as
+ * "[TEST] name" instead of running it. With SMILE_TEST_ONLY set, runs it only
+ * if the name matches. Otherwise, just runs it. Call through tsRun().
+ *
+ * @param name Name of the test function.
+ * @param fn The test function.
+ *
+ * @author Vitor Betmann
+ */
+void tsRunTest(const char *name, tsTestFn fn);
+
 /**
  * @brief Disable a system function for controlled failure simulation.
  *
@@ -105,6 +193,95 @@ void *tsCalloc(size_t nitems, size_t size);
  */
 void *tsRealloc(void *ptr, size_t size);
 
+/**
+ * @brief Releases memory from tsMalloc(), tsCalloc() or tsRealloc().
+ *
+ * Memory from the wrappers must be released with this, never free(), since
+ * SMILE_DEBUG_ALLOC places a header in front of each block.
+ *
+ * @param ptr Pointer to release. Null does nothing.
+ *
+ * @author Vitor Betmann
+ */
+void tsFree(void *ptr);
+
+/**
+ * @brief Call-site variants behind the wrappers when SMILE_DEBUG_ALLOC is on.
+ *
+ * @param file File of the call, `__FILE__`.
+ * @param line Line of the call, `__LINE__`.
+ *
+ * @author Vitor Betmann
+ */
+void *tsMallocAt(size_t size, const char *file, int line);
+void *tsCallocAt(size_t nitems, size_t size, const char *file, int line);
+void *tsReallocAt(void *ptr, size_t size, const char *file, int line);
+void tsFreeAt(void *ptr, const char *file, int line);
+
+/**
+ * @brief Reads the allocation totals of a module.
+ *
+ * @param module Directory name of the module, e.g. `"SceneManager"`.
+ * @param stats Output for the totals.
+ *
+ * @return true if the module allocated since the process started, false
+ *         otherwise or without SMILE_DEBUG_ALLOC.
+ *
+ * @author Vitor Betmann
+ */
+bool tsGetAllocStats(const char *module, tsAllocStats *stats);
+
+/**
+ * @brief Writes a module's peak and live usage to stderr, then one line per
+ *        block it still holds, with the call site that allocated it.
+ *
+ * Module stop functions call this once everything they own is freed, so
+ * every block listed is a leak.
+ *
+ * @param module Directory name of the module, e.g. `"SceneManager"`.
+ *
+ * @return Number of blocks still held, or 0 without SMILE_DEBUG_ALLOC.
+ *
+ * @author Vitor Betmann
+ */
+size_t tsReportAllocations(const char *module);
+
+/**
+ * @brief Counts allocations made through the wrappers since the process
+ *        started, whether or not SMILE_DEBUG_ALLOC is on.
+ *
+ * @return Number of successful tsMalloc(), tsCalloc() and tsRealloc() calls.
+ *
+ * @author Vitor Betmann
+ */
+uint64_t tsGetAllocCount(void);
+
+/**
+ * @brief Opens a region in which no allocation is expected, e.g. around a
+ *        frame's smUpdate() and smDraw().
+ *
+ * Until tsEndNoAlloc(), every successful tsMalloc(), tsCalloc() and
+ * tsRealloc() call, from any thread, is counted and written to stderr with
+ * its call site. Regions don't nest: opening one again starts it over.
+ *
+ * @author Vitor Betmann
+ */
+void tsBeginNoAlloc(void);
+
+/**
+ * @brief Closes the region opened by tsBeginNoAlloc().
+ *
+ * Meant to be asserted on, e.g. `assert(tsEndNoAlloc(nullptr) == 0)`.
+ *
+ * @param first Optional output for the first allocation in the region,
+ *        zeroed if there was none.
+ *
+ * @return Number of allocations made inside the region.
+ *
+ * @author Vitor Betmann
+ */
+size_t tsEndNoAlloc(tsAllocSite *first);
+
 /**
  * @brief Wrapper around fopen() with optional failure simulation.
  *
@@ -157,5 +334,95 @@ char *tsMkdtemp(char *tmpl);
  */
 void tsReset(void);
 
+/**
+ * @brief Times a benchmark and prints its min, median and p99 per operation.
+ *
+ * Warms up first, picking the number of iterations per batch so a batch runs
+ * for about a millisecond. Then times up to 200 batches, stopping early once
+ * at least 100 have run and the samples add up to two seconds. Every result is also kept for
+ * tsBenchWriteJson().
+ *
+ * @param name Name printed and written to the JSON report.
+ * @param fn Body of the benchmark.
+ * @param args Pointer passed to @p fn, e.g. a fixture.
+ * @param result Optional output for the timings.
+ *
+ * @return true on success, false if @p name or @p fn is null, or the clock
+ *         can't be read.
+ *
+ * @author Vitor Betmann
+ */
+bool tsBench(const char *name, tsBenchFn fn, void *args, tsBenchResult *result);
+
+/**
+ * @brief Picks a percentile from sorted samples by nearest rank.
+ *
+ * @param sorted Samples in ascending order.
+ * @param count Number of samples.
+ * @param percent Percentile to pick, from 0 to 100.
+ *
+ * @return The smallest sample with at least @p percent of the samples at or
+ *         below it, or 0 if @p sorted is null, @p count is 0, or @p percent is
+ *         above 100.
+ *
+ * @author Vitor Betmann
+ */
+double tsPercentile(const double *sorted, size_t count, unsigned percent);
+
+/**
+ * @brief Writes every result since the process started as JSON.
+ *
+ * Each benchmark lists its summary and its per-operation samples, so runs can
+ * be compared statistically rather than by a single number.
+ *
+ * @param path Path of the file to create or overwrite.
+ *
+ * @return true on success, false if @p path is null or can't be written.
+ *
+ * @author Vitor Betmann
+ */
+bool tsBenchWriteJson(const char *path);
+
+/**
+ * @brief Keeps the compiler from optimizing away a value a benchmark computes.
+ *
+ * Pass the address of the value. The compiler must then assume the value is
+ * read and that any memory may have changed.
+ *
+ * @param ptr Address of the value to keep.
+ *
+ * @author Vitor Betmann
+ */
+static inline void tsDoNotOptimize(const void *ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ volatile("" : : "r"(ptr) : "memory");
+#else
+    static const void *volatile sink;
+    sink = ptr;
+#endif
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Runs a test case under its own name, e.g. tsRun(Test_smUpdate_FailsPreStart).
+#define tsRun(fn) tsRunTest(#fn, fn)
+
+/* With SMILE_DEBUG_ALLOC or SMILE_DEV, the allocation wrappers record where
+ * each block was allocated, so leaks, bad frees and allocations inside a
+ * no-allocation region can name their call site. Defined after the
+ * prototypes, which they would otherwise rewrite.
+ */
+
+#if defined(SMILE_DEBUG_ALLOC) || defined(SMILE_DEV)
+#define tsMalloc(size) tsMallocAt(size, __FILE__, __LINE__)
+#define tsCalloc(nitems, size) tsCallocAt(nitems, size, __FILE__, __LINE__)
+#define tsRealloc(ptr, size) tsReallocAt(ptr, size, __FILE__, __LINE__)
+#define tsFree(ptr) tsFreeAt(ptr, __FILE__, __LINE__)
+#endif
+
 
 #endif
@@ -36,14 +36,19 @@ bool gsTestUserConfirms = false;
 
 static const char *USAGE =
     "Usage: GenScene <SceneName> [options]\n"
+    "       GenScene --registry <dir> [-si <dir>] [-hi <dir>]\n"
     "Try 'GenScene --help' for more information.\n";
 
 static const char *HELP =
     "Usage: GenScene <SceneName> [options]\n"
+    "       GenScene --registry <dir> [-si <dir>] [-hi <dir>]\n"
     "\n"
     "Options:\n"
     "  -h,  --help                Show this message (only works as first flag)\n"
     "\n"
+    "  -r,  --registry <dir>      Generates " GS_REGISTRY_NAME ".c/.h from the scene headers in <dir>\n"
+    "                             (only works as first flag)\n"
+    "\n"
     "  -as, --add-sections        Adds smile-style section headers for code organization\n"
     "\n"
     "  -ne, --no-enter            Omit the enter callback\n"
@@ -72,6 +77,27 @@ void gsPrivateWriteSrc(FILE *f, const gsInternalArgs *args);
 
 void gsPrivateWriteHeader(FILE *f, const gsInternalArgs *args);
 
+int gsPrivateParsePathFlag(int argc, char *argv[], int *i, char **path);
+
+// Prompts to create a missing directory. Sets *create when it should be created.
+int gsPrivateConfirmDir(const char *path, bool *create);
+
+int gsPrivateConfirmOverwrite(const char *path);
+
+int gsPrivateCreateDir(const char *path);
+
+int gsPrivateRunRegistry(int argc, char *argv[]);
+
+// cmListDir callback that records every scene header of the scanned directory.
+void gsPrivateScanHeader(const char *fileName, void *ctx);
+
+int gsPrivateCompareScenes(const void *a, const void *b);
+
+void gsPrivateWriteRegistrySrc(FILE *f, const gsInternalRegistryScan *scan,
+                               const size_t *order, const uint32_t *seeds, size_t seedCount);
+
+void gsPrivateWriteRegistryHeader(FILE *f);
+
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Functions - Internal
@@ -144,6 +170,101 @@ int gsInternalSanitizeName(char *buf, size_t bufSize, const char *name)
     return RES_OK;
 }
 
+int gsInternalBuildPerfectHash(const char *const *names, size_t count, uint32_t *seeds,
+                               size_t seedCount, size_t *slots)
+{
+    if (!names || !seeds || !slots)
+    {
+        return RES_NULL_ARG;
+    }
+    if (count == 0 || seedCount == 0)
+    {
+        return RES_INVALID_ARG;
+    }
+
+    int result = RES_MEM_ALLOC_FAIL;
+    size_t *buckets = tsMalloc(count * sizeof(size_t));
+    size_t *bucketSizes = tsCalloc(seedCount, sizeof(size_t));
+    size_t *order = tsMalloc(seedCount * sizeof(size_t));
+    bool *isTaken = tsCalloc(count, sizeof(bool));
+    if (!buckets || !bucketSizes || !order || !isTaken)
+    {
+        goto cleanup;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        buckets[i] = cmHashString(names[i], 0) % seedCount;
+        bucketSizes[buckets[i]]++;
+    }
+
+    // Largest buckets first, while most slots are still free.
+    for (size_t i = 0; i < seedCount; i++)
+    {
+        size_t j = i;
+        for (; j > 0 && bucketSizes[order[j - 1]] < bucketSizes[i]; j--)
+        {
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+        seeds[i] = 0;
+    }
+
+    result = RES_OK;
+    for (size_t b = 0; b < seedCount && bucketSizes[order[b]] > 0; b++)
+    {
+        const size_t BUCKET = order[b];
+        bool isPlaced = false;
+
+        for (uint32_t seed = 1; seed < GS_SEED_SEARCH_MAX && !isPlaced; seed++)
+        {
+            size_t end = 0;
+            for (; end < count; end++)
+            {
+                if (buckets[end] != BUCKET)
+                {
+                    continue;
+                }
+                slots[end] = cmHashString(names[end], seed) % count;
+                if (isTaken[slots[end]])
+                {
+                    break;
+                }
+                isTaken[slots[end]] = true;
+            }
+
+            isPlaced = end == count;
+            if (isPlaced)
+            {
+                seeds[BUCKET] = seed;
+                break;
+            }
+
+            // Release the slots this attempt took before colliding.
+            for (size_t i = 0; i < end; i++)
+            {
+                if (buckets[i] == BUCKET)
+                {
+                    isTaken[slots[i]] = false;
+                }
+            }
+        }
+
+        if (!isPlaced)
+        {
+            result = RES_NO_PERFECT_HASH;
+            break;
+        }
+    }
+
+cleanup:
+    tsFree(buckets);
+    tsFree(bucketSizes);
+    tsFree(order);
+    tsFree(isTaken);
+    return result;
+}
+
 void gsInternalFatalHandler(void)
 {
     printf("%s", USAGE);
@@ -249,6 +370,351 @@ void gsPrivateWriteHeader(FILE *f, const gsInternalArgs *args)
     fprintf(f, "\n\n#endif\n");
 }
 
+int gsPrivateParsePathFlag(int argc, char *argv[], int *i, char **path)
+{
+    if (*i + 1 >= argc)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_FLAG_REQ_PATH_ARG, argv[*i], ORI, CSQ_ABORT);
+        return RES_EMPTY_ARG;
+    }
+    if (cmValidatePath(argv[*i + 1]) != RES_OK)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_PATH, argv[*i + 1], ORI, CSQ_ABORT);
+        return RES_INVALID_PATH;
+    }
+
+    *path = argv[++*i];
+    return RES_OK;
+}
+
+int gsPrivateConfirmDir(const char *path, bool *create)
+{
+    if (cmDirExists(path))
+    {
+        return RES_OK;
+    }
+
+    lgInternalLogWithArg(WARN, ORI, CSE_DIR_NOT_EXISTS, path, ORI, CSQ_PAUSE);
+    char buf[512];
+    snprintf(buf, sizeof(buf), "Create directory: '%s'?", path);
+    if (!gsPrivatePrompt(buf))
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_DIR_NOT_EXISTS, path, ORI, CSQ_ABORT);
+        return RES_USER_ABORT;
+    }
+
+    *create = true;
+    return RES_OK;
+}
+
+int gsPrivateConfirmOverwrite(const char *path)
+{
+    if (!cmFileExists(path))
+    {
+        return RES_OK;
+    }
+
+    lgInternalLogWithArg(WARN, ORI, CSE_FILE_ALREADY_EXISTS, path, ORI, CSQ_PAUSE);
+    char buf[2 * CM_PATH_MAX];
+    snprintf(buf, sizeof(buf), "Overwrite '%s'? (this may be irreversible)", path);
+    if (!gsPrivatePrompt(buf))
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_FILE_ALREADY_EXISTS, path, ORI, CSQ_ABORT);
+        return RES_USER_ABORT;
+    }
+
+    return RES_OK;
+}
+
+int gsPrivateCreateDir(const char *path)
+{
+    if (cmCreateDir(path) != RES_OK)
+    {
+        lgInternalLogWithArg(FATAL, ORI, CSE_CREATE_DIR_FAIL, path, ORI, CSQ_ABORT);
+        return RES_CREATE_DIR_FAIL;
+    }
+
+    lgInternalLogWithArg(INFO, ORI, CSE_DIR_CREATE, path, ORI, CSQ_SUCCESS);
+    return RES_OK;
+}
+
+int gsPrivateRunRegistry(int argc, char *argv[])
+{
+    char *scanPath = nullptr;
+    char *srcPath = DEFAULT_SRC_DIR;
+    char *includePath = DEFAULT_INCLUDE_DIR;
+
+    int i = 1;
+    int result = gsPrivateParsePathFlag(argc, argv, &i, &scanPath);
+    if (result != RES_OK)
+    {
+        return result;
+    }
+
+    for (i++; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--source-in") == 0 || strcmp(argv[i], "-si") == 0)
+        {
+            result = gsPrivateParsePathFlag(argc, argv, &i, &srcPath);
+        }
+        else if (strcmp(argv[i], "--header-in") == 0 || strcmp(argv[i], "-hi") == 0)
+        {
+            result = gsPrivateParsePathFlag(argc, argv, &i, &includePath);
+        }
+        else
+        {
+            lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_FLAG, argv[i], ORI, CSQ_ABORT);
+            result = RES_INVALID_FLAG;
+        }
+
+        if (result != RES_OK)
+        {
+            return result;
+        }
+    }
+
+    if (strlen(GS_REGISTRY_NAME) + strlen(srcPath) + 4 > CM_PATH_MAX || // +4 because of ".c\0"
+        strlen(GS_REGISTRY_NAME) + strlen(includePath) + 4 > CM_PATH_MAX) // +4 because of ".h\0"
+    {
+        lgInternalLog(FATAL, ORI, CSE_INVALID_PATH, ORI, CSQ_ABORT);
+        return RES_INVALID_PATH;
+    }
+
+    gsInternalRegistryScan scan = {.dir = scanPath};
+    result = cmListDir(scan.dir, gsPrivateScanHeader, &scan);
+    if (result != RES_OK)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_DIR_NOT_EXISTS, scan.dir, ORI, CSQ_ABORT);
+        return result;
+    }
+
+    result = scan.result;
+    if (result == RES_OK && scan.count == 0)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NO_SCENES, scan.dir, ORI, CSQ_ABORT);
+        result = RES_NO_SCENES;
+    }
+    if (result != RES_OK)
+    {
+        goto cleanup;
+    }
+
+    // readdir order is unspecified, so sort to keep the output reproducible.
+    qsort(scan.scenes, scan.count, sizeof(gsInternalRegistryScene), gsPrivateCompareScenes);
+
+    const size_t SEED_COUNT = (scan.count + GS_KEYS_PER_BUCKET - 1) / GS_KEYS_PER_BUCKET;
+    const char **names = tsMalloc(scan.count * sizeof(char *));
+    uint32_t *seeds = tsMalloc(SEED_COUNT * sizeof(uint32_t));
+    size_t *slots = tsMalloc(scan.count * sizeof(size_t));
+    size_t *order = tsMalloc(scan.count * sizeof(size_t));
+    if (!names || !seeds || !slots || !order)
+    {
+        lgInternalLog(ERROR, ORI, CSE_MEM_ALLOC_FAIL, ORI, CSQ_ABORT);
+        result = RES_MEM_ALLOC_FAIL;
+        goto cleanupHash;
+    }
+
+    for (size_t j = 0; j < scan.count; j++)
+    {
+        names[j] = scan.scenes[j].name;
+    }
+
+    result = gsInternalBuildPerfectHash(names, scan.count, seeds, SEED_COUNT, slots);
+    if (result != RES_OK)
+    {
+        lgInternalLogWithArg(ERROR, ORI, CSE_NO_PERFECT_HASH, scan.dir, ORI, CSQ_ABORT);
+        goto cleanupHash;
+    }
+
+    for (size_t j = 0; j < scan.count; j++)
+    {
+        order[slots[j]] = j;
+    }
+
+    bool createSrcDir = false;
+    bool createIncludeDir = false;
+    char srcBuf[CM_PATH_MAX];
+    char includeBuf[CM_PATH_MAX];
+    snprintf(srcBuf, sizeof(srcBuf), "%s/%s.c", srcPath, GS_REGISTRY_NAME);
+    snprintf(includeBuf, sizeof(includeBuf), "%s/%s.h", includePath, GS_REGISTRY_NAME);
+
+    if ((result = gsPrivateConfirmDir(srcPath, &createSrcDir)) != RES_OK ||
+        (result = gsPrivateConfirmDir(includePath, &createIncludeDir)) != RES_OK ||
+        (result = gsPrivateConfirmOverwrite(srcBuf)) != RES_OK ||
+        (result = gsPrivateConfirmOverwrite(includeBuf)) != RES_OK)
+    {
+        goto cleanupHash;
+    }
+
+    if ((createSrcDir && (result = gsPrivateCreateDir(srcPath)) != RES_OK) ||
+        (createIncludeDir && (result = gsPrivateCreateDir(includePath)) != RES_OK))
+    {
+        goto cleanupHash;
+    }
+
+    FILE *srcFile = tsFopen(srcBuf, "w");
+    if (!srcFile)
+    {
+        lgInternalLogWithArg(FATAL, ORI, CSE_CREATE_FILE_FAIL, srcBuf, ORI, CSQ_ABORT);
+        result = RES_CREATE_FILE_FAIL;
+        goto cleanupHash;
+    }
+    gsPrivateWriteRegistrySrc(srcFile, &scan, order, seeds, SEED_COUNT);
+    fclose(srcFile);
+    lgInternalLogWithArg(INFO, ORI, CSE_FILE_CREATE, srcBuf, ORI, CSQ_SUCCESS);
+
+    FILE *includeFile = tsFopen(includeBuf, "w");
+    if (!includeFile)
+    {
+        lgInternalLogWithArg(FATAL, ORI, CSE_CREATE_FILE_FAIL, includeBuf, ORI, CSQ_ABORT);
+        result = RES_CREATE_FILE_FAIL;
+        goto cleanupHash;
+    }
+    gsPrivateWriteRegistryHeader(includeFile);
+    fclose(includeFile);
+    lgInternalLogWithArg(INFO, ORI, CSE_FILE_CREATE, includeBuf, ORI, CSQ_SUCCESS);
+
+cleanupHash:
+    tsFree(names);
+    tsFree(seeds);
+    tsFree(slots);
+    tsFree(order);
+cleanup:
+    tsFree(scan.scenes);
+    return result;
+}
+
+void gsPrivateScanHeader(const char *fileName, void *ctx)
+{
+    gsInternalRegistryScan *scan = ctx;
+    const size_t LEN = strlen(fileName);
+    if (scan->result != RES_OK || LEN < 3 || strcmp(fileName + LEN - 2, ".h") != 0 ||
+        LEN - 2 >= GS_NAME_MAX || strcmp(fileName, GS_REGISTRY_NAME ".h") == 0)
+    {
+        return;
+    }
+
+    char path[CM_PATH_MAX];
+    if ((size_t)snprintf(path, sizeof(path), "%s/%s", scan->dir, fileName) >= sizeof(path))
+    {
+        return;
+    }
+
+    FILE *f = tsFopen(path, "r");
+    if (!f)
+    {
+        return;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    rewind(f);
+    if (size < 0)
+    {
+        fclose(f);
+        return;
+    }
+
+    char *content = tsMalloc((size_t)size + 1);
+    if (!content)
+    {
+        fclose(f);
+        scan->result = RES_MEM_ALLOC_FAIL;
+        return;
+    }
+    content[fread(content, 1, (size_t)size, f)] = '\0';
+    fclose(f);
+
+    gsInternalRegistryScene scene = {0};
+    memcpy(scene.name, fileName, LEN - 2);
+
+    // Scene headers declare <Name>Enter(, <Name>Update(, and so on.
+    char needle[GS_NAME_MAX + sizeof("Update(")];
+    snprintf(needle, sizeof(needle), "%sEnter(", scene.name);
+    scene.hasEnter = strstr(content, needle);
+    snprintf(needle, sizeof(needle), "%sUpdate(", scene.name);
+    scene.hasUpdate = strstr(content, needle);
+    snprintf(needle, sizeof(needle), "%sDraw(", scene.name);
+    scene.hasDraw = strstr(content, needle);
+    snprintf(needle, sizeof(needle), "%sExit(", scene.name);
+    scene.hasExit = strstr(content, needle);
+    tsFree(content);
+
+    if (!scene.hasEnter && !scene.hasUpdate && !scene.hasDraw && !scene.hasExit)
+    {
+        return;
+    }
+
+    if (scan->count == scan->capacity)
+    {
+        size_t capacity = scan->capacity ? scan->capacity * 2 : 16;
+        gsInternalRegistryScene *scenes = tsRealloc(scan->scenes,
+                                                    capacity * sizeof(gsInternalRegistryScene));
+        if (!scenes)
+        {
+            scan->result = RES_MEM_ALLOC_FAIL;
+            return;
+        }
+        scan->scenes = scenes;
+        scan->capacity = capacity;
+    }
+    scan->scenes[scan->count++] = scene;
+}
+
+int gsPrivateCompareScenes(const void *a, const void *b)
+{
+    return strcmp(((const gsInternalRegistryScene *)a)->name,
+                  ((const gsInternalRegistryScene *)b)->name);
+}
+
+void gsPrivateWriteRegistrySrc(FILE *f, const gsInternalRegistryScan *scan,
+                               const size_t *order, const uint32_t *seeds, size_t seedCount)
+{
+    fprintf(f, "// Generated by GenScene --registry. Do not edit.\n\n");
+    fprintf(f, "#include <SceneManager.h>\n\n#include \"" GS_REGISTRY_NAME ".h\"\n");
+    for (size_t i = 0; i < scan->count; i++)
+    {
+        fprintf(f, "#include \"%s.h\"\n", scan->scenes[i].name);
+    }
+
+    // Entries are stored in hash order: each scene sits at the slot its name hashes to.
+    fprintf(f, "\nstatic const smSceneDesc SCENES[] = {\n");
+    for (size_t slot = 0; slot < scan->count; slot++)
+    {
+        const gsInternalRegistryScene *scene = &scan->scenes[order[slot]];
+        const char *name = scene->name;
+        fprintf(f, "    {\"%s\", %s%s, %s%s, %s%s, %s%s},\n", name,
+                scene->hasEnter ? name : "nullptr", scene->hasEnter ? "Enter" : "",
+                scene->hasUpdate ? name : "nullptr", scene->hasUpdate ? "Update" : "",
+                scene->hasDraw ? name : "nullptr", scene->hasDraw ? "Draw" : "",
+                scene->hasExit ? name : "nullptr", scene->hasExit ? "Exit" : "");
+    }
+    fprintf(f, "};\n");
+
+    fprintf(f, "\nstatic const uint32_t SEEDS[] = {\n");
+    for (size_t i = 0; i < seedCount; i++)
+    {
+        fprintf(f, "    %uu,\n", (unsigned)seeds[i]);
+    }
+    fprintf(f, "};\n");
+
+    fprintf(f, "\nconst smSceneRegistry sceneRegistry = {\n");
+    fprintf(f, "    .scenes = SCENES,\n");
+    fprintf(f, "    .sceneCount = %zu,\n", scan->count);
+    fprintf(f, "    .seeds = SEEDS,\n");
+    fprintf(f, "    .seedCount = %zu,\n", seedCount);
+    fprintf(f, "};\n");
+}
+
+void gsPrivateWriteRegistryHeader(FILE *f)
+{
+    fprintf(f, "// Generated by GenScene --registry. Do not edit.\n\n");
+    fprintf(f, "#ifndef SCENE_REGISTRY_H\n#define SCENE_REGISTRY_H\n\n");
+    fprintf(f, "#include <SceneManager.h>\n\n");
+    fprintf(f, "extern const smSceneRegistry sceneRegistry;\n");
+    fprintf(f, "\n\n#endif\n");
+}
+
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Functions - Main
@@ -268,6 +734,11 @@ int gsInternalRun(int argc, char *argv[])
         return 0;
     }
 
+    if (strcmp(argv[1], "--registry") == 0 || strcmp(argv[1], "-r") == 0)
+    {
+        return gsPrivateRunRegistry(argc, argv);
+    }
+
     if (argv[1][0] == '-' || strlen(argv[1]) > GS_NAME_MAX)
     {
         lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_ARG, argv[1], ORI, CSQ_ABORT);
@@ -310,31 +781,19 @@ int gsInternalRun(int argc, char *argv[])
         }
         else if (strcmp(argv[i], "--source-in") == 0 || strcmp(argv[i], "-si") == 0)
         {
-            if (i + 1 >= argc)
+            int result = gsPrivateParsePathFlag(argc, argv, &i, &args.srcPath);
+            if (result != RES_OK)
             {
-                lgInternalLogWithArg(ERROR, ORI, CSE_FLAG_REQ_PATH_ARG, argv[i], ORI, CSQ_ABORT);
-                return RES_EMPTY_ARG;
+                return result;
             }
-            if (cmValidatePath(argv[i + 1]) != RES_OK)
-            {
-                lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_PATH, argv[i + 1], ORI, CSQ_ABORT);
-                return RES_INVALID_PATH;
-            }
-            args.srcPath = argv[++i];
         }
         else if (strcmp(argv[i], "--header-in") == 0 || strcmp(argv[i], "-hi") == 0)
         {
-            if (i + 1 >= argc)
-            {
-                lgInternalLogWithArg(ERROR, ORI, CSE_FLAG_REQ_PATH_ARG, argv[i], ORI, CSQ_ABORT);
-                return RES_EMPTY_ARG;
-            }
-            if (cmValidatePath(argv[i + 1]) != RES_OK)
+            int result = gsPrivateParsePathFlag(argc, argv, &i, &args.includePath);
+            if (result != RES_OK)
             {
-                lgInternalLogWithArg(ERROR, ORI, CSE_INVALID_PATH, argv[i + 1], ORI, CSQ_ABORT);
-                return RES_INVALID_PATH;
+                return result;
             }
-            args.includePath = argv[++i];
         }
         else
         {
@@ -366,80 +825,42 @@ int gsInternalRun(int argc, char *argv[])
         return RES_INVALID_PATH;
     }
 
-    // Check if they exist
-    if (!cmDirExists(args.srcPath))
+    int result = gsPrivateConfirmDir(args.srcPath, &createSrcDir);
+    if (result != RES_OK)
     {
-        lgInternalLogWithArg(WARN, ORI, CSE_DIR_NOT_EXISTS, args.srcPath, ORI, CSQ_PAUSE);
-        char buf[512];
-        snprintf(buf, sizeof(buf), "Create directory: '%s'?", args.srcPath);
-        if (!gsPrivatePrompt(buf))
-        {
-            lgInternalLogWithArg(ERROR, ORI, CSE_DIR_NOT_EXISTS, args.srcPath, ORI, CSQ_ABORT);
-            return RES_USER_ABORT;
-        }
-        createSrcDir = true;
+        return result;
     }
-    if (!cmDirExists(args.includePath))
+    result = gsPrivateConfirmDir(args.includePath, &createIncludeDir);
+    if (result != RES_OK)
     {
-        lgInternalLogWithArg(WARN, ORI, CSE_DIR_NOT_EXISTS, args.includePath, ORI, CSQ_PAUSE);
-        char buf[512];
-        snprintf(buf, sizeof(buf), "Create directory: '%s'?", args.includePath);
-        if (!gsPrivatePrompt(buf))
-        {
-            lgInternalLogWithArg(ERROR, ORI, CSE_DIR_NOT_EXISTS, args.includePath, ORI, CSQ_ABORT);
-            return RES_USER_ABORT;
-        }
-        createIncludeDir = true;
+        return result;
     }
 
     // Handling system specific path should be Common's job
     char srcBuf[CM_PATH_MAX];
     snprintf(srcBuf, sizeof(srcBuf), "%s/%s.c", args.srcPath, args.sceneName);
-    if (cmFileExists(srcBuf))
+    result = gsPrivateConfirmOverwrite(srcBuf);
+    if (result != RES_OK)
     {
-        lgInternalLogWithArg(WARN, ORI, CSE_FILE_ALREADY_EXISTS, srcBuf, ORI, CSQ_PAUSE);
-        char buf[2 * CM_PATH_MAX];
-        snprintf(buf, sizeof(buf), "Overwrite '%s'? (this may be irreversible)", srcBuf);
-        if (!gsPrivatePrompt(buf))
-        {
-            lgInternalLogWithArg(ERROR, ORI, CSE_FILE_ALREADY_EXISTS, args.srcPath, ORI, CSQ_ABORT);
-            return RES_USER_ABORT;
-        }
+        return result;
     }
 
     char includeBuf[CM_PATH_MAX];
     snprintf(includeBuf, sizeof(includeBuf), "%s/%s.h", args.includePath, args.sceneName);
-    if (cmFileExists(includeBuf))
+    result = gsPrivateConfirmOverwrite(includeBuf);
+    if (result != RES_OK)
     {
-        lgInternalLogWithArg(WARN, ORI, CSE_FILE_ALREADY_EXISTS, includeBuf, ORI, CSQ_PAUSE);
-        char buf[2 * CM_PATH_MAX];
-        snprintf(buf, sizeof(buf), "Overwrite '%s'? (this may be irreversible)", includeBuf);
-        if (!gsPrivatePrompt(buf))
-        {
-            lgInternalLogWithArg(ERROR, ORI, CSE_FILE_ALREADY_EXISTS, includeBuf, ORI, CSQ_ABORT);
-            return RES_USER_ABORT;
-        }
+        return result;
     }
 
-
     // Create directories if needed
-    if (createSrcDir)
+    if (createSrcDir && (result = gsPrivateCreateDir(args.srcPath)) != RES_OK)
     {
-        if (cmCreateDir(args.srcPath) != RES_OK)
-        {
-            lgInternalLogWithArg(FATAL, ORI, CSE_CREATE_DIR_FAIL, args.srcPath, ORI, CSQ_ABORT);
-            return RES_CREATE_DIR_FAIL;
-        }
-        lgInternalLogWithArg(INFO, ORI, CSE_DIR_CREATE, args.srcPath, ORI, CSQ_SUCCESS);
+        return result;
     }
-    if (createIncludeDir)
+    if (createIncludeDir && (result = gsPrivateCreateDir(args.includePath)) != RES_OK)
     {
-        if (cmCreateDir(args.includePath) != RES_OK)
-        {
-            lgInternalLogWithArg(FATAL, ORI, CSE_CREATE_DIR_FAIL, args.includePath, ORI, CSQ_ABORT);
-            return RES_CREATE_DIR_FAIL;
-        }
-        lgInternalLogWithArg(INFO, ORI, CSE_DIR_CREATE, args.includePath, ORI, CSQ_SUCCESS);
+        return result;
     }
 
     FILE *srcFile = tsFopen(srcBuf, "w");
@@ -17,6 +17,7 @@
 // Includes
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 
+#include <stdint.h>
 #include <stdio.h>
 
 
@@ -27,6 +28,9 @@
 #define DEFAULT_SRC_DIR     "src"
 #define DEFAULT_INCLUDE_DIR "include"
 #define GS_NAME_MAX         64
+#define GS_REGISTRY_NAME    "SceneRegistry"
+#define GS_KEYS_PER_BUCKET  2
+#define GS_SEED_SEARCH_MAX  1000000u
 #define GS_SECTION_DIV      "// —————————————————————————————————————————————————————————————————————————————————————————————————"
 
 
@@ -48,6 +52,8 @@ typedef enum
     RES_INVALID_FLAG = -100,
     RES_NO_CALLBACKS = -101,
     RES_USER_ABORT = -102,
+    RES_NO_PERFECT_HASH = -103,
+    RES_NO_SCENES = -104,
 } gsInternalResult;
 
 /**
@@ -68,6 +74,35 @@ typedef struct
     bool noExit;
 } gsInternalArgs;
 
+/**
+ * @brief A scene found while scanning a directory for the scene registry.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    char name[GS_NAME_MAX];
+
+    bool hasEnter;
+    bool hasUpdate;
+    bool hasDraw;
+    bool hasExit;
+} gsInternalRegistryScene;
+
+/**
+ * @brief State of a directory scan for the scene registry.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    const char *dir;
+    gsInternalRegistryScene *scenes;
+    size_t count;
+    size_t capacity;
+    int result;
+} gsInternalRegistryScan;
+
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Prototypes
@@ -96,6 +131,32 @@ typedef struct
  */
 int gsInternalSanitizeName(char *buf, size_t bufSize, const char *name);
 
+/**
+ * @brief Builds a minimal perfect hash over a set of distinct names.
+ *
+ * Uses hash and displace: each name falls in bucket
+ * `cmHashString(name, 0) % seedCount`, and buckets, largest first, get the
+ * smallest seed that sends all their names to free slots through
+ * `cmHashString(name, seed) % count`.
+ *
+ * @param names     Names to hash. Must be distinct.
+ * @param count     Number of names, which is also the number of slots.
+ * @param seeds     Output array of @p seedCount seeds, one per bucket.
+ * @param seedCount Number of buckets.
+ * @param slots     Output array of @p count slots, one per name.
+ *
+ * @return `RES_OK` on success, or a negative error code on failure.
+ *
+ * @note Fails if: any pointer is NULL (`RES_NULL_ARG`); @p count or
+ *       @p seedCount is zero (`RES_INVALID_ARG`); memory allocation fails
+ *       (`RES_MEM_ALLOC_FAIL`); or no seed under `GS_SEED_SEARCH_MAX` fits a
+ *       bucket (`RES_NO_PERFECT_HASH`).
+ *
+ * @author Vitor Betmann
+ */
+int gsInternalBuildPerfectHash(const char *const *names, size_t count, uint32_t *seeds,
+                               size_t seedCount, size_t *slots);
+
 /**
  * @brief Fatal handler for the GenScene tool.
  *
@@ -116,6 +177,10 @@ void gsInternalFatalHandler(void);
  * files, then generates a `.c` source file and a `.h` header file containing
  * stubbed scene-lifecycle callbacks.
  *
+ * With `--registry <dir>` as first flag, scans the scene headers in `<dir>`
+ * instead and generates `SceneRegistry.c` and `SceneRegistry.h`, holding a
+ * compile-time scene table and its minimal perfect hash.
+ *
  * @param argc Number of command-line arguments.
  * @param argv Array of command-line argument strings.
  *
@@ -127,8 +192,10 @@ void gsInternalFatalHandler(void);
  *       unknown flag is supplied (`RES_INVALID_FLAG`); all callbacks are
  *       disabled (`RES_NO_CALLBACKS`); the user declines a prompt
  *       (`RES_USER_ABORT`); a directory cannot be created
- *       (`RES_CREATE_DIR_FAIL`); or a file cannot be written
- *       (`RES_CREATE_FILE_FAIL`).
+ *       (`RES_CREATE_DIR_FAIL`); a file cannot be written
+ *       (`RES_CREATE_FILE_FAIL`); or, in registry mode, the scanned directory
+ *       does not exist (`RES_DIR_NOT_FOUND`), holds no scenes
+ *       (`RES_NO_SCENES`), or cannot be hashed (`RES_NO_PERFECT_HASH`).
  * @note Side effects: may create directories and files on the filesystem;
  *       reads user input interactively via `scanf`.
  *
@@ -27,6 +27,8 @@
 #define CSE_NO_CALLBACKS "Scene Has No Callbacks"
 #define CSE_FLAG_REQ_PATH_ARG "Flag Requires Path Argument"
 #define CSE_INVALID_FLAG "Invalid Flag"
+#define CSE_NO_SCENES "No Scenes Found In"
+#define CSE_NO_PERFECT_HASH "Could Not Build Perfect Hash"
 
 
 #endif
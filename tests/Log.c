@@ -105,12 +105,12 @@ void Test_lgInternalLog_WarningReturnsSuccess(void)
 int main(void)
 {
     puts("\nLOG API TESTING");
-    Test_lgLog_SucceedsWithValidMessage();
-    Test_lgLog_FailsWithNullMessage();
-    Test_lgSetFatal_SucceedsWithNullHandler();
-    Test_lgInternalLog_FatalInvokesCustomHandler();
-    Test_lgInternalLog_InfoReturnsSuccess();
-    Test_lgInternalLog_WarningReturnsSuccess();
+    tsRun(Test_lgLog_SucceedsWithValidMessage);
+    tsRun(Test_lgLog_FailsWithNullMessage);
+    tsRun(Test_lgSetFatal_SucceedsWithNullHandler);
+    tsRun(Test_lgInternalLog_FatalInvokesCustomHandler);
+    tsRun(Test_lgInternalLog_InfoReturnsSuccess);
+    tsRun(Test_lgInternalLog_WarningReturnsSuccess);
 
     puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
     return 0;
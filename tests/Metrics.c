@@ -0,0 +1,517 @@
+/**
+ * @file
+ * @brief Implementation of the Metrics API Tests.
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+// Module Related
+#include "Metrics.h"
+#include "MetricsInternal.h"
+// Support
+#include "internal/Common/Common.h"
+#include "internal/Common/CommonThreads.h"
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef NDEBUG
+#error "TestAPIMetrics must be compiled without NDEBUG (asserts required)."
+#endif
+
+#define SNAPSHOT_PATH "mttest_snapshot"
+#define THREAD_COUNT 4
+#define INCREMENTS 100000
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Variables
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static mtMetricId sharedId;
+static char snapshot[4096];
+static size_t snapshotSize;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static void setup(void)
+{
+    if (!mtIsRunning())
+    {
+        mtStart();
+    }
+}
+
+static void teardown(void)
+{
+    if (mtIsRunning())
+    {
+        mtStop();
+    }
+    remove(SNAPSHOT_PATH);
+}
+
+// Writes the running session and loads the file into `snapshot`.
+static void writeAndRead(mtSnapshotFormat format)
+{
+    assert(mtWriteSnapshot(SNAPSHOT_PATH, format) == RES_OK);
+
+    FILE *file = fopen(SNAPSHOT_PATH, "rb");
+    assert(file);
+    snapshotSize = fread(snapshot, 1, sizeof(snapshot) - 1, file);
+    assert(feof(file));
+    snapshot[snapshotSize] = '\0';
+    fclose(file);
+}
+
+static void mockAddCounter(void *args)
+{
+    for (int i = 0; i < INCREMENTS; i++)
+    {
+        mtAddCounter(sharedId, 1);
+    }
+}
+
+static void mockRecordHistogram(void *args)
+{
+    for (uint64_t i = 1; i <= INCREMENTS; i++)
+    {
+        mtRecordHistogram(sharedId, i);
+    }
+}
+
+// Checks a percentile against the exact one within the buckets' 1/8 error.
+static bool isNear(uint64_t value, uint64_t exact)
+{
+    return value * 8 >= exact * 7 && value * 8 <= exact * 9;
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Start Related
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_mtStart_Succeeds(void)
+{
+    assert(mtStart() == RES_OK);
+    assert(mtIsRunning());
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtStart_FailsIfAlreadyRunning(void)
+{
+    setup();
+    assert(mtStart() == RES_ALREADY_RUNNING);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtIsRunning_ReturnsFalseIfNotRunning(void)
+{
+    assert(!mtIsRunning());
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Registry Related
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_mtCreateCounter_FailsIfNotRunning(void)
+{
+    mtMetricId id;
+    assert(mtCreateCounter("counter", &id) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+void Test_mtCreateCounter_FailsWithInvalidArgs(void)
+{
+    setup();
+    mtMetricId id;
+    assert(mtCreateCounter(nullptr, &id) == RES_NULL_ARG);
+    assert(mtCreateCounter("", &id) == RES_EMPTY_ARG);
+    assert(mtCreateCounter("counter", nullptr) == RES_NULL_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtCreateCounter_ReturnsExistingHandleForSameName(void)
+{
+    setup();
+    mtMetricId first, second;
+    assert(mtCreateCounter("counter", &first) == RES_OK);
+    assert(mtCreateCounter("counter", &second) == RES_OK);
+    assert(first != 0 && first == second);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtCreateGauge_FailsIfNameUsedByAnotherKind(void)
+{
+    setup();
+    mtMetricId id;
+    assert(mtCreateCounter("metric", &id) == RES_OK);
+    assert(mtCreateGauge("metric", &id) == RES_METRIC_KIND_MISMATCH);
+    assert(mtCreateHistogram("metric", &id) == RES_METRIC_KIND_MISMATCH);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtCreateHistogram_FailsWhenRegistryIsFull(void)
+{
+    setup();
+    mtMetricId id;
+    char name[16];
+    for (int i = 0; i < METRICS_MAX; i++)
+    {
+        snprintf(name, sizeof(name), "metric%d", i);
+        assert(mtCreateHistogram(name, &id) == RES_OK);
+    }
+    assert(mtCreateHistogram("one too many", &id) == RES_METRIC_LIMIT_REACHED);
+    assert(mtCreateHistogram("metric0", &id) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtCreateCounter_FailsIfMallocFails(void)
+{
+    setup();
+    mtMetricId id;
+    tsDisable(MALLOC, 1);
+    assert(mtCreateCounter("counter", &id) == RES_MEM_ALLOC_FAIL);
+    assert(mtCreateCounter("counter", &id) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Counters and Gauges
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_mtAddCounter_MergesEveryThread(void)
+{
+    setup();
+    assert(mtCreateCounter("counter", &sharedId) == RES_OK);
+    mtAddCounter(sharedId, 5);
+
+    cmThread threads[THREAD_COUNT];
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        assert(cmCreateThread(&threads[i], mockAddCounter, nullptr) == RES_OK);
+    }
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        cmJoinThread(&threads[i]);
+    }
+
+    uint64_t value;
+    assert(mtGetCounter(sharedId, &value) == RES_OK);
+    assert(value == 5 + THREAD_COUNT * INCREMENTS);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtAddCounter_RetriesSlotsAfterCallocFails(void)
+{
+    setup();
+    mtMetricId id;
+    assert(mtCreateCounter("counter", &id) == RES_OK);
+    tsDisable(CALLOC, 1);
+    mtAddCounter(id, 5);
+    mtAddCounter(id, 3);
+
+    uint64_t value;
+    assert(mtGetCounter(id, &value) == RES_OK);
+    assert(value == 3);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtAddCounter_IgnoresOtherKindsAndStaleHandles(void)
+{
+    setup();
+    mtMetricId gauge, stale;
+    assert(mtCreateGauge("gauge", &gauge) == RES_OK);
+    assert(mtCreateCounter("counter", &stale) == RES_OK);
+    mtAddCounter(gauge, 1);
+    mtAddCounter(0, 1);
+    teardown();
+
+    // The new session reuses the slot, but not the handle.
+    setup();
+    mtMetricId fresh;
+    assert(mtCreateCounter("counter", &fresh) == RES_OK);
+    assert(fresh != stale);
+    mtAddCounter(stale, 1);
+
+    uint64_t value;
+    assert(mtGetCounter(fresh, &value) == RES_OK && value == 0);
+    assert(mtGetCounter(stale, &value) == RES_METRIC_NOT_FOUND);
+    assert(mtGetCounter(gauge, &value) == RES_METRIC_NOT_FOUND);
+    assert(mtGetCounter(fresh, nullptr) == RES_NULL_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtSetGauge_KeepsLastValue(void)
+{
+    setup();
+    mtMetricId id;
+    assert(mtCreateGauge("gauge", &id) == RES_OK);
+
+    int64_t value;
+    assert(mtGetGauge(id, &value) == RES_OK && value == 0);
+    mtSetGauge(id, 7);
+    mtSetGauge(id, -3);
+    assert(mtGetGauge(id, &value) == RES_OK && value == -3);
+    assert(mtGetGauge(id, nullptr) == RES_NULL_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Histograms
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_mtGetHistogram_ReturnsZerosWhenEmpty(void)
+{
+    setup();
+    mtMetricId id;
+    assert(mtCreateHistogram("histogram", &id) == RES_OK);
+
+    mtHistogramSummary summary;
+    assert(mtGetHistogram(id, &summary) == RES_OK);
+    assert(summary.count == 0 && summary.min == 0 && summary.max == 0 && summary.p99 == 0);
+    assert(mtGetHistogram(id, nullptr) == RES_NULL_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtRecordHistogram_SummarizesEveryThread(void)
+{
+    setup();
+    assert(mtCreateHistogram("histogram", &sharedId) == RES_OK);
+    mtRecordHistogram(sharedId, 0);
+
+    cmThread threads[THREAD_COUNT];
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        assert(cmCreateThread(&threads[i], mockRecordHistogram, nullptr) == RES_OK);
+    }
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        cmJoinThread(&threads[i]);
+    }
+
+    mtHistogramSummary summary;
+    assert(mtGetHistogram(sharedId, &summary) == RES_OK);
+    assert(summary.count == 1 + THREAD_COUNT * INCREMENTS);
+    assert(summary.sum == THREAD_COUNT * (uint64_t)INCREMENTS * (INCREMENTS + 1) / 2);
+    assert(summary.min == 0);
+    assert(summary.max == INCREMENTS);
+    assert(isNear(summary.p50, INCREMENTS / 2));
+    assert(isNear(summary.p90, INCREMENTS * 9 / 10));
+    assert(isNear(summary.p99, INCREMENTS * 99 / 100));
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtRecordHistogram_KeepsSmallValuesExact(void)
+{
+    setup();
+    mtMetricId id;
+    assert(mtCreateHistogram("histogram", &id) == RES_OK);
+    for (uint64_t i = 1; i <= 10; i++)
+    {
+        mtRecordHistogram(id, i);
+    }
+    mtRecordHistogram(id, UINT64_MAX);
+
+    mtHistogramSummary summary;
+    assert(mtGetHistogram(id, &summary) == RES_OK);
+    assert(summary.count == 11 && summary.min == 1 && summary.max == UINT64_MAX);
+    assert(summary.p50 == 6);
+    assert(summary.p90 == 10);
+    teardown();
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Snapshot Related
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_mtWriteSnapshot_FailsIfNotRunning(void)
+{
+    assert(mtWriteSnapshot(SNAPSHOT_PATH, MT_SNAPSHOT_TEXT) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+void Test_mtWriteSnapshot_FailsWithInvalidArgs(void)
+{
+    setup();
+    assert(mtWriteSnapshot(nullptr, MT_SNAPSHOT_TEXT) == RES_NULL_ARG);
+    assert(mtWriteSnapshot("", MT_SNAPSHOT_TEXT) == RES_EMPTY_ARG);
+    assert(mtWriteSnapshot(SNAPSHOT_PATH, (mtSnapshotFormat)-1) == RES_INVALID_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtWriteSnapshot_FailsIfFileCannotBeCreated(void)
+{
+    setup();
+    tsDisable(FOPEN, 1);
+    assert(mtWriteSnapshot(SNAPSHOT_PATH, MT_SNAPSHOT_TEXT) == RES_CREATE_FILE_FAIL);
+    assert(!cmFileExists(SNAPSHOT_PATH));
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtWriteSnapshot_WritesText(void)
+{
+    setup();
+    mtMetricId counter, gauge, histogram;
+    assert(mtCreateCounter("frames", &counter) == RES_OK);
+    assert(mtCreateGauge("scenes", &gauge) == RES_OK);
+    assert(mtCreateHistogram("frame_ns", &histogram) == RES_OK);
+    mtAddCounter(counter, 3);
+    mtSetGauge(gauge, -2);
+    mtRecordHistogram(histogram, 4);
+
+    writeAndRead(MT_SNAPSHOT_TEXT);
+    assert(strcmp(snapshot, "# smile metrics v1\n"
+                            "counter frames 3\n"
+                            "gauge scenes -2\n"
+                            "histogram frame_ns count=1 sum=4 min=4 p50=4 p90=4 p99=4 max=4\n") == 0);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_mtWriteSnapshot_WritesBinary(void)
+{
+    setup();
+    mtMetricId counter, histogram;
+    assert(mtCreateCounter("c", &counter) == RES_OK);
+    assert(mtCreateHistogram("h", &histogram) == RES_OK);
+    mtAddCounter(counter, 9);
+    mtRecordHistogram(histogram, 3);
+    mtRecordHistogram(histogram, 3);
+
+    writeAndRead(MT_SNAPSHOT_BINARY);
+    const unsigned char *at = (const unsigned char *)snapshot;
+    assert(memcmp(at, "SMMT", 4) == 0);
+    uint32_t header[2];
+    memcpy(header, at + 4, sizeof(header));
+    assert(header[0] == 1 && header[1] == 2);
+    at += 4 + sizeof(header);
+
+    // Counter: kind, name length, name, value.
+    uint16_t nameLength;
+    uint64_t value;
+    assert(at[0] == MT_KIND_COUNTER);
+    memcpy(&nameLength, at + 1, sizeof(nameLength));
+    assert(nameLength == 1 && at[3] == 'c');
+    memcpy(&value, at + 4, sizeof(value));
+    assert(value == 9);
+    at += 4 + sizeof(value);
+
+    // Histogram: kind, name, count, sum, min, max, used buckets, then pairs.
+    uint64_t totals[4];
+    uint16_t usedBuckets, bucket;
+    assert(at[0] == MT_KIND_HISTOGRAM && at[3] == 'h');
+    memcpy(totals, at + 4, sizeof(totals));
+    assert(totals[0] == 2 && totals[1] == 6 && totals[2] == 3 && totals[3] == 3);
+    at += 4 + sizeof(totals);
+    memcpy(&usedBuckets, at, sizeof(usedBuckets));
+    memcpy(&bucket, at + 2, sizeof(bucket));
+    memcpy(&value, at + 4, sizeof(value));
+    assert(usedBuckets == 1 && bucket == 3 && value == 2);
+    assert(at + 4 + sizeof(value) == (const unsigned char *)snapshot + snapshotSize);
+    teardown();
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Stop Related
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_mtStop_Succeeds(void)
+{
+    setup();
+    assert(mtStop() == RES_OK);
+    assert(!mtIsRunning());
+    tsPass(__func__);
+}
+
+void Test_mtStop_FailsIfNotRunning(void)
+{
+    assert(mtStop() == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(void)
+{
+    puts("\nMETRICS TESTING");
+
+    puts("\n• Start Related");
+    tsRun(Test_mtStart_Succeeds);
+    tsRun(Test_mtStart_FailsIfAlreadyRunning);
+    tsRun(Test_mtIsRunning_ReturnsFalseIfNotRunning);
+
+    puts("\n• Registry Related");
+    tsRun(Test_mtCreateCounter_FailsIfNotRunning);
+    tsRun(Test_mtCreateCounter_FailsWithInvalidArgs);
+    tsRun(Test_mtCreateCounter_ReturnsExistingHandleForSameName);
+    tsRun(Test_mtCreateGauge_FailsIfNameUsedByAnotherKind);
+    tsRun(Test_mtCreateHistogram_FailsWhenRegistryIsFull);
+    tsRun(Test_mtCreateCounter_FailsIfMallocFails);
+
+    puts("\n• Counters and Gauges");
+    tsRun(Test_mtAddCounter_MergesEveryThread);
+    tsRun(Test_mtAddCounter_RetriesSlotsAfterCallocFails);
+    tsRun(Test_mtAddCounter_IgnoresOtherKindsAndStaleHandles);
+    tsRun(Test_mtSetGauge_KeepsLastValue);
+
+    puts("\n• Histograms");
+    tsRun(Test_mtGetHistogram_ReturnsZerosWhenEmpty);
+    tsRun(Test_mtRecordHistogram_SummarizesEveryThread);
+    tsRun(Test_mtRecordHistogram_KeepsSmallValuesExact);
+
+    puts("\n• Snapshot Related");
+    tsRun(Test_mtWriteSnapshot_FailsIfNotRunning);
+    tsRun(Test_mtWriteSnapshot_FailsWithInvalidArgs);
+    tsRun(Test_mtWriteSnapshot_FailsIfFileCannotBeCreated);
+    tsRun(Test_mtWriteSnapshot_WritesText);
+    tsRun(Test_mtWriteSnapshot_WritesBinary);
+
+    puts("\n• Stop Related");
+    tsRun(Test_mtStop_Succeeds);
+    tsRun(Test_mtStop_FailsIfNotRunning);
+
+    puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
+    return 0;
+}
@@ -0,0 +1,458 @@
+/**
+ * @file
+ * @brief Implementation of the Profiler API Tests.
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+// Module Related
+#include "Profiler.h"
+#include "ProfilerInternal.h"
+// Support
+#include "internal/Common/Common.h"
+#include "internal/Common/CommonThreads.h"
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef NDEBUG
+#error "TestAPIProfiler must be compiled without NDEBUG (asserts required)."
+#endif
+
+#define TRACE_PATH "pftest_trace.json"
+#define TRACE_MAX_SIZE (8 * 1024 * 1024)
+#define STACKS_PATH "pftest_stacks.folded"
+#define SAMPLING_HZ 1000
+#define BURN_SECONDS 0.3
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Variables
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static char trace[TRACE_MAX_SIZE];
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static void setup(void)
+{
+    if (!pfIsRunning())
+    {
+        pfStart();
+    }
+}
+
+static void teardown(void)
+{
+    if (pfIsRunning())
+    {
+        pfStop();
+    }
+    remove(TRACE_PATH);
+    remove(STACKS_PATH);
+}
+
+// Exports the running session and loads the file into `trace`.
+static void exportAndRead(void)
+{
+    assert(pfExportTrace(TRACE_PATH) == RES_OK);
+
+    FILE *file = fopen(TRACE_PATH, "r");
+    assert(file);
+    const size_t SIZE = fread(trace, 1, sizeof(trace) - 1, file);
+    assert(feof(file));
+    trace[SIZE] = '\0';
+    fclose(file);
+}
+
+static int countOccurrences(const char *needle)
+{
+    int count = 0;
+    for (const char *at = strstr(trace, needle); at; at = strstr(at + 1, needle))
+    {
+        count++;
+    }
+    return count;
+}
+
+static void mockWorkerZone(void *args)
+{
+    PF_BEGIN_ZONE("Worker Zone");
+    PF_END_ZONE();
+}
+
+// Not static, so the dynamic symbol table names it in sampled stacks.
+void mockBurnCpu(void)
+{
+    volatile uint64_t sink = 0;
+    const clock_t END = clock() + (clock_t)(BURN_SECONDS * CLOCKS_PER_SEC);
+    while (clock() < END)
+    {
+        for (int i = 0; i < 10000; i++)
+        {
+            sink += (uint64_t)i;
+        }
+    }
+}
+
+// Reads STACKS_PATH into `trace`, checking every line ends in a positive count.
+static uint64_t readFoldedStacks(void)
+{
+    FILE *file = fopen(STACKS_PATH, "r");
+    assert(file);
+    const size_t SIZE = fread(trace, 1, sizeof(trace) - 1, file);
+    trace[SIZE] = '\0';
+    fclose(file);
+
+    uint64_t total = 0;
+    for (const char *line = trace; *line;)
+    {
+        const char *end = strchr(line, '\n');
+        assert(end);
+        const char *count = end;
+        while (count > line && count[-1] != ' ')
+        {
+            count--;
+        }
+        assert(count > line && count < end);
+        const uint64_t SAMPLES = strtoull(count, nullptr, 10);
+        assert(SAMPLES > 0);
+        total += SAMPLES;
+        line = end + 1;
+    }
+    return total;
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Start Related
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_pfStart_Succeeds(void)
+{
+    assert(pfStart() == RES_OK);
+    assert(pfIsRunning());
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfStart_FailsIfAlreadyRunning(void)
+{
+    setup();
+    assert(pfStart() == RES_ALREADY_RUNNING);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfIsRunning_ReturnsFalseIfNotRunning(void)
+{
+    assert(!pfIsRunning());
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Export Related
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_pfExportTrace_FailsIfNotRunning(void)
+{
+    assert(pfExportTrace(TRACE_PATH) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+void Test_pfExportTrace_FailsWithNullPath(void)
+{
+    setup();
+    assert(pfExportTrace(nullptr) == RES_NULL_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfExportTrace_FailsWithEmptyPath(void)
+{
+    setup();
+    assert(pfExportTrace("") == RES_EMPTY_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfExportTrace_FailsIfFileCannotBeCreated(void)
+{
+    setup();
+    tsDisable(FOPEN, 1);
+    assert(pfExportTrace(TRACE_PATH) == RES_CREATE_FILE_FAIL);
+    assert(!cmFileExists(TRACE_PATH));
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfExportTrace_WritesNestedZones(void)
+{
+    setup();
+    PF_BEGIN_ZONE("Outer");
+    PF_BEGIN_ZONE("Inner \"Quoted\"");
+    PF_END_ZONE();
+    PF_END_ZONE();
+
+    exportAndRead();
+    assert(strncmp(trace, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 38) == 0);
+    assert(countOccurrences("\"ph\":\"E\"") == countOccurrences("\"ph\":\"B\""));
+    assert(countOccurrences("\"name\":\"Outer\"") == 1);
+    assert(countOccurrences("\"name\":\"Inner \\\"Quoted\\\"\"") == 1);
+    assert(strstr(trace, "\"Outer\"") < strstr(trace, "Inner"));
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfExportTrace_SeparatesThreads(void)
+{
+    setup();
+    PF_BEGIN_ZONE("Main Zone");
+    PF_END_ZONE();
+
+    cmThread thread;
+    assert(cmCreateThread(&thread, mockWorkerZone, nullptr) == RES_OK);
+    cmJoinThread(&thread);
+
+    exportAndRead();
+    assert(countOccurrences("\"ph\":\"M\"") == 2);
+    assert(countOccurrences("\"name\":\"Main Zone\",\"ph\":\"B\",\"pid\":1,\"tid\":0") == 1);
+    assert(countOccurrences("\"name\":\"Worker Zone\",\"ph\":\"B\",\"pid\":1,\"tid\":1") == 1);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfExportTrace_StaysBalancedWhenBufferFills(void)
+{
+    setup();
+    const int DEPTH = PROFILER_EVENTS_PER_THREAD;
+    for (int i = 0; i < DEPTH; i++)
+    {
+        PF_BEGIN_ZONE("Deep");
+    }
+    for (int i = 0; i < DEPTH; i++)
+    {
+        PF_END_ZONE();
+    }
+
+    exportAndRead();
+    const int BEGIN_COUNT = countOccurrences("\"ph\":\"B\"");
+    assert(BEGIN_COUNT > 0 && BEGIN_COUNT < DEPTH);
+    assert(countOccurrences("\"ph\":\"E\"") == BEGIN_COUNT);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfExportTrace_RetriesBufferAfterMallocFails(void)
+{
+    setup();
+    tsDisable(MALLOC, 1);
+    PF_BEGIN_ZONE("Dropped");
+    PF_END_ZONE();
+    PF_BEGIN_ZONE("Kept");
+    PF_END_ZONE();
+
+    exportAndRead();
+    assert(countOccurrences("Dropped") == 0);
+    assert(countOccurrences("\"name\":\"Kept\"") == 1);
+    assert(countOccurrences("\"ph\":\"E\"") == countOccurrences("\"ph\":\"B\""));
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfExportTrace_IgnoresZonesOutsideSession(void)
+{
+    PF_BEGIN_ZONE("Before Start");
+    setup();
+    PF_END_ZONE();
+    exportAndRead();
+    assert(countOccurrences("Before Start") == 0);
+    assert(countOccurrences("\"ph\":\"E\"") == countOccurrences("\"ph\":\"B\""));
+    teardown();
+
+    // A zone left open by an earlier session must not leak into the next one.
+    setup();
+    PF_BEGIN_ZONE("Left Open");
+    pfStop();
+    setup();
+    PF_END_ZONE();
+    exportAndRead();
+    assert(countOccurrences("Left Open") == 0);
+    assert(countOccurrences("\"ph\":\"E\"") == countOccurrences("\"ph\":\"B\""));
+    teardown();
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Sampling Related
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_pfStartSampling_FailsIfNotRunning(void)
+{
+    assert(pfStartSampling(SAMPLING_HZ, nullptr) == RES_NOT_RUNNING);
+    assert(!pfIsSampling());
+    tsPass(__func__);
+}
+
+void Test_pfStartSampling_RejectsInvalidArgs(void)
+{
+    setup();
+    assert(pfStartSampling(0, nullptr) == RES_INVALID_ARG);
+    assert(pfStartSampling(PROFILER_SAMPLING_HZ_MAX + 1, nullptr) == RES_INVALID_ARG);
+    assert(pfStartSampling(SAMPLING_HZ, "") == RES_EMPTY_ARG);
+    assert(!pfIsSampling());
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfStartSampling_FailsIfAlreadySampling(void)
+{
+    setup();
+    const int RESULT = pfStartSampling(SAMPLING_HZ, nullptr);
+    assert(RESULT == RES_OK || RESULT == RES_SAMPLING_UNSUPPORTED);
+    if (RESULT == RES_OK)
+    {
+        assert(pfIsSampling());
+        assert(pfStartSampling(SAMPLING_HZ, nullptr) == RES_ALREADY_RUNNING);
+        assert(pfStopSampling() == RES_OK);
+    }
+    assert(!pfIsSampling());
+    assert(pfStopSampling() == RES_NOT_RUNNING);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfWriteFoldedStacks_FailsWithInvalidPath(void)
+{
+    assert(pfWriteFoldedStacks(STACKS_PATH) == RES_NOT_RUNNING);
+    setup();
+    assert(pfWriteFoldedStacks(nullptr) == RES_NULL_ARG);
+    assert(pfWriteFoldedStacks("") == RES_EMPTY_ARG);
+    tsDisable(FOPEN, 1);
+    assert(pfWriteFoldedStacks(STACKS_PATH) == RES_CREATE_FILE_FAIL);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_pfWriteFoldedStacks_WritesTaggedStacks(void)
+{
+    setup();
+    pfInternalSetSampleTag("Busy;Tag");
+    if (pfStartSampling(SAMPLING_HZ, nullptr) != RES_OK)
+    {
+        // Nothing is sampled off Linux, but writing must still succeed.
+        assert(pfWriteFoldedStacks(STACKS_PATH) == RES_OK);
+        assert(readFoldedStacks() == 0);
+        pfInternalSetSampleTag(nullptr);
+        teardown();
+        tsPass(__func__);
+        return;
+    }
+
+    mockBurnCpu();
+    assert(pfStopSampling() == RES_OK);
+    pfInternalSetSampleTag(nullptr);
+
+    assert(pfWriteFoldedStacks(STACKS_PATH) == RES_OK);
+    const uint64_t TOTAL = readFoldedStacks();
+    assert(TOTAL > 0);
+    assert(strncmp(trace, "Busy:Tag;", 9) == 0);
+    assert(strstr(trace, ";mockBurnCpu"));
+
+    // Stopping keeps the samples for later writes.
+    assert(pfWriteFoldedStacks(STACKS_PATH) == RES_OK);
+    assert(readFoldedStacks() == TOTAL);
+    teardown();
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Stop Related
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_pfStop_Succeeds(void)
+{
+    setup();
+    assert(pfStop() == RES_OK);
+    assert(!pfIsRunning());
+    tsPass(__func__);
+}
+
+void Test_pfStop_StopsSampling(void)
+{
+    setup();
+    if (pfStartSampling(SAMPLING_HZ, nullptr) == RES_OK)
+    {
+        assert(pfIsSampling());
+    }
+    assert(pfStop() == RES_OK);
+    assert(!pfIsSampling());
+    tsPass(__func__);
+}
+
+void Test_pfStop_FailsIfNotRunning(void)
+{
+    assert(pfStop() == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(void)
+{
+    puts("\nPROFILER TESTING");
+
+    puts("\n• Start Related");
+    tsRun(Test_pfStart_Succeeds);
+    tsRun(Test_pfStart_FailsIfAlreadyRunning);
+    tsRun(Test_pfIsRunning_ReturnsFalseIfNotRunning);
+
+    puts("\n• Export Related");
+    tsRun(Test_pfExportTrace_FailsIfNotRunning);
+    tsRun(Test_pfExportTrace_FailsWithNullPath);
+    tsRun(Test_pfExportTrace_FailsWithEmptyPath);
+    tsRun(Test_pfExportTrace_FailsIfFileCannotBeCreated);
+    tsRun(Test_pfExportTrace_WritesNestedZones);
+    tsRun(Test_pfExportTrace_SeparatesThreads);
+    tsRun(Test_pfExportTrace_StaysBalancedWhenBufferFills);
+    tsRun(Test_pfExportTrace_RetriesBufferAfterMallocFails);
+    tsRun(Test_pfExportTrace_IgnoresZonesOutsideSession);
+
+    puts("\n• Sampling Related");
+    tsRun(Test_pfStartSampling_FailsIfNotRunning);
+    tsRun(Test_pfStartSampling_RejectsInvalidArgs);
+    tsRun(Test_pfStartSampling_FailsIfAlreadySampling);
+    tsRun(Test_pfWriteFoldedStacks_FailsWithInvalidPath);
+    tsRun(Test_pfWriteFoldedStacks_WritesTaggedStacks);
+
+    puts("\n• Stop Related");
+    tsRun(Test_pfStop_Succeeds);
+    tsRun(Test_pfStop_StopsSampling);
+    tsRun(Test_pfStop_FailsIfNotRunning);
+
+    puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
+    return 0;
+}
@@ -16,12 +16,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 // Module Related
+#include "Metrics.h"
+#include "Profiler.h"
+#include "ProfilerInternal.h"
 #include "SceneManager.h"
 #include "SceneManagerInternal.h"
 #include "SceneManagerTestHooks.h"
 // Support
 #include "internal/Common/Common.h"
+#include "internal/Common/CommonJobs.h"
 #include "internal/Test/Test.h"
 
 
@@ -33,8 +38,6 @@
 #error "TestAPISceneManager must be compiled without NDEBUG (asserts required)."
 #endif
 
-#define NS_PER_S 1000000000L
-
 #define DT_TOLERANCE 1e-6f
 #define EXPECTED_DT_NS 16667000L
 #define EXPECTED_DT_S  0.016667f
@@ -42,6 +45,30 @@
 #define FRAME_TIME_ITERATIONS 300
 #define IDEMPOTENT_ITERATIONS 3
 #define STRESS_ITERATIONS 1000
+#define STEADY_FRAMES 100
+
+#define SUSPEND_COST 10
+
+#define LOAD_BUDGET_MS 4.0f
+#define LOAD_STEPS 10
+#define LOAD_STEP_NS 1000000L
+
+#define REGISTRY_SIZE 3
+
+#define PACED_FPS 100
+#define PACED_FRAME_NS 10000000L
+#define CLOCK_SPAN_NS 20000000LL
+#define CLOCK_TOLERANCE_NS 5000000LL
+#define IDLE_STEPS 10
+#define IDLE_STEP_NS 1000000L
+
+#define TIMER_STEP_MS 4
+
+#define EASE_TOLERANCE 1e-6f
+
+#define SAMPLES_PATH "smtest_samples.folded"
+#define SAMPLING_HZ 1000
+#define BURN_SECONDS 0.2
 
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
@@ -70,6 +97,170 @@ static void mockExit(void)
     // Mock Exit
 }
 
+static void mockSuspend(void)
+{
+    smMockData->suspendCount++;
+}
+
+static void mockResume(void *args)
+{
+    smMockData->resumeCount++;
+}
+
+static void advanceMockTime(long ns)
+{
+    smMockCurrTime.tv_nsec += ns;
+    if (smMockCurrTime.tv_nsec >= NS_PER_S)
+    {
+        smMockCurrTime.tv_sec += smMockCurrTime.tv_nsec / NS_PER_S;
+        smMockCurrTime.tv_nsec %= NS_PER_S;
+    }
+}
+
+// Advances the mock clock by one frame of the given length and measures it.
+static float nextDt(long frameNs)
+{
+    advanceMockTime(frameNs);
+    return smGetDt();
+}
+
+static long mockTimeNs(void)
+{
+    return smMockCurrTime.tv_sec * NS_PER_S + smMockCurrTime.tv_nsec;
+}
+
+// Each call takes one millisecond of mock time.
+static bool mockLoad(void *args)
+{
+    smMockData->loadCount++;
+    advanceMockTime(LOAD_STEP_NS);
+    return smMockData->loadCount >= LOAD_STEPS;
+}
+
+static bool mockLoadAtOnce(void *args)
+{
+    return true;
+}
+
+static bool mockLoadThenStop(void *args)
+{
+    assert(smStop() == RES_OK);
+    return false;
+}
+
+static bool mockLoadThenSwitchBack(void *args)
+{
+    assert(smSetScene("mock", nullptr) == RES_OK);
+    return true;
+}
+
+static void mockEnterThenStop(void *args)
+{
+    assert(smStop() == RES_OK);
+}
+
+// Each call takes one millisecond of mock time.
+static bool mockIdle(void *args)
+{
+    smMockData->idleCount++;
+    advanceMockTime(IDLE_STEP_NS);
+    return smMockData->idleCount >= IDLE_STEPS;
+}
+
+// Expects messages typed 0, 1, 2, ... carrying their type as an int payload.
+static void mockHandleMessage(const smMessage *message)
+{
+    int payload;
+    memcpy(&payload, message->data, sizeof(payload));
+    assert(message->type == (uint32_t)smMockData->messageCount);
+    assert(message->size == sizeof(payload) && payload == smMockData->messageCount);
+    smMockData->messageCount++;
+}
+
+// Keeps the CPU busy long enough for the sampling profiler to fire.
+static void cpuBurningUpdate(float dt)
+{
+    volatile uint64_t sink = 0;
+    const clock_t END = clock() + (clock_t)(BURN_SECONDS * CLOCKS_PER_SEC);
+    while (clock() < END)
+    {
+        sink++;
+    }
+}
+
+// Messages must already be delivered when the scene updates.
+static void messageCheckingUpdate(float dt)
+{
+    assert(smMockData->messageCount > 0);
+}
+
+static int postNumbered(int number)
+{
+    return smPostMessage((uint32_t)number, &number, sizeof(number));
+}
+
+static void mockTimer(void *args)
+{
+    smMockData->timerCount++;
+}
+
+static void countTimer(void *args)
+{
+    (*(int *)args)++;
+}
+
+typedef struct
+{
+    smTimerId id;
+    int fireCount;
+} SelfCancellingTimer;
+
+// Cancels its own repeating timer on the third expiry.
+static void selfCancellingTimer(void *args)
+{
+    SelfCancellingTimer *timer = args;
+    if (++timer->fireCount == 3)
+    {
+        assert(smCancelTimer(timer->id) == RES_OK);
+    }
+}
+
+static long timerNowMs;
+
+// Expects to fire within the update step that reached its delay, in ms.
+static void deadlineCheckingTimer(void *args)
+{
+    long delayMs = *(long *)args;
+    assert(delayMs <= timerNowMs && delayMs > timerNowMs - TIMER_STEP_MS);
+    smMockData->timerCount++;
+}
+
+/* Builds a single-bucket registry the way GenScene does: finds a seed that
+ * sends every name to its own slot, then stores each scene at its slot.
+ */
+static void buildRegistry(smSceneDesc descs[REGISTRY_SIZE], uint32_t *seed)
+{
+    smSceneDesc sorted[REGISTRY_SIZE];
+    for (*seed = 1;; (*seed)++)
+    {
+        bool isTaken[REGISTRY_SIZE] = {0};
+        bool isPerfect = true;
+        for (size_t i = 0; i < REGISTRY_SIZE && isPerfect; i++)
+        {
+            size_t slot = cmHashString(descs[i].name, *seed) % REGISTRY_SIZE;
+            isPerfect = !isTaken[slot];
+            isTaken[slot] = true;
+            sorted[slot] = descs[i];
+        }
+
+        if (isPerfect)
+        {
+            memcpy(descs, sorted, sizeof(sorted));
+            return;
+        }
+    }
+}
+
 // Callbacks
 
 static void onEnter(MockData *data)
@@ -136,6 +327,22 @@ static smInternalScene mock2 = {
     .exit = mockExit,
 };
 
+static smInternalScene mock3 = {
+    .name = "mock3",
+    .enter = mockEnter,
+    .update = mockUpdate,
+    .draw = mockDraw,
+    .exit = mockExit,
+};
+
+static smInternalScene mock4 = {
+    .name = "mock4",
+    .enter = mockEnter,
+    .update = mockUpdate,
+    .draw = mockDraw,
+    .exit = mockExit,
+};
+
 smTestEnterFn smTestEnter;
 smTestEnterWithArgsFn smTestEnterWithArgs;
 smTestExitFn smTestExit;
@@ -179,6 +386,18 @@ void Test_smCreateScene_FailsPreStart(void)
     tsPass(__func__);
 }
 
+void Test_smRegisterScenes_FailsPreStart(void)
+{
+    assert(smRegisterScenes(nullptr, 0) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+void Test_smSetRegistry_FailsPreStart(void)
+{
+    assert(smSetRegistry(nullptr) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
 void Test_smSceneExists_FailsPreStart(void)
 {
     assert(!smSceneExists(nullptr));
@@ -191,6 +410,48 @@ void Test_smSetScene_FailsPreStart(void)
     tsPass(__func__);
 }
 
+void Test_smSetSceneSuspend_FailsPreStart(void)
+{
+    assert(smSetSceneSuspend(nullptr, nullptr, nullptr, 0) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+void Test_smSetSuspendBudget_FailsPreStart(void)
+{
+    assert(smSetSuspendBudget(0) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+void Test_smIsSceneSuspended_FailsPreStart(void)
+{
+    assert(!smIsSceneSuspended(nullptr));
+    tsPass(__func__);
+}
+
+void Test_smSetSceneLoader_FailsPreStart(void)
+{
+    assert(smSetSceneLoader(nullptr, nullptr) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+void Test_smSetLoadingScene_FailsPreStart(void)
+{
+    assert(smSetLoadingScene(nullptr) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+void Test_smSetLoadBudget_FailsPreStart(void)
+{
+    assert(smSetLoadBudget(LOAD_BUDGET_MS) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+void Test_smIsSceneLoading_FailsPreStart(void)
+{
+    assert(!smIsSceneLoading());
+    tsPass(__func__);
+}
+
 void Test_smGetCurrentSceneName_FailsPreStart(void)
 {
     assert(!smGetCurrentSceneName());
@@ -417,147 +678,393 @@ void Test_smCreateScene_FailsWhenMapEntryAllocFails(void)
     tsPass(__func__);
 }
 
-// smSceneExists
+// smRegisterScenes
 
-void Test_smSceneExists_AcceptsCreatedName(void)
+void Test_smRegisterScenes_RegistersAllScenes(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(smSceneExists(mock.name));
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    const smSceneDesc DESCS[] = {
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock2.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock3.name, nullptr, mockUpdate, nullptr, nullptr},
+    };
+    const size_t COUNT = sizeof(DESCS) / sizeof(DESCS[0]);
+    assert(smRegisterScenes(DESCS, COUNT) == RES_OK);
+    assert(smGetSceneCount() == (int)COUNT);
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        assert(smSceneExists(DESCS[i].name));
+    }
+
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smDeleteScene(mock.name) == RES_OK);
+    assert(!smSceneExists(mock.name));
+    assert(smMockData->exitCount == 1);
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smSceneExists_RejectsNonCreatedName(void)
+void Test_smRegisterScenes_RejectsNullDescs(void)
 {
     setup();
-    assert(!smSceneExists(mock.name));
+    assert(smRegisterScenes(nullptr, 1) == RES_NULL_ARG);
     teardown();
     tsPass(__func__);
 }
 
-// -- smSetScene
-
-void Test_smSetScene_AcceptsValidSceneFromNull(void)
+void Test_smRegisterScenes_RejectsEmptyTable(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    const smSceneDesc DESCS[] = {{.name = mock.name, .update = mockUpdate}};
+    assert(smRegisterScenes(DESCS, 0) == RES_INVALID_ARG);
+    assert(smGetSceneCount() == 0);
     teardown();
     tsPass(__func__);
 }
 
-void Test_smSetScene_RejectsNullName(void)
+void Test_smRegisterScenes_RejectsInvalidDescAndRegistersNone(void)
 {
     setup();
-    assert(smSetScene(nullptr, nullptr) == RES_NULL_ARG);
+
+    const smSceneDesc DESCS[] = {
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {"", mockEnter, mockUpdate, mockDraw, mockExit},
+    };
+    assert(smRegisterScenes(DESCS, 2) == RES_EMPTY_ARG);
+
+    const smSceneDesc NO_FUNCS[] = {
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock2.name, nullptr, nullptr, nullptr, nullptr},
+    };
+    assert(smRegisterScenes(NO_FUNCS, 2) == RES_NO_VALID_FUNCS);
+    assert(smGetSceneCount() == 0);
+    assert(!smSceneExists(mock.name));
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smSetScene_RejectsEmptyName(void)
+void Test_smRegisterScenes_RejectsRepeatedNameAndRegistersNone(void)
 {
     setup();
-    assert(smSetScene("", nullptr) == RES_EMPTY_ARG);
+
+    const smSceneDesc DESCS[] = {
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock2.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+    };
+    assert(smRegisterScenes(DESCS, 3) == RES_SCENE_ALREADY_EXISTS);
+    assert(smGetSceneCount() == 0);
+    assert(!smSceneExists(mock.name));
+    assert(!smSceneExists(mock2.name));
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smSetScene_RejectsNonCreatedName(void)
+void Test_smRegisterScenes_RejectsExistingName(void)
 {
     setup();
-    assert(smSetScene(mock.name, nullptr) == RES_SCENE_NOT_FOUND);
+
+    const smSceneDesc DESCS[] = {
+        {mock2.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+    };
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smRegisterScenes(DESCS, 2) == RES_SCENE_ALREADY_EXISTS);
+    assert(smGetSceneCount() == 1);
+    assert(!smSceneExists(mock2.name));
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smSetScene_SucceedsChangingFromOneSceneToAnotherWithNoArgs(void)
+void Test_smRegisterScenes_FailsWhenBlockAllocFails(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(
-        smCreateScene(mock2.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(smSetScene(mock.name, nullptr) == RES_OK);
-    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    tsDisable(MALLOC, 1);
+
+    const smSceneDesc DESCS[] = {
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+    };
+    assert(smRegisterScenes(DESCS, 1) == RES_MEM_ALLOC_FAIL);
+    assert(smGetSceneCount() == 0);
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smSetScene_CallsNonNullExitOfCurrentScene(void)
+// smSetRegistry
+
+void Test_smSetRegistry_FindsRegistryScenes(void)
 {
     setup();
-    smTestExit = onExit;
+    smTestEnter = onEnter;
     smMockData = &(MockData){0};
 
-    assert(
-        smCreateScene(mock.name, nullptr, nullptr, nullptr, mockExit) ==
-        RES_OK);
-    assert(
-        smCreateScene(mock2.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    smSceneDesc descs[REGISTRY_SIZE] = {
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock2.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock3.name, mockEnter, mockUpdate, mockDraw, mockExit},
+    };
+    uint32_t seed;
+    buildRegistry(descs, &seed);
+    const smSceneRegistry REGISTRY = {descs, REGISTRY_SIZE, &seed, 1};
+
+    assert(smSetRegistry(&REGISTRY) == RES_OK);
+    assert(smGetSceneCount() == REGISTRY_SIZE);
+    assert(smSceneExists(mock.name));
+    assert(smSceneExists(mock3.name));
+    assert(!smSceneExists(mock4.name));
     assert(smSetScene(mock2.name, nullptr) == RES_OK);
-    assert(smMockData->exitCount == 1);
+    assert(strcmp(smGetCurrentSceneName(), mock2.name) == 0);
+    assert(smMockData->enterCount == 1);
 
     teardown();
     tsPass(__func__);
 }
 
-void Test_smSetScene_SkipsNullExitOfCurrentScene(void)
+void Test_smSetRegistry_RejectsNullRegistry(void)
 {
     setup();
-    smTestExit = onExit;
-    smMockData = &(MockData){0};
+    assert(smSetRegistry(nullptr) == RES_NULL_ARG);
+    teardown();
+    tsPass(__func__);
+}
 
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(
-        smCreateScene(mock2.name, nullptr, nullptr, nullptr, mockExit) ==
-        RES_OK);
-    assert(smSetScene(mock.name, nullptr) == RES_OK);
-    assert(smSetScene(mock2.name, nullptr) == RES_OK);
-    assert(smMockData->exitCount == 0);
+void Test_smSetRegistry_RejectsSecondRegistry(void)
+{
+    setup();
+
+    smSceneDesc descs[REGISTRY_SIZE] = {
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock2.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock3.name, mockEnter, mockUpdate, mockDraw, mockExit},
+    };
+    uint32_t seed;
+    buildRegistry(descs, &seed);
+    const smSceneRegistry REGISTRY = {descs, REGISTRY_SIZE, &seed, 1};
+
+    assert(smSetRegistry(&REGISTRY) == RES_OK);
+    assert(smSetRegistry(&REGISTRY) == RES_REGISTRY_ALREADY_SET);
 
     teardown();
     tsPass(__func__);
 }
 
-void Test_smSetScene_CallsNonNullEnterOfTargetScene(void)
+void Test_smSetRegistry_RejectsRegisteredName(void)
 {
     setup();
-    smTestEnter = onEnter;
-    smMockData = &(MockData){0};
 
-    assert(
-        smCreateScene(mock.name, nullptr, nullptr, nullptr, mockExit) ==
-        RES_OK);
-    assert(
-        smCreateScene(mock2.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(smSetScene(mock.name, nullptr) == RES_OK);
-    assert(smSetScene(mock2.name, nullptr) == RES_OK);
-    assert(smMockData->enterCount == 1);
+    smSceneDesc descs[REGISTRY_SIZE] = {
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock2.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock3.name, mockEnter, mockUpdate, mockDraw, mockExit},
+    };
+    uint32_t seed;
+    buildRegistry(descs, &seed);
+    const smSceneRegistry REGISTRY = {descs, REGISTRY_SIZE, &seed, 1};
+
+    assert(smCreateScene(mock2.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetRegistry(&REGISTRY) == RES_SCENE_ALREADY_EXISTS);
+    assert(smGetSceneCount() == 1);
 
     teardown();
     tsPass(__func__);
 }
 
-void Test_smSetScene_SkipsNullEnterOfTargetScene(void)
+void Test_smSetRegistry_KeepsRegistryScenesFromBeingRecreatedOrDeleted(void)
 {
     setup();
-    smTestEnter = onEnter;
-    smMockData = &(MockData){0};
 
-    assert(
-        smCreateScene(mock.name, nullptr, mockUpdate, nullptr, nullptr) ==
+    smSceneDesc descs[REGISTRY_SIZE] = {
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock2.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock3.name, mockEnter, mockUpdate, mockDraw, mockExit},
+    };
+    uint32_t seed;
+    buildRegistry(descs, &seed);
+    const smSceneRegistry REGISTRY = {descs, REGISTRY_SIZE, &seed, 1};
+
+    assert(smSetRegistry(&REGISTRY) == RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) ==
+        RES_SCENE_ALREADY_EXISTS);
+    assert(smDeleteScene(mock.name) == RES_CANT_DEL_REGISTRY_SCENE);
+    assert(smCreateScene(mock4.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smGetSceneCount() == REGISTRY_SIZE + 1);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetRegistry_FailsWhenStateAllocFails(void)
+{
+    setup();
+
+    smSceneDesc descs[REGISTRY_SIZE] = {
+        {mock.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock2.name, mockEnter, mockUpdate, mockDraw, mockExit},
+        {mock3.name, mockEnter, mockUpdate, mockDraw, mockExit},
+    };
+    uint32_t seed;
+    buildRegistry(descs, &seed);
+    const smSceneRegistry REGISTRY = {descs, REGISTRY_SIZE, &seed, 1};
+
+    tsDisable(CALLOC, 1);
+    assert(smSetRegistry(&REGISTRY) == RES_MEM_ALLOC_FAIL);
+    assert(smGetSceneCount() == 0);
+    assert(!smSceneExists(mock.name));
+
+    teardown();
+    tsPass(__func__);
+}
+
+// smSceneExists
+
+void Test_smSceneExists_AcceptsCreatedName(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smSceneExists(mock.name));
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSceneExists_RejectsNonCreatedName(void)
+{
+    setup();
+    assert(!smSceneExists(mock.name));
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smSetScene
+
+void Test_smSetScene_AcceptsValidSceneFromNull(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_RejectsNullName(void)
+{
+    setup();
+    assert(smSetScene(nullptr, nullptr) == RES_NULL_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_RejectsEmptyName(void)
+{
+    setup();
+    assert(smSetScene("", nullptr) == RES_EMPTY_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_RejectsNonCreatedName(void)
+{
+    setup();
+    assert(smSetScene(mock.name, nullptr) == RES_SCENE_NOT_FOUND);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_SucceedsChangingFromOneSceneToAnotherWithNoArgs(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(
+        smCreateScene(mock2.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_CallsNonNullExitOfCurrentScene(void)
+{
+    setup();
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(
+        smCreateScene(mock.name, nullptr, nullptr, nullptr, mockExit) ==
+        RES_OK);
+    assert(
+        smCreateScene(mock2.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smMockData->exitCount == 1);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_SkipsNullExitOfCurrentScene(void)
+{
+    setup();
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(
+        smCreateScene(mock2.name, nullptr, nullptr, nullptr, mockExit) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smMockData->exitCount == 0);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_CallsNonNullEnterOfTargetScene(void)
+{
+    setup();
+    smTestEnter = onEnter;
+    smMockData = &(MockData){0};
+
+    assert(
+        smCreateScene(mock.name, nullptr, nullptr, nullptr, mockExit) ==
+        RES_OK);
+    assert(
+        smCreateScene(mock2.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smMockData->enterCount == 1);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_SkipsNullEnterOfTargetScene(void)
+{
+    setup();
+    smTestEnter = onEnter;
+    smMockData = &(MockData){0};
+
+    assert(
+        smCreateScene(mock.name, nullptr, mockUpdate, nullptr, nullptr) ==
         RES_OK);
     assert(
         smCreateScene(mock2.name, nullptr, nullptr, nullptr, mockExit) ==
@@ -611,243 +1118,1737 @@ void Test_smSetScene_CallsNonNullEnterWithArgsOfTargetScene(void)
     tsPass(__func__);
 }
 
-// -- smGetCurrentSceneName
+// -- smSetSceneSuspend
 
-void Test_smGetCurrentSceneName_FailsPreCreateScene(void)
+void Test_smSetSceneSuspend_RejectsNullName(void)
 {
     setup();
-    assert(!smGetCurrentSceneName());
+    assert(smSetSceneSuspend(nullptr, mockSuspend, mockResume, 0) == RES_NULL_ARG);
     teardown();
     tsPass(__func__);
 }
 
-void Test_smGetCurrentSceneName_ReturnsCurrentSceneName(void)
+void Test_smSetSceneSuspend_RejectsNonCreatedName(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
+    assert(smSetSceneSuspend(mock.name, mockSuspend, mockResume, 0) == RES_SCENE_NOT_FOUND);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_ExitsSuspendableSceneWhenBudgetIsZero(void)
+{
+    setup();
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(smCreateScene(mock.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smSetSceneSuspend(mock.name, mockSuspend, mockResume, SUSPEND_COST) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smMockData->suspendCount == 0);
+    assert(smMockData->exitCount == 1);
+    assert(!smIsSceneSuspended(mock.name));
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_SuspendsOutgoingSceneWithinBudget(void)
+{
+    setup();
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(smSetSuspendBudget(SUSPEND_COST) == RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smSetSceneSuspend(mock.name, mockSuspend, mockResume, SUSPEND_COST) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smMockData->suspendCount == 1);
+    assert(smMockData->exitCount == 0);
+    assert(smIsSceneSuspended(mock.name));
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_ResumesSuspendedSceneInsteadOfEntering(void)
+{
+    setup();
+    smTestEnter = onEnter;
+    smMockData = &(MockData){0};
+
+    assert(smSetSuspendBudget(SUSPEND_COST) == RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smSetSceneSuspend(mock.name, mockSuspend, mockResume, SUSPEND_COST) == RES_OK);
     assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smMockData->enterCount == 2);
+    assert(smMockData->resumeCount == 1);
+    assert(!smIsSceneSuspended(mock.name));
     assert(strcmp(smGetCurrentSceneName(), mock.name) == 0);
+
     teardown();
     tsPass(__func__);
 }
 
-// -- smDeleteScene
+void Test_smSetScene_EvictsLeastRecentlyUsedSceneOverBudget(void)
+{
+    setup();
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
 
-void Test_smDeleteScene_FailsPreCreateScene(void)
+    const smInternalScene *SCENES[] = {&mock, &mock2, &mock3, &mock4};
+    assert(smSetSuspendBudget(2 * SUSPEND_COST) == RES_OK);
+    for (size_t i = 0; i < sizeof(SCENES) / sizeof(SCENES[0]); i++)
+    {
+        assert(smCreateScene(SCENES[i]->name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+        assert(smSetSceneSuspend(SCENES[i]->name, mockSuspend, mockResume, SUSPEND_COST) ==
+            RES_OK);
+        assert(smSetScene(SCENES[i]->name, nullptr) == RES_OK);
+    }
+
+    assert(smMockData->suspendCount == 3);
+    assert(smMockData->exitCount == 1);
+    assert(!smIsSceneSuspended(mock.name));
+    assert(smIsSceneSuspended(mock2.name));
+    assert(smIsSceneSuspended(mock3.name));
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_DoesNotEvictSuspendedTargetScene(void)
 {
     setup();
-    assert(smDeleteScene(mock.name) == RES_SCENE_NOT_FOUND);
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(smSetSuspendBudget(SUSPEND_COST) == RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smSetSceneSuspend(mock.name, mockSuspend, mockResume, SUSPEND_COST) == RES_OK);
+    assert(smSetSceneSuspend(mock2.name, mockSuspend, mockResume, SUSPEND_COST) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smMockData->resumeCount == 1);
+    assert(smMockData->exitCount == 0);
+    assert(smIsSceneSuspended(mock2.name));
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smDeleteScene_FailsToDeleteCurrentScene(void)
+void Test_smSetSceneSuspend_EvictsSceneWhenSuspendIsCleared(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(smSetSuspendBudget(SUSPEND_COST) == RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smSetSceneSuspend(mock.name, mockSuspend, mockResume, SUSPEND_COST) == RES_OK);
     assert(smSetScene(mock.name, nullptr) == RES_OK);
-    assert(smDeleteScene(mock.name) == RES_CANT_DEL_CURR_SCENE);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smSetSceneSuspend(mock.name, nullptr, nullptr, 0) == RES_OK);
+    assert(!smIsSceneSuspended(mock.name));
+    assert(smMockData->exitCount == 1);
+
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smSetSuspendBudget
+
+void Test_smSetSuspendBudget_EvictsScenesWhenLowered(void)
+{
+    setup();
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(smSetSuspendBudget(SUSPEND_COST) == RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smSetSceneSuspend(mock.name, mockSuspend, mockResume, SUSPEND_COST) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smSetSuspendBudget(0) == RES_OK);
+    assert(!smIsSceneSuspended(mock.name));
+    assert(smMockData->exitCount == 1);
+
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smSetSceneLoader
+
+void Test_smSetSceneLoader_RejectsNonCreatedName(void)
+{
+    setup();
+    assert(smSetSceneLoader(mock.name, mockLoad) == RES_SCENE_NOT_FOUND);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_KeepsPreviousSceneWhileLoading(void)
+{
+    setup();
+    smTestEnter = onEnter;
+    smMockData = &(MockData){0};
+
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneLoader(mock2.name, mockLoad) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smIsSceneLoading());
+    assert(smMockData->enterCount == 1);
+    assert(smMockData->loadCount == 0);
+    assert(strcmp(smGetCurrentSceneName(), mock.name) == 0);
+    assert(smDraw() == RES_OK);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_ShowsLoadingSceneWhileLoading(void)
+{
+    setup();
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smCreateScene(mock3.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneLoader(mock2.name, mockLoad) == RES_OK);
+    assert(smSetLoadingScene(mock3.name) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smMockData->exitCount == 1);
+    assert(strcmp(smGetCurrentSceneName(), mock3.name) == 0);
+
+    while (smIsSceneLoading())
+    {
+        assert(smUpdate(mockDt) == RES_OK);
+    }
+    assert(smMockData->exitCount == 2);
+    assert(strcmp(smGetCurrentSceneName(), mock2.name) == 0);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetScene_ExitsAbandonedLoad(void)
+{
+    setup();
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneLoader(mock2.name, mockLoad) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(!smIsSceneLoading());
+    assert(smMockData->exitCount == 2);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smUpdate_StopsWhenLoaderStopsSceneManager(void)
+{
+    setup();
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneLoader(mock.name, mockLoadThenStop) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(!smIsRunning());
+
+    resetHooks();
+    tsPass(__func__);
+}
+
+void Test_smUpdate_StopsWhenLoadedSceneEnterStopsSceneManager(void)
+{
+    setup();
+    assert(smCreateScene(mock.name, mockEnterThenStop, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneLoader(mock.name, mockLoadAtOnce) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(!smIsRunning());
+
+    resetHooks();
+    tsPass(__func__);
+}
+
+void Test_smUpdate_KeepsSceneSetByLoader(void)
+{
+    setup();
+    smTestEnter = onEnter;
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneLoader(mock2.name, mockLoadThenSwitchBack) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(!smIsSceneLoading());
+    assert(strcmp(smGetCurrentSceneName(), mock.name) == 0);
+    assert(smMockData->enterCount == 1);
+    assert(smMockData->exitCount == 1);
+
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smSetLoadBudget
+
+void Test_smSetLoadBudget_RejectsNegativeBudget(void)
+{
+    setup();
+    assert(smSetLoadBudget(-LOAD_BUDGET_MS) == RES_INVALID_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smGetCurrentSceneName
+
+void Test_smGetCurrentSceneName_FailsPreCreateScene(void)
+{
+    setup();
+    assert(!smGetCurrentSceneName());
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetCurrentSceneName_ReturnsCurrentSceneName(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(strcmp(smGetCurrentSceneName(), mock.name) == 0);
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smDeleteScene
+
+void Test_smDeleteScene_FailsPreCreateScene(void)
+{
+    setup();
+    assert(smDeleteScene(mock.name) == RES_SCENE_NOT_FOUND);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smDeleteScene_FailsToDeleteCurrentScene(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smDeleteScene(mock.name) == RES_CANT_DEL_CURR_SCENE);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smDeleteScene_AcceptsNonCurrentScene(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smDeleteScene(mock.name) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smDeleteScene_RejectsEmptyName(void)
+{
+    setup();
+    assert(smDeleteScene("") == RES_EMPTY_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smDeleteScene_FailsWhenDeletingSameSceneTwice(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smDeleteScene(mock.name) == RES_OK);
+    assert(smDeleteScene(mock.name) == RES_SCENE_NOT_FOUND);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smDeleteScene_FailsToDeletePendingScene(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneLoader(mock.name, mockLoad) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smDeleteScene(mock.name) == RES_CANT_DEL_CURR_SCENE);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smDeleteScene_ExitsSuspendedScene(void)
+{
+    setup();
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(smSetSuspendBudget(SUSPEND_COST) == RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smSetSceneSuspend(mock.name, mockSuspend, mockResume, SUSPEND_COST) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smDeleteScene(mock.name) == RES_OK);
+    assert(smMockData->exitCount == 1);
+
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smGetSceneCount
+
+void Test_smGetSceneCount_ReturnsZeroPostStart(void)
+{
+    setup();
+    assert(smGetSceneCount() == 0);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetSceneCount_ReturnsCorrectSceneCountPostCreateScene(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smGetSceneCount() == 1);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetSceneCount_ReturnsCorrectSceneCountPostDeleteScene(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smDeleteScene(mock.name) == RES_OK);
+    assert(smGetSceneCount() == 0);
+    teardown();
+    tsPass(__func__);
+}
+
+// Lifecycle Functions
+
+// -- smUpdate
+
+void Test_smUpdate_FailsWhenNullCurrentScene(void)
+{
+    setup();
+    assert(!smGetCurrentSceneName());
+    assert(smUpdate(mockDt) == RES_NO_CURR_SCENE);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smUpdate_CallsNonNullUpdateOfCurrentScene(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, nullptr, mockUpdate, nullptr, nullptr) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smUpdate(mockDt) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smUpdate_FailsWhenNullUpdate(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smUpdate(mockDt) == RES_NO_UPDATE_FUNC);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smUpdate_SpreadsLoaderAcrossFramesWithinBudget(void)
+{
+    setup();
+    smTestEnter = onEnter;
+    smMockData = &(MockData){0};
+
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneLoader(mock.name, mockLoad) == RES_OK);
+    assert(smSetLoadBudget(LOAD_BUDGET_MS) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(!smGetCurrentSceneName());
+
+    const int STEPS_PER_FRAME = (int)(LOAD_BUDGET_MS * 1000000L / LOAD_STEP_NS);
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(smMockData->loadCount == STEPS_PER_FRAME);
+    assert(smMockData->enterCount == 0);
+    assert(smIsSceneLoading());
+
+    while (smIsSceneLoading())
+    {
+        assert(smUpdate(mockDt) == RES_OK);
+    }
+    assert(smMockData->loadCount == LOAD_STEPS);
+    assert(smMockData->enterCount == 1);
+    assert(strcmp(smGetCurrentSceneName(), mock.name) == 0);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smUpdate_CallsLoaderOnceWhenBudgetIsZero(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneLoader(mock.name, mockLoad) == RES_OK);
+    assert(smSetLoadBudget(0.0f) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(smMockData->loadCount == 1);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smUpdate_PublishesMetricsWhenMetricsIsRunning(void)
+{
+    assert(mtStart() == RES_OK);
+    setup();
+
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    for (int i = 0; i < 3; i++)
+    {
+        assert(smUpdate(mockDt) == RES_OK);
+        assert(smDraw() == RES_OK);
+    }
+
+    // Creating a metric by an existing name returns SceneManager's handle.
+    mtMetricId id;
+    uint64_t switches;
+    assert(mtCreateCounter("sm.scene_switches", &id) == RES_OK);
+    assert(mtGetCounter(id, &switches) == RES_OK && switches == 2);
+
+    mtHistogramSummary summary;
+    assert(mtCreateHistogram("sm.frame_ns", &id) == RES_OK);
+    assert(mtGetHistogram(id, &summary) == RES_OK && summary.count == 3);
+    assert(summary.min == (uint64_t)(mockDt * NS_PER_S));
+    assert(mtCreateHistogram("sm.update_ns", &id) == RES_OK);
+    assert(mtGetHistogram(id, &summary) == RES_OK && summary.count == 3);
+    assert(mtCreateHistogram("sm.draw_ns", &id) == RES_OK);
+    assert(mtGetHistogram(id, &summary) == RES_OK && summary.count == 3);
+
+    teardown();
+    assert(mtStop() == RES_OK);
+    tsPass(__func__);
+}
+
+void Test_smUpdate_DoesNotAllocateInSteadyState(void)
+{
+    assert(mtStart() == RES_OK);
+    setup();
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    // The first frame may allocate, e.g. the metrics it publishes.
+    assert(smUpdate(mockDt) == RES_OK);
+
+    tsBeginNoAlloc();
+    for (int i = 0; i < STEADY_FRAMES; i++)
+    {
+        assert(smUpdate(mockDt) == RES_OK);
+    }
+    assert(tsEndNoAlloc(nullptr) == 0);
+
+    teardown();
+    assert(mtStop() == RES_OK);
+    tsPass(__func__);
+}
+
+// -- smGetDt
+
+void Test_smGetDt_UsesDefaultDtOnFirstCall(void)
+{
+    setup();
+    float target = 1.0f / DEFAULT_FPS;
+    assert(fabsf(smGetDt() - target) < DT_TOLERANCE);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetDt_UpdatesDtOnConsecutiveCalls(void)
+{
+    setup();
+
+    // Arbitrary time for first smGetDt call
+    smMockCurrTime.tv_nsec = EXPECTED_DT_NS;
+    smMockCurrTime.tv_sec = 0;
+
+    smGetDt(); // First call uses default dt
+
+    for (int i = 0; i < FRAME_TIME_ITERATIONS; i++)
+    {
+        smMockCurrTime.tv_nsec += EXPECTED_DT_NS;
+        if (smMockCurrTime.tv_nsec >= NS_PER_S)
+        {
+            smMockCurrTime.tv_sec += smMockCurrTime.tv_nsec / NS_PER_S;
+            smMockCurrTime.tv_nsec %= NS_PER_S;
+        }
+        assert(fabsf(smGetDt() - EXPECTED_DT_S) < DT_TOLERANCE);
+    }
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetDtFilter_RejectsInvalidFilters(void)
+{
+    setup();
+    assert(smSetDtFilter(&(smDtFilter){.mode = (smDtFilterMode)-1}) == RES_INVALID_ARG);
+    assert(smSetDtFilter(&(smDtFilter){.mode = SM_DT_FILTER_EMA}) == RES_INVALID_ARG);
+    assert(smSetDtFilter(&(smDtFilter){.mode = SM_DT_FILTER_EMA, .smoothing = 1.5f}) ==
+        RES_INVALID_ARG);
+    assert(smSetDtFilter(&(smDtFilter){.maxDt = -1.0f}) == RES_INVALID_ARG);
+    assert(smSetDtFilter(&(smDtFilter){.snapInterval = -1.0f}) == RES_INVALID_ARG);
+    assert(smSetDtFilter(nullptr) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetDt_ClampsOutliersToMaxDt(void)
+{
+    setup();
+    const float MAX_DT = 0.1f;
+    assert(smSetDtFilter(&(smDtFilter){.maxDt = MAX_DT}) == RES_OK);
+    nextDt(EXPECTED_DT_NS);
+
+    assert(fabsf(nextDt(EXPECTED_DT_NS) - EXPECTED_DT_S) < DT_TOLERANCE);
+    assert(nextDt(NS_PER_S) == MAX_DT);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetDt_MedianFilterIgnoresIsolatedSpike(void)
+{
+    setup();
+    assert(smSetDtFilter(&(smDtFilter){.mode = SM_DT_FILTER_MEDIAN}) == RES_OK);
+    nextDt(EXPECTED_DT_NS);
+
+    for (int i = 0; i < IDEMPOTENT_ITERATIONS; i++)
+    {
+        nextDt(EXPECTED_DT_NS);
+    }
+    assert(fabsf(nextDt(3 * EXPECTED_DT_NS) - EXPECTED_DT_S) < DT_TOLERANCE);
+    assert(fabsf(nextDt(EXPECTED_DT_NS) - EXPECTED_DT_S) < DT_TOLERANCE);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetDt_EmaFilterDampsJitter(void)
+{
+    setup();
+    assert(smSetDtFilter(&(smDtFilter){.mode = SM_DT_FILTER_EMA, .smoothing = 0.1f}) == RES_OK);
+    nextDt(EXPECTED_DT_NS);
+
+    const long JITTER_NS = EXPECTED_DT_NS / 4;
+    float minDt = 1.0f, maxDt = 0.0f;
+    for (int i = 0; i < FRAME_TIME_ITERATIONS; i++)
+    {
+        float dt = nextDt(i % 2 ? EXPECTED_DT_NS + JITTER_NS : EXPECTED_DT_NS - JITTER_NS);
+        if (i >= FRAME_TIME_ITERATIONS / 2)
+        {
+            minDt = dt < minDt ? dt : minDt;
+            maxDt = dt > maxDt ? dt : maxDt;
+        }
+    }
+    assert(maxDt - minDt < 0.1f * 2 * JITTER_NS / NS_PER_S);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetDt_SnapsToRefreshIntervalWithoutDrift(void)
+{
+    setup();
+    const float INTERVAL = EXPECTED_DT_S;
+    assert(smSetDtFilter(&(smDtFilter){.snapInterval = INTERVAL}) == RES_OK);
+    nextDt(EXPECTED_DT_NS);
+
+    const long JITTER_NS = EXPECTED_DT_NS / 20;
+    long elapsedNs = 0;
+    float snappedTotal = 0.0f;
+    for (int i = 0; i < FRAME_TIME_ITERATIONS; i++)
+    {
+        long frameNs = i % 3 ? EXPECTED_DT_NS + JITTER_NS : EXPECTED_DT_NS - 2 * JITTER_NS;
+        float dt = nextDt(frameNs);
+        assert(dt == INTERVAL);
+        elapsedNs += frameNs;
+        snappedTotal += dt;
+    }
+    assert(fabsf(snappedTotal - (float)elapsedNs / NS_PER_S) < INTERVAL);
+
+    // A dropped frame snaps to two intervals rather than one.
+    assert(nextDt(2 * EXPECTED_DT_NS) == 2 * INTERVAL);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetDt_FailsWhenClockGettimeFails(void)
+{
+    setup();
+    smMockClockGettimeFails = true;
+    assert(smGetDt() == (float) RES_CLOCK_GETTIME_FAIL);
+    teardown();
+    tsPass(__func__);
+}
+
+
+// -- smDraw
+
+void Test_smDraw_FailsWhenNullCurrentScene(void)
+{
+    setup();
+    assert(!smGetCurrentSceneName());
+    assert(smDraw() == RES_NO_CURR_SCENE);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smDraw_CallsValidDrawFunction(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, nullptr, nullptr, mockDraw, nullptr) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smDraw() == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smDraw_FailsWhenNullDraw(void)
+{
+    setup();
+    assert(
+        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
+        RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smDraw() == RES_NO_DRAW_FUNC);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smDraw_DoesNotAllocateInSteadyState(void)
+{
+    assert(mtStart() == RES_OK);
+    setup();
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smDraw() == RES_OK);
+
+    tsBeginNoAlloc();
+    for (int i = 0; i < STEADY_FRAMES; i++)
+    {
+        assert(smDraw() == RES_OK);
+    }
+    assert(tsEndNoAlloc(nullptr) == 0);
+
+    teardown();
+    assert(mtStop() == RES_OK);
+    tsPass(__func__);
+}
+
+// Frame Pacing
+
+// -- smSetClockSource
+
+void Test_smSetClockSource_RejectsInvalidSource(void)
+{
+    setup();
+    assert(smSetClockSource((smClockSource)-1) == RES_INVALID_ARG);
+    assert(smSetClockSource((smClockSource)(SM_CLOCK_TSC + 1)) == RES_INVALID_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetClockSource_AcceptsMonotonicAndReportsUnsupportedSources(void)
+{
+    setup();
+#ifdef __linux__
+    assert(smSetClockSource(SM_CLOCK_MONOTONIC_RAW) == RES_OK);
+    assert(smSetClockSource(SM_CLOCK_BOOTTIME) == RES_OK);
+#endif
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    // Only an invariant TSC is accepted, which depends on the CPU.
+    const int TSC_RESULT = smSetClockSource(SM_CLOCK_TSC);
+    assert(TSC_RESULT == RES_OK || TSC_RESULT == RES_CLOCK_UNSUPPORTED);
+#else
+    assert(smSetClockSource(SM_CLOCK_TSC) == RES_CLOCK_UNSUPPORTED);
+#endif
+    assert(smSetClockSource(SM_CLOCK_MONOTONIC) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smSetClockSource_EverySourceKeepsPaceWithMonotonic(void)
+{
+    setup();
+    // The mocked SM_CLOCK_MONOTONIC is skipped, since it only moves when tests move it.
+    for (int source = SM_CLOCK_MONOTONIC_RAW; source <= SM_CLOCK_TSC; source++)
+    {
+        const int RESULT = smSetClockSource((smClockSource)source);
+        if (RESULT == RES_CLOCK_UNSUPPORTED)
+        {
+            continue;
+        }
+        assert(RESULT == RES_OK);
+
+        // Each source read is bracketed by CLOCK_MONOTONIC, so preemption widens the bounds.
+        int64_t startNs;
+        const int64_t MONO_START_BEFORE = cmGetTimeNs();
+        assert(smInternalGetTime(&startNs, __func__) == RES_OK);
+        const int64_t MONO_START_AFTER = cmGetTimeNs();
+        if (source == SM_CLOCK_TSC)
+        {
+            // Anchored to CLOCK_MONOTONIC when calibrated, moments ago.
+            assert(llabs(startNs - MONO_START_AFTER) < CLOCK_TOLERANCE_NS);
+        }
+
+        int64_t prevNs = startNs;
+        int64_t nowNs = startNs;
+        while (cmGetTimeNs() - MONO_START_AFTER < CLOCK_SPAN_NS)
+        {
+            assert(smInternalGetTime(&nowNs, __func__) == RES_OK);
+            assert(nowNs >= prevNs);
+            prevNs = nowNs;
+        }
+
+        const int64_t MONO_END_BEFORE = cmGetTimeNs();
+        assert(smInternalGetTime(&nowNs, __func__) == RES_OK);
+        const int64_t MONO_END_AFTER = cmGetTimeNs();
+        const int64_t ELAPSED_NS = nowNs - startNs;
+        const int64_t SLACK_NS = CLOCK_SPAN_NS / 4;
+        assert(ELAPSED_NS >= MONO_END_BEFORE - MONO_START_AFTER - SLACK_NS);
+        assert(ELAPSED_NS <= MONO_END_AFTER - MONO_START_BEFORE + SLACK_NS);
+    }
+    assert(smSetClockSource(SM_CLOCK_MONOTONIC) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smInternalTscToNs_ScalesLargeTickCounts(void)
+{
+    // 2.5 GHz makes a tick 0.4 ns, so ticks * NS_PER_S alone would overflow here.
+    assert(smInternalTscToNs(10000000000000000000ULL, 2500000000ULL) == 4000000000000000000ULL);
+    assert(smInternalTscToNs(10000000000000000007ULL, 2500000000ULL) == 4000000000000000002ULL);
+
+    // A million seconds at 3 GHz, plus ticks that don't add up to a whole nanosecond.
+    assert(smInternalTscToNs(3000000000000000ULL, 3000000000ULL) == 1000000000000000ULL);
+    assert(smInternalTscToNs(3000000000000002ULL, 3000000000ULL) == 1000000000000000ULL);
+
+    // Below a second, only the remainder is scaled.
+    assert(smInternalTscToNs(1234, 3000000000ULL) == 411);
+    assert(smInternalTscToNs(2999999999ULL, 3000000000ULL) == 999999999);
+    assert(smInternalTscToNs(0, 3000000000ULL) == 0);
+    tsPass(__func__);
+}
+
+void Test_smSetClockSource_RestartsDtTiming(void)
+{
+    setup();
+    advanceMockTime(EXPECTED_DT_NS);
+    smGetDt();
+    advanceMockTime(2 * EXPECTED_DT_NS);
+    assert(smSetClockSource(SM_CLOCK_MONOTONIC) == RES_OK);
+    assert(fabsf(smGetDt() - 1.0f / DEFAULT_FPS) < DT_TOLERANCE);
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smSetTargetFps
+
+void Test_smSetTargetFps_RejectsNonPositiveFps(void)
+{
+    setup();
+    assert(smSetTargetFps(0) == RES_INVALID_ARG);
+    assert(smSetTargetFps(-1) == RES_INVALID_ARG);
+    assert(smSetTargetFps(PACED_FPS) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smWaitForNextFrame
+
+void Test_smWaitForNextFrame_SleepsUntilDeadline(void)
+{
+    setup();
+    assert(smSetTargetFps(PACED_FPS) == RES_OK);
+
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(mockTimeNs() == 0);
+
+    advanceMockTime(PACED_FRAME_NS / 2);
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(mockTimeNs() == PACED_FRAME_NS);
+
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(mockTimeNs() == 2 * PACED_FRAME_NS);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smWaitForNextFrame_RestartsScheduleAfterLateFrame(void)
+{
+    setup();
+    assert(smSetTargetFps(PACED_FPS) == RES_OK);
+    assert(smWaitForNextFrame() == RES_OK);
+
+    advanceMockTime(PACED_FRAME_NS * 3 / 2);
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(mockTimeNs() == PACED_FRAME_NS * 3 / 2);
+
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(mockTimeNs() == PACED_FRAME_NS * 5 / 2);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smWaitForNextFrame_FailsWhenClockGettimeFails(void)
+{
+    setup();
+    smMockClockGettimeFails = true;
+    assert(smWaitForNextFrame() == RES_CLOCK_GETTIME_FAIL);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smWaitForNextFrame_RunsIdleTasksOnlyUntilDeadline(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+    assert(smSetTargetFps(PACED_FPS) == RES_OK);
+    assert(smPostIdleTask(mockIdle, nullptr) == RES_OK);
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(smMockData->idleCount == 0);
+
+    const long FRAME_WORK_NS = PACED_FRAME_NS - 4 * IDLE_STEP_NS;
+    advanceMockTime(FRAME_WORK_NS);
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(smMockData->idleCount == 4);
+    assert(mockTimeNs() == PACED_FRAME_NS);
+
+    while (smMockData->idleCount < IDLE_STEPS)
+    {
+        advanceMockTime(FRAME_WORK_NS);
+        assert(smWaitForNextFrame() == RES_OK);
+    }
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(smMockData->idleCount == IDLE_STEPS);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smWaitForNextFrame_SkipsIdleTasksOnLateFrame(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+    assert(smSetTargetFps(PACED_FPS) == RES_OK);
+    assert(smPostIdleTask(mockIdle, nullptr) == RES_OK);
+    assert(smWaitForNextFrame() == RES_OK);
+
+    advanceMockTime(2 * PACED_FRAME_NS);
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(smMockData->idleCount == 0);
+
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smSetFrameBudget
+
+void Test_smSetFrameBudget_RejectsNegativeBudget(void)
+{
+    setup();
+    assert(smSetFrameBudget(-1.0f) == RES_INVALID_ARG);
+    assert(smSetFrameBudget(0.0f) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smGetQualityLevel
+
+void Test_smGetQualityLevel_StartsAtFull(void)
+{
+    setup();
+    assert(smGetQualityLevel() == SM_QUALITY_FULL);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetQualityLevel_LowersAfterSustainedOverBudgetFrames(void)
+{
+    setup();
+    assert(smSetTargetFps(PACED_FPS) == RES_OK);
+    assert(smWaitForNextFrame() == RES_OK);
+
+    for (int i = 0; i < GOVERNOR_LOWER_FRAMES - 1; i++)
+    {
+        advanceMockTime(2 * PACED_FRAME_NS);
+        assert(smWaitForNextFrame() == RES_OK);
+    }
+    assert(smGetQualityLevel() == SM_QUALITY_FULL);
+
+    advanceMockTime(2 * PACED_FRAME_NS);
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(smGetQualityLevel() == SM_QUALITY_HIGH);
+
+    for (int i = 0; i < 3 * GOVERNOR_LOWER_FRAMES; i++)
+    {
+        advanceMockTime(2 * PACED_FRAME_NS);
+        assert(smWaitForNextFrame() == RES_OK);
+    }
+    assert(smGetQualityLevel() == SM_QUALITY_LOW);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetQualityLevel_RaisesOnlyAfterSustainedHeadroom(void)
+{
+    setup();
+    assert(smSetTargetFps(PACED_FPS) == RES_OK);
+    assert(smWaitForNextFrame() == RES_OK);
+    while (smGetQualityLevel() != SM_QUALITY_HIGH)
+    {
+        advanceMockTime(2 * PACED_FRAME_NS);
+        assert(smWaitForNextFrame() == RES_OK);
+    }
+
+    // Just under budget is not enough headroom to raise the level again.
+    int level = smGetQualityLevel();
+    for (int i = 0; i < 2 * GOVERNOR_RAISE_FRAMES; i++)
+    {
+        advanceMockTime(PACED_FRAME_NS * 8 / 10);
+        assert(smWaitForNextFrame() == RES_OK);
+        assert(smGetQualityLevel() <= level);
+        level = smGetQualityLevel();
+    }
+
+    int frames = 0;
+    while (smGetQualityLevel() == level)
+    {
+        advanceMockTime(PACED_FRAME_NS / 4);
+        assert(smWaitForNextFrame() == RES_OK);
+        frames++;
+    }
+    assert(smGetQualityLevel() == level + 1);
+    assert(frames >= GOVERNOR_RAISE_FRAMES);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smGetQualityLevel_IgnoresIdleTaskTime(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+    assert(smSetTargetFps(PACED_FPS) == RES_OK);
+    assert(smPostIdleTask(mockIdle, nullptr) == RES_OK);
+    assert(smWaitForNextFrame() == RES_OK);
+
+    // Resetting the count keeps the task filling every frame's idle time.
+    for (int i = 0; i < GOVERNOR_RAISE_FRAMES; i++)
+    {
+        smMockData->idleCount = 0;
+        advanceMockTime(PACED_FRAME_NS / 2);
+        assert(smWaitForNextFrame() == RES_OK);
+    }
+    assert(smGetQualityLevel() == SM_QUALITY_FULL);
+
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smPostIdleTask
+
+void Test_smPostIdleTask_RejectsNullTask(void)
+{
+    setup();
+    assert(smPostIdleTask(nullptr, nullptr) == RES_NULL_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smPostIdleTask_FailsWhenQueueIsFull(void)
+{
+    setup();
+    for (int i = 0; i < IDLE_QUEUE_CAPACITY; i++)
+    {
+        assert(smPostIdleTask(mockIdle, nullptr) == RES_OK);
+    }
+    assert(smPostIdleTask(mockIdle, nullptr) == RES_IDLE_QUEUE_FULL);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smPostIdleTask_DropsTasksWhenOwnerSceneExits(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+    assert(smSetTargetFps(PACED_FPS) == RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smPostIdleTask(mockIdle, nullptr) == RES_OK);
+
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(smMockData->idleCount == 0);
+
+    assert(smPostIdleTask(mockIdle, nullptr) == RES_OK);
+    assert(smWaitForNextFrame() == RES_OK);
+    assert(smMockData->idleCount == IDLE_STEPS);
+
+    teardown();
+    tsPass(__func__);
+}
+
+// Messaging
+
+// -- smSetSceneMessageHandler
+
+void Test_smSetSceneMessageHandler_FailsForMissingScene(void)
+{
+    setup();
+    assert(smSetSceneMessageHandler(mock.name, mockHandleMessage) == RES_SCENE_NOT_FOUND);
+    assert(smSetSceneMessageHandler(nullptr, mockHandleMessage) == RES_NULL_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smSetMessageMode
+
+void Test_smSetMessageMode_RejectsInvalidMode(void)
+{
+    setup();
+    assert(smSetMessageMode((smMessageMode)-1) == RES_INVALID_ARG);
+    assert(smSetMessageMode(SM_MESSAGES_SPSC + 1) == RES_INVALID_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+// -- smPostMessage
+
+void Test_smPostMessage_RejectsInvalidPayload(void)
+{
+    setup();
+    unsigned char data[SM_MESSAGE_DATA_SIZE + 1] = {0};
+    assert(smPostMessage(0, data, sizeof(data)) == RES_INVALID_ARG);
+    assert(smPostMessage(0, nullptr, 1) == RES_NULL_ARG);
+    assert(smPostMessage(0, nullptr, 0) == RES_OK);
+    assert(smPostMessage(0, data, SM_MESSAGE_DATA_SIZE) == RES_OK);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smPostMessage_DeliversInOrderBeforeUpdate(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+    assert(smCreateScene(mock.name, mockEnter, messageCheckingUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneMessageHandler(mock.name, mockHandleMessage) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    for (int i = 0; i < 3; i++)
+    {
+        assert(postNumbered(i) == RES_OK);
+    }
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(smMockData->messageCount == 3);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smPostMessage_WaitsWhileNoSceneIsActive(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneMessageHandler(mock.name, mockHandleMessage) == RES_OK);
+
+    assert(postNumbered(0) == RES_OK);
+    assert(smUpdate(mockDt) == RES_NO_CURR_SCENE);
+    assert(smMockData->messageCount == 0);
+
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(smMockData->messageCount == 1);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smPostMessage_DropsMessagesWithoutHandler(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    assert(postNumbered(0) == RES_OK);
+    assert(smUpdate(mockDt) == RES_OK);
+
+    assert(smSetSceneMessageHandler(mock.name, mockHandleMessage) == RES_OK);
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(smMockData->messageCount == 0);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smPostMessage_FailsWhenQueueIsFullInEitherMode(void)
+{
+    const smMessageMode MODES[] = {SM_MESSAGES_MPSC, SM_MESSAGES_SPSC};
+    for (size_t m = 0; m < sizeof(MODES) / sizeof(MODES[0]); m++)
+    {
+        setup();
+        smMockData = &(MockData){0};
+        assert(smSetMessageMode(MODES[m]) == RES_OK);
+        assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+        assert(smSetSceneMessageHandler(mock.name, mockHandleMessage) == RES_OK);
+        assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+        // Two laps, so every slot is reused after being drained.
+        int posted = 0;
+        for (int lap = 0; lap < 2; lap++)
+        {
+            for (int i = 0; i < MESSAGE_QUEUE_CAPACITY; i++)
+            {
+                assert(postNumbered(posted++) == RES_OK);
+            }
+            assert(postNumbered(posted) == RES_MESSAGE_QUEUE_FULL);
+            assert(smUpdate(mockDt) == RES_OK);
+            assert(smMockData->messageCount == posted);
+        }
+
+        teardown();
+    }
+    tsPass(__func__);
+}
+
+void Test_smPostMessage_DropsQueuedMessagesOnStop(void)
+{
+    setup();
+    assert(postNumbered(0) == RES_OK);
+    teardown();
+
+    setup();
+    smMockData = &(MockData){0};
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneMessageHandler(mock.name, mockHandleMessage) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(smMockData->messageCount == 0);
+    teardown();
+    tsPass(__func__);
+}
+
+// Timers
+
+// -- smAddTimer
+
+void Test_smAddTimer_RejectsInvalidArgs(void)
+{
+    setup();
+    assert(smAddTimer(1.0f, 0.0f, nullptr, nullptr, nullptr) == RES_NULL_ARG);
+    assert(smAddTimer(-1.0f, 0.0f, mockTimer, nullptr, nullptr) == RES_INVALID_ARG);
+    assert(smAddTimer(1.0f, -1.0f, mockTimer, nullptr, nullptr) == RES_INVALID_ARG);
+    assert(smAddTimer(NAN, 0.0f, mockTimer, nullptr, nullptr) == RES_INVALID_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smAddTimer_FiresOnceAfterDelay(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smAddTimer(0.05f, 0.0f, mockTimer, nullptr, nullptr) == RES_OK);
+
+    for (int i = 0; i < 3; i++)
+    {
+        assert(smUpdate(0.016f) == RES_OK);
+    }
+    assert(smMockData->timerCount == 0);
+
+    assert(smUpdate(0.016f) == RES_OK);
+    assert(smMockData->timerCount == 1);
+
+    assert(smUpdate(1.0f) == RES_OK);
+    assert(smMockData->timerCount == 1);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smAddTimer_RepeatsOncePerElapsedInterval(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smAddTimer(0.01f, 0.01f, mockTimer, nullptr, nullptr) == RES_OK);
+
+    assert(smUpdate(0.1f) == RES_OK);
+    assert(smMockData->timerCount == 10);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_smAddTimer_FiresLongDelaysAcrossWheelLevels(void)
+{
+    setup();
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    // 100 s cascades from the third level; 20000 s is past the wheel's span.
+    const int SHORT_S = 100;
+    const int LONG_S = 20000;
+    int shortCount = 0;
+    int longCount = 0;
+    assert(smAddTimer((float)SHORT_S, 0.0f, countTimer, &shortCount, nullptr) == RES_OK);
+    assert(smAddTimer((float)LONG_S, 0.0f, countTimer, &longCount, nullptr) == RES_OK);
+
+    for (int s = 1; s <= LONG_S; s++)
+    {
+        assert(smUpdate(1.0f) == RES_OK);
+        assert(shortCount == (s >= SHORT_S));
+        assert(longCount == (s >= LONG_S));
+    }
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smDeleteScene_AcceptsNonCurrentScene(void)
+void Test_smAddTimer_CancelsTimersWhenOwnerSceneExits(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(smDeleteScene(mock.name) == RES_OK);
+    smMockData = &(MockData){0};
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    smTimerId id;
+    assert(smAddTimer(0.01f, 0.0f, mockTimer, nullptr, &id) == RES_OK);
+    assert(smAddTimer(0.01f, 0.01f, mockTimer, nullptr, nullptr) == RES_OK);
+
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smUpdate(1.0f) == RES_OK);
+    assert(smMockData->timerCount == 0);
+    assert(smCancelTimer(id) == RES_TIMER_NOT_FOUND);
+
+    assert(smAddTimer(0.01f, 0.0f, mockTimer, nullptr, nullptr) == RES_OK);
+    assert(smUpdate(1.0f) == RES_OK);
+    assert(smMockData->timerCount == 1);
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smDeleteScene_RejectsEmptyName(void)
+void Test_smAddTimer_CallbackCanCancelItsOwnTimer(void)
 {
     setup();
-    assert(smDeleteScene("") == RES_EMPTY_ARG);
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    SelfCancellingTimer timer = {0};
+    assert(smAddTimer(0.01f, 0.01f, selfCancellingTimer, &timer, &timer.id) == RES_OK);
+    assert(smUpdate(1.0f) == RES_OK);
+    assert(timer.fireCount == 3);
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smDeleteScene_FailsWhenDeletingSameSceneTwice(void)
+// -- smCancelTimer
+
+void Test_smCancelTimer_PreventsFiringAndInvalidatesId(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(smDeleteScene(mock.name) == RES_OK);
-    assert(smDeleteScene(mock.name) == RES_SCENE_NOT_FOUND);
+    smMockData = &(MockData){0};
+    assert(smCancelTimer(0) == RES_TIMER_NOT_FOUND);
+
+    smTimerId id;
+    assert(smAddTimer(0.01f, 0.0f, mockTimer, nullptr, &id) == RES_OK);
+    assert(id != 0);
+    assert(smCancelTimer(id) == RES_OK);
+    assert(smCancelTimer(id) == RES_TIMER_NOT_FOUND);
+
+    // The next timer reuses the freed slot, but the old handle must not reach it.
+    smTimerId reusedId;
+    assert(smAddTimer(0.01f, 0.0f, mockTimer, nullptr, &reusedId) == RES_OK);
+    assert(reusedId != id);
+    assert(smCancelTimer(id) == RES_TIMER_NOT_FOUND);
+
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smUpdate(1.0f) == RES_OK);
+    assert(smMockData->timerCount == 1);
+    assert(smCancelTimer(reusedId) == RES_TIMER_NOT_FOUND);
+
     teardown();
     tsPass(__func__);
 }
 
-// -- smGetSceneCount
+// Tweens
 
-void Test_smGetSceneCount_ReturnsZeroPostStart(void)
+// -- smAddTween
+
+void Test_smAddTween_RejectsInvalidArgs(void)
 {
     setup();
-    assert(smGetSceneCount() == 0);
+    float value = 0.0f;
+    assert(smAddTween(nullptr, 0.0f, 1.0f, 1.0f, SM_EASE_LINEAR, nullptr) == RES_NULL_ARG);
+    assert(smAddTween(&value, 0.0f, 1.0f, 0.0f, SM_EASE_LINEAR, nullptr) == RES_INVALID_ARG);
+    assert(smAddTween(&value, 0.0f, 1.0f, NAN, SM_EASE_LINEAR, nullptr) == RES_INVALID_ARG);
+    assert(smAddTween(&value, 0.0f, 1.0f, 1.0f, (smEasing)-1, nullptr) == RES_INVALID_ARG);
+    assert(smAddTween(&value, 0.0f, 1.0f, 1.0f, SM_EASE_SMOOTHSTEP + 1, nullptr) == RES_INVALID_ARG);
     teardown();
     tsPass(__func__);
 }
 
-void Test_smGetSceneCount_ReturnsCorrectSceneCountPostCreateScene(void)
+void Test_smAddTween_ReachesTargetExactlyThenStops(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(smGetSceneCount() == 1);
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    float value = 0.0f;
+    smTweenId id;
+    assert(smAddTween(&value, 0.0f, 10.0f, 1.0f, SM_EASE_LINEAR, &id) == RES_OK);
+
+    assert(smUpdate(0.25f) == RES_OK);
+    assert(fabsf(value - 2.5f) < EASE_TOLERANCE);
+    for (int i = 0; i < 3; i++)
+    {
+        assert(smUpdate(0.25f) == RES_OK);
+    }
+    assert(value == 10.0f);
+
+    // Finished tweens are gone, so they no longer write or cancel.
+    value = -1.0f;
+    assert(smUpdate(0.25f) == RES_OK);
+    assert(value == -1.0f);
+    assert(smCancelTween(id) == RES_TWEEN_NOT_FOUND);
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smGetSceneCount_ReturnsCorrectSceneCountPostDeleteScene(void)
+void Test_smAddTween_EasingCurvesMatchReferenceValues(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
-    assert(smDeleteScene(mock.name) == RES_OK);
-    assert(smGetSceneCount() == 0);
-    teardown();
-    tsPass(__func__);
-}
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
 
-// Lifecycle Functions
+    // Expected eased progress at a quarter and at half of each curve.
+    const struct
+    {
+        smEasing easing;
+        float atQuarter;
+        float atHalf;
+    } CURVES[] = {
+        {SM_EASE_LINEAR, 0.25f, 0.5f},
+        {SM_EASE_IN_QUAD, 0.0625f, 0.25f},
+        {SM_EASE_OUT_QUAD, 0.4375f, 0.75f},
+        {SM_EASE_IN_OUT_QUAD, 0.125f, 0.5f},
+        {SM_EASE_IN_CUBIC, 0.015625f, 0.125f},
+        {SM_EASE_OUT_CUBIC, 0.578125f, 0.875f},
+        {SM_EASE_IN_OUT_CUBIC, 0.0625f, 0.5f},
+        {SM_EASE_SMOOTHSTEP, 0.15625f, 0.5f},
+    };
+    const size_t CURVE_COUNT = sizeof(CURVES) / sizeof(CURVES[0]);
 
-// -- smUpdate
+    float values[sizeof(CURVES) / sizeof(CURVES[0])];
+    for (size_t i = 0; i < CURVE_COUNT; i++)
+    {
+        assert(smAddTween(&values[i], 0.0f, 1.0f, 1.0f, CURVES[i].easing, nullptr) == RES_OK);
+    }
+
+    assert(smUpdate(0.25f) == RES_OK);
+    for (size_t i = 0; i < CURVE_COUNT; i++)
+    {
+        assert(fabsf(values[i] - CURVES[i].atQuarter) < EASE_TOLERANCE);
+    }
+
+    assert(smUpdate(0.25f) == RES_OK);
+    for (size_t i = 0; i < CURVE_COUNT; i++)
+    {
+        assert(fabsf(values[i] - CURVES[i].atHalf) < EASE_TOLERANCE);
+    }
+
+    assert(smUpdate(0.5f) == RES_OK);
+    for (size_t i = 0; i < CURVE_COUNT; i++)
+    {
+        assert(values[i] == 1.0f);
+    }
 
-void Test_smUpdate_FailsWhenNullCurrentScene(void)
-{
-    setup();
-    assert(!smGetCurrentSceneName());
-    assert(smUpdate(mockDt) == RES_NO_CURR_SCENE);
     teardown();
     tsPass(__func__);
 }
 
-void Test_smUpdate_CallsNonNullUpdateOfCurrentScene(void)
+void Test_smAddTween_CancelsTweensWhenOwnerSceneExits(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, nullptr, mockUpdate, nullptr, nullptr) ==
-        RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
     assert(smSetScene(mock.name, nullptr) == RES_OK);
-    assert(smUpdate(mockDt) == RES_OK);
+
+    float owned = 0.0f;
+    smTweenId id;
+    assert(smAddTween(&owned, 0.0f, 1.0f, 1.0f, SM_EASE_LINEAR, &id) == RES_OK);
+    assert(smUpdate(0.5f) == RES_OK);
+
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    float kept = 0.0f;
+    assert(smAddTween(&kept, 0.0f, 1.0f, 1.0f, SM_EASE_LINEAR, nullptr) == RES_OK);
+    assert(smUpdate(0.5f) == RES_OK);
+
+    assert(fabsf(owned - 0.5f) < EASE_TOLERANCE);
+    assert(fabsf(kept - 0.5f) < EASE_TOLERANCE);
+    assert(smCancelTween(id) == RES_TWEEN_NOT_FOUND);
+
     teardown();
     tsPass(__func__);
 }
 
-void Test_smUpdate_FailsWhenNullUpdate(void)
+void Test_smAddTween_StepsLargeGroupsOnJobPool(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
+    assert(smSetParallelTweens(true) == RES_OK);
+    assert(cmJobsIsRunning());
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
     assert(smSetScene(mock.name, nullptr) == RES_OK);
-    assert(smUpdate(mockDt) == RES_NO_UPDATE_FUNC);
+
+    const int COUNT = TWEEN_PARALLEL_MIN * 2;
+    float *values = calloc(COUNT, sizeof(float));
+    assert(values);
+    for (int i = 0; i < COUNT; i++)
+    {
+        assert(smAddTween(&values[i], 0.0f, (float)i, 1.0f, SM_EASE_LINEAR, nullptr) == RES_OK);
+    }
+
+    assert(smUpdate(0.5f) == RES_OK);
+    for (int i = 0; i < COUNT; i++)
+    {
+        assert(fabsf(values[i] - 0.5f * (float)i) <= EASE_TOLERANCE * (float)i);
+    }
+    assert(smUpdate(0.5f) == RES_OK);
+    for (int i = 0; i < COUNT; i++)
+    {
+        assert(values[i] == (float)i);
+    }
+
+    free(values);
+    assert(smSetParallelTweens(false) == RES_OK);
+    assert(!cmJobsIsRunning());
     teardown();
     tsPass(__func__);
 }
 
-// -- smGetDt
+// -- smSetParallelTweens
 
-void Test_smGetDt_UsesDefaultDtOnFirstCall(void)
+void Test_smSetParallelTweens_HoldsOneShareUntilStop(void)
 {
     setup();
-    float target = 1.0f / DEFAULT_FPS;
-    assert(fabsf(smGetDt() - target) < DT_TOLERANCE);
+    assert(smSetParallelTweens(true) == RES_OK);
+    assert(smSetParallelTweens(true) == RES_OK);
+    assert(cmJobsIsRunning());
+
     teardown();
+    assert(!cmJobsIsRunning());
     tsPass(__func__);
 }
 
-void Test_smGetDt_UpdatesDtOnConsecutiveCalls(void)
+// -- smCancelTween
+
+void Test_smCancelTween_LeavesTargetAndInvalidatesId(void)
 {
     setup();
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+    assert(smCancelTween(0) == RES_TWEEN_NOT_FOUND);
 
-    // Arbitrary time for first smGetDt call
-    smMockCurrTime.tv_nsec = EXPECTED_DT_NS;
-    smMockCurrTime.tv_sec = 0;
+    float value = 0.0f;
+    smTweenId id;
+    assert(smAddTween(&value, 0.0f, 1.0f, 1.0f, SM_EASE_LINEAR, &id) == RES_OK);
+    assert(smUpdate(0.5f) == RES_OK);
+    assert(smCancelTween(id) == RES_OK);
+    assert(smCancelTween(id) == RES_TWEEN_NOT_FOUND);
 
-    smGetDt(); // First call uses default dt
+    assert(smUpdate(0.25f) == RES_OK);
+    assert(fabsf(value - 0.5f) < EASE_TOLERANCE);
 
-    for (int i = 0; i < FRAME_TIME_ITERATIONS; i++)
-    {
-        smMockCurrTime.tv_nsec += EXPECTED_DT_NS;
-        if (smMockCurrTime.tv_nsec >= NS_PER_S)
-        {
-            smMockCurrTime.tv_sec += smMockCurrTime.tv_nsec / NS_PER_S;
-            smMockCurrTime.tv_nsec %= NS_PER_S;
-        }
-        assert(fabsf(smGetDt() - EXPECTED_DT_S) < DT_TOLERANCE);
-    }
+    // The next tween reuses the freed slot, but the old handle must not reach it.
+    smTweenId reusedId;
+    assert(smAddTween(&value, 0.0f, 1.0f, 1.0f, SM_EASE_LINEAR, &reusedId) == RES_OK);
+    assert(reusedId != id);
+    assert(smCancelTween(id) == RES_TWEEN_NOT_FOUND);
+    assert(smCancelTween(reusedId) == RES_OK);
 
     teardown();
     tsPass(__func__);
 }
 
-void Test_smGetDt_FailsWhenClockGettimeFails(void)
+// Performance Counters
+
+// -- smSetPerfCounters
+
+void Test_smSetPerfCounters_CountsEachCallbackOfCurrentScene(void)
 {
     setup();
-    smMockClockGettimeFails = true;
-    assert(smGetDt() == (float) RES_CLOCK_GETTIME_FAIL);
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    // Counters depend on the host, so both outcomes are valid but must be consistent.
+    const int RESULT = smSetPerfCounters(true);
+    assert(RESULT == RES_OK || RESULT == RES_PERF_UNAVAILABLE);
+    assert(smSetPerfCounters(true) == RESULT);
+
+    for (int i = 0; i < 3; i++)
+    {
+        assert(smUpdate(mockDt) == RES_OK);
+    }
+    assert(smDraw() == RES_OK);
+
+    smPerfCounters update, draw, other;
+    assert(smGetScenePerfCounters(mock.name, &update, &draw) == RES_OK);
+    assert(smGetScenePerfCounters(mock2.name, &other, nullptr) == RES_OK);
+    assert(update.calls == (RESULT == RES_OK ? 3 : 0));
+    assert(draw.calls == (RESULT == RES_OK ? 1 : 0));
+    assert(other.calls == 0 && other.cycles == 0 && other.instructions == 0);
+
+    // Once off, totals stay where they were.
+    assert(smSetPerfCounters(false) == RES_OK);
+    assert(smSetPerfCounters(false) == RES_OK);
+    assert(smUpdate(mockDt) == RES_OK);
+    assert(smGetScenePerfCounters(mock.name, &update, nullptr) == RES_OK);
+    assert(update.calls == (RESULT == RES_OK ? 3 : 0));
+
     teardown();
     tsPass(__func__);
 }
 
+// -- smGetScenePerfCounters
 
-// -- smDraw
-
-void Test_smDraw_FailsWhenNullCurrentScene(void)
+void Test_smGetScenePerfCounters_RejectsInvalidScenes(void)
 {
     setup();
-    assert(!smGetCurrentSceneName());
-    assert(smDraw() == RES_NO_CURR_SCENE);
+    smPerfCounters update;
+    assert(smGetScenePerfCounters(nullptr, &update, nullptr) == RES_NULL_ARG);
+    assert(smGetScenePerfCounters("", &update, nullptr) == RES_EMPTY_ARG);
+    assert(smGetScenePerfCounters(mock.name, &update, nullptr) == RES_SCENE_NOT_FOUND);
     teardown();
     tsPass(__func__);
 }
 
-void Test_smDraw_CallsValidDrawFunction(void)
+// Stop Related
+
+void Test_smStop_CallsNonNullExitOfCurrentScene(void)
 {
     setup();
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
     assert(
-        smCreateScene(mock.name, nullptr, nullptr, mockDraw, nullptr) ==
+        smCreateScene(mock.name, nullptr, nullptr, nullptr, mockExit) ==
         RES_OK);
     assert(smSetScene(mock.name, nullptr) == RES_OK);
-    assert(smDraw() == RES_OK);
-    teardown();
+    assert(smStop() == RES_OK);
+    assert(smMockData->exitCount == 1);
+
+    resetHooks();
     tsPass(__func__);
 }
 
-void Test_smDraw_FailsWhenNullDraw(void)
+void Test_smStop_ExitsSuspendedScenes(void)
 {
     setup();
-    assert(
-        smCreateScene(mock.name, mockEnter, nullptr, nullptr, nullptr) ==
-        RES_OK);
+    smTestExit = onExit;
+    smMockData = &(MockData){0};
+
+    assert(smSetSuspendBudget(SUSPEND_COST) == RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smCreateScene(mock2.name, mockEnter, nullptr, nullptr, mockExit) == RES_OK);
+    assert(smSetSceneSuspend(mock.name, mockSuspend, mockResume, SUSPEND_COST) == RES_OK);
     assert(smSetScene(mock.name, nullptr) == RES_OK);
-    assert(smDraw() == RES_NO_DRAW_FUNC);
-    teardown();
+    assert(smSetScene(mock2.name, nullptr) == RES_OK);
+    assert(smStop() == RES_OK);
+    assert(smMockData->exitCount == 2);
+
+    resetHooks();
     tsPass(__func__);
 }
 
-// Stop Related
-
-void Test_smStop_CallsNonNullExitOfCurrentScene(void)
+void Test_smStop_ExitsPendingScene(void)
 {
     setup();
     smTestExit = onExit;
     smMockData = &(MockData){0};
 
-    assert(
-        smCreateScene(mock.name, nullptr, nullptr, nullptr, mockExit) ==
-        RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetSceneLoader(mock.name, mockLoad) == RES_OK);
     assert(smSetScene(mock.name, nullptr) == RES_OK);
     assert(smStop() == RES_OK);
     assert(smMockData->exitCount == 1);
@@ -873,6 +2874,38 @@ void Test_smStop_SkipsNullExitOfCurrentScene(void)
     tsPass(__func__);
 }
 
+void Test_smStop_WritesSampledStacksTaggedWithScene(void)
+{
+    setup();
+    assert(pfStart() == RES_OK);
+    assert(smCreateScene(mock.name, mockEnter, cpuBurningUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    // Sampling only exists on some platforms, so both outcomes are valid.
+    const int RESULT = pfStartSampling(SAMPLING_HZ, SAMPLES_PATH);
+    assert(RESULT == RES_OK || RESULT == RES_SAMPLING_UNSUPPORTED);
+    assert(smUpdate(mockDt) == RES_OK);
+    teardown();
+
+    if (RESULT == RES_OK)
+    {
+        // Samples taken while stopping go untagged, so look at every line.
+        char line[1024];
+        bool isTagged = false;
+        FILE *file = fopen(SAMPLES_PATH, "r");
+        assert(file);
+        while (fgets(line, sizeof(line), file))
+        {
+            isTagged |= strncmp(line, "mock;", 5) == 0;
+        }
+        fclose(file);
+        assert(isTagged);
+    }
+    assert(pfStop() == RES_OK);
+    remove(SAMPLES_PATH);
+    tsPass(__func__);
+}
+
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Post-Stop
@@ -958,6 +2991,51 @@ void Test_smDraw_FailsPostStop(void)
     tsPass(__func__);
 }
 
+// Messaging
+
+void Test_smPostMessage_FailsPostStop(void)
+{
+    setup();
+    teardown();
+    assert(smPostMessage(0, nullptr, 0) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+// Tweens
+
+void Test_smAddTween_FailsPostStop(void)
+{
+    setup();
+    teardown();
+    float value = 0.0f;
+    assert(smAddTween(&value, 0.0f, 1.0f, 1.0f, SM_EASE_LINEAR, nullptr) == RES_NOT_RUNNING);
+    assert(smCancelTween(1) == RES_NOT_RUNNING);
+    assert(smSetParallelTweens(true) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+// Performance Counters
+
+void Test_smSetPerfCounters_FailsPostStop(void)
+{
+    setup();
+    teardown();
+    assert(smSetPerfCounters(true) == RES_NOT_RUNNING);
+    assert(smGetScenePerfCounters(mock.name, nullptr, nullptr) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+// Timers
+
+void Test_smAddTimer_FailsPostStop(void)
+{
+    setup();
+    teardown();
+    assert(smAddTimer(1.0f, 0.0f, mockTimer, nullptr, nullptr) == RES_NOT_RUNNING);
+    assert(smCancelTimer(1) == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
 // Stop Related
 
 void Test_smStop_IsIdempotentPostStop(void)
@@ -1029,6 +3107,76 @@ void TestStress_smSetScene_SettingScenesOftenCausesNoSkips(void)
 
 // Stop Related
 
+void TestStress_smAddTimer_ManyTimersFireOnTime(void)
+{
+    setup();
+    smMockData = &(MockData){0};
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    // Spread over every wheel level below the span, then cancel every third.
+    static long delaysMs[STRESS_ITERATIONS];
+    smTimerId ids[STRESS_ITERATIONS];
+    for (int i = 0; i < STRESS_ITERATIONS; i++)
+    {
+        delaysMs[i] = 1 + (long)i * i * 7 % 300000;
+        assert(smAddTimer((float)delaysMs[i] / 1000.0f, 0.0f, deadlineCheckingTimer, &delaysMs[i],
+                          &ids[i]) == RES_OK);
+    }
+    for (int i = 0; i < STRESS_ITERATIONS; i += 3)
+    {
+        assert(smCancelTimer(ids[i]) == RES_OK);
+    }
+
+    timerNowMs = 0;
+    while (timerNowMs < 300000)
+    {
+        timerNowMs += TIMER_STEP_MS;
+        assert(smUpdate(TIMER_STEP_MS / 1000.0f) == RES_OK);
+    }
+    assert(smMockData->timerCount == STRESS_ITERATIONS - (STRESS_ITERATIONS + 2) / 3);
+
+    teardown();
+    tsPass(__func__);
+}
+
+void TestStress_smAddTween_ManyTweensFinishOnTarget(void)
+{
+    setup();
+    assert(smCreateScene(mock.name, mockEnter, mockUpdate, mockDraw, mockExit) == RES_OK);
+    assert(smSetScene(mock.name, nullptr) == RES_OK);
+
+    // Mixed curves and lengths, so groups grow and entries move as tweens finish.
+    static float values[STRESS_ITERATIONS];
+    smTweenId ids[STRESS_ITERATIONS];
+    for (int i = 0; i < STRESS_ITERATIONS; i++)
+    {
+        values[i] = 0.0f;
+        float duration = 0.1f + (float)(i % 17) * 0.1f;
+        smEasing easing = (smEasing)(i % (SM_EASE_SMOOTHSTEP + 1));
+        assert(smAddTween(&values[i], 0.0f, (float)i, duration, easing, &ids[i]) == RES_OK);
+    }
+
+    assert(smUpdate(0.05f) == RES_OK);
+    for (int i = 0; i < STRESS_ITERATIONS; i += 3)
+    {
+        assert(smCancelTween(ids[i]) == RES_OK);
+    }
+
+    for (int step = 0; step < 40; step++)
+    {
+        assert(smUpdate(0.05f) == RES_OK);
+    }
+    // Cancelled tweens stop part-way; the rest run past their longest duration.
+    for (int i = 1; i < STRESS_ITERATIONS; i++)
+    {
+        assert(i % 3 == 0 ? values[i] < (float)i : values[i] == (float)i);
+    }
+
+    teardown();
+    tsPass(__func__);
+}
+
 void TestStress_smStop_FreeingMultipleScenesCausesNoSkips(void)
 {
     setup();
@@ -1052,113 +3200,248 @@ void TestStress_smStop_FreeingMultipleScenesCausesNoSkips(void)
 int main()
 {
     puts("\nBASE TESTS");
-    Test_smStop_SucceedsPostStart();
+    tsRun(Test_smStop_SucceedsPostStart);
 
     puts("\nPRE-START TESTING");
     puts("• Start Related");
-    Test_smHasStarted_FailsPreStart();
+    tsRun(Test_smHasStarted_FailsPreStart);
     puts("• Scene Functions");
-    Test_smCreateScene_FailsPreStart();
-    Test_smSceneExists_FailsPreStart();
-    Test_smSetScene_FailsPreStart();
-    Test_smGetCurrentSceneName_FailsPreStart();
-    Test_smDeleteScene_FailsPreStart();
-    Test_smGetSceneCount_FailsPreStart();
+    tsRun(Test_smCreateScene_FailsPreStart);
+    tsRun(Test_smRegisterScenes_FailsPreStart);
+    tsRun(Test_smSetRegistry_FailsPreStart);
+    tsRun(Test_smSceneExists_FailsPreStart);
+    tsRun(Test_smSetScene_FailsPreStart);
+    tsRun(Test_smSetSceneSuspend_FailsPreStart);
+    tsRun(Test_smSetSuspendBudget_FailsPreStart);
+    tsRun(Test_smIsSceneSuspended_FailsPreStart);
+    tsRun(Test_smSetSceneLoader_FailsPreStart);
+    tsRun(Test_smSetLoadingScene_FailsPreStart);
+    tsRun(Test_smSetLoadBudget_FailsPreStart);
+    tsRun(Test_smIsSceneLoading_FailsPreStart);
+    tsRun(Test_smGetCurrentSceneName_FailsPreStart);
+    tsRun(Test_smDeleteScene_FailsPreStart);
+    tsRun(Test_smGetSceneCount_FailsPreStart);
     puts("• Lifecycle Functions");
-    Test_smUpdate_FailsPreStart();
-    Test_smGetDt_FailsPreStart();
-    Test_smDraw_FailsPreStart();
+    tsRun(Test_smUpdate_FailsPreStart);
+    tsRun(Test_smGetDt_FailsPreStart);
+    tsRun(Test_smDraw_FailsPreStart);
     puts("• Stop Related");
-    Test_smStop_FailsPreStart();
+    tsRun(Test_smStop_FailsPreStart);
 
     puts("\nSTART TESTING");
     puts("• Mem Alloc Fail");
-    Test_smStart_FailsWhenCallocFails();
+    tsRun(Test_smStart_FailsWhenCallocFails);
 
     puts("\nPOST-START TESTING");
     puts("• Start Related");
-    Test_smStart_IsIdempotentPostStart();
-    Test_smHasStarted_SucceedsPostStart();
+    tsRun(Test_smStart_IsIdempotentPostStart);
+    tsRun(Test_smHasStarted_SucceedsPostStart);
     puts("• Scene Functions");
     puts(" • smCreateScene");
     puts("  • Name Related");
-    Test_smCreateScene_AcceptsValidName();
-    Test_smCreateScene_RejectsExistingName();
-    Test_smCreateScene_RejectsNullName();
-    Test_smCreateScene_RejectsEmptyName();
+    tsRun(Test_smCreateScene_AcceptsValidName);
+    tsRun(Test_smCreateScene_RejectsExistingName);
+    tsRun(Test_smCreateScene_RejectsNullName);
+    tsRun(Test_smCreateScene_RejectsEmptyName);
 
     puts("  • Scene Functions Related");
-    Test_smCreateScene_AcceptsAllValidFunctionCombinations();
-    Test_smCreateScene_RejectsValidNameAndAllNullFunctions();
-    Test_smCreateScene_FailsWhenSceneAllocFails();
-    Test_smCreateScene_FailsWhenNameAllocFails();
-    Test_smCreateScene_FailsWhenMapEntryAllocFails();
+    tsRun(Test_smCreateScene_AcceptsAllValidFunctionCombinations);
+    tsRun(Test_smCreateScene_RejectsValidNameAndAllNullFunctions);
+    tsRun(Test_smCreateScene_FailsWhenSceneAllocFails);
+    tsRun(Test_smCreateScene_FailsWhenNameAllocFails);
+    tsRun(Test_smCreateScene_FailsWhenMapEntryAllocFails);
+    puts(" • smRegisterScenes");
+    tsRun(Test_smRegisterScenes_RegistersAllScenes);
+    tsRun(Test_smRegisterScenes_RejectsNullDescs);
+    tsRun(Test_smRegisterScenes_RejectsEmptyTable);
+    tsRun(Test_smRegisterScenes_RejectsInvalidDescAndRegistersNone);
+    tsRun(Test_smRegisterScenes_RejectsRepeatedNameAndRegistersNone);
+    tsRun(Test_smRegisterScenes_RejectsExistingName);
+    tsRun(Test_smRegisterScenes_FailsWhenBlockAllocFails);
+    puts(" • smSetRegistry");
+    tsRun(Test_smSetRegistry_FindsRegistryScenes);
+    tsRun(Test_smSetRegistry_RejectsNullRegistry);
+    tsRun(Test_smSetRegistry_RejectsSecondRegistry);
+    tsRun(Test_smSetRegistry_RejectsRegisteredName);
+    tsRun(Test_smSetRegistry_KeepsRegistryScenesFromBeingRecreatedOrDeleted);
+    tsRun(Test_smSetRegistry_FailsWhenStateAllocFails);
     puts(" • smSceneExists");
-    Test_smSceneExists_AcceptsCreatedName();
-    Test_smSceneExists_RejectsNonCreatedName();
+    tsRun(Test_smSceneExists_AcceptsCreatedName);
+    tsRun(Test_smSceneExists_RejectsNonCreatedName);
     puts(" • smSetScene");
-    Test_smSetScene_AcceptsValidSceneFromNull();
-    Test_smSetScene_RejectsNullName();
-    Test_smSetScene_RejectsEmptyName();
-    Test_smSetScene_RejectsNonCreatedName();
-    Test_smSetScene_SucceedsChangingFromOneSceneToAnotherWithNoArgs();
-    Test_smSetScene_CallsNonNullExitOfCurrentScene();
-    Test_smSetScene_SkipsNullExitOfCurrentScene();
-    Test_smSetScene_CallsNonNullEnterOfTargetScene();
-    Test_smSetScene_SkipsNullEnterOfTargetScene();
-    Test_smSetScene_CallsNonNullExitAndNonNullEnterWhenTargetingSameScene();
-    Test_smSetScene_CallsNonNullEnterWithArgsOfTargetScene();
+    tsRun(Test_smSetScene_AcceptsValidSceneFromNull);
+    tsRun(Test_smSetScene_RejectsNullName);
+    tsRun(Test_smSetScene_RejectsEmptyName);
+    tsRun(Test_smSetScene_RejectsNonCreatedName);
+    tsRun(Test_smSetScene_SucceedsChangingFromOneSceneToAnotherWithNoArgs);
+    tsRun(Test_smSetScene_CallsNonNullExitOfCurrentScene);
+    tsRun(Test_smSetScene_SkipsNullExitOfCurrentScene);
+    tsRun(Test_smSetScene_CallsNonNullEnterOfTargetScene);
+    tsRun(Test_smSetScene_SkipsNullEnterOfTargetScene);
+    tsRun(Test_smSetScene_CallsNonNullExitAndNonNullEnterWhenTargetingSameScene);
+    tsRun(Test_smSetScene_CallsNonNullEnterWithArgsOfTargetScene);
+    puts(" • smSetSceneSuspend");
+    tsRun(Test_smSetSceneSuspend_RejectsNullName);
+    tsRun(Test_smSetSceneSuspend_RejectsNonCreatedName);
+    tsRun(Test_smSetScene_ExitsSuspendableSceneWhenBudgetIsZero);
+    tsRun(Test_smSetScene_SuspendsOutgoingSceneWithinBudget);
+    tsRun(Test_smSetScene_ResumesSuspendedSceneInsteadOfEntering);
+    tsRun(Test_smSetScene_EvictsLeastRecentlyUsedSceneOverBudget);
+    tsRun(Test_smSetScene_DoesNotEvictSuspendedTargetScene);
+    tsRun(Test_smSetSceneSuspend_EvictsSceneWhenSuspendIsCleared);
+    puts(" • smSetSuspendBudget");
+    tsRun(Test_smSetSuspendBudget_EvictsScenesWhenLowered);
+    puts(" • smSetSceneLoader");
+    tsRun(Test_smSetSceneLoader_RejectsNonCreatedName);
+    tsRun(Test_smSetScene_KeepsPreviousSceneWhileLoading);
+    tsRun(Test_smSetScene_ShowsLoadingSceneWhileLoading);
+    tsRun(Test_smSetScene_ExitsAbandonedLoad);
+    tsRun(Test_smUpdate_StopsWhenLoaderStopsSceneManager);
+    tsRun(Test_smUpdate_StopsWhenLoadedSceneEnterStopsSceneManager);
+    tsRun(Test_smUpdate_KeepsSceneSetByLoader);
+    puts(" • smSetLoadBudget");
+    tsRun(Test_smSetLoadBudget_RejectsNegativeBudget);
     puts(" • smGetCurrentSceneName");
-    Test_smGetCurrentSceneName_FailsPreCreateScene();
-    Test_smGetCurrentSceneName_ReturnsCurrentSceneName();
+    tsRun(Test_smGetCurrentSceneName_FailsPreCreateScene);
+    tsRun(Test_smGetCurrentSceneName_ReturnsCurrentSceneName);
     puts(" • smDeleteScene");
-    Test_smDeleteScene_FailsPreCreateScene();
-    Test_smDeleteScene_FailsToDeleteCurrentScene();
-    Test_smDeleteScene_AcceptsNonCurrentScene();
-    Test_smDeleteScene_RejectsEmptyName();
-    Test_smDeleteScene_FailsWhenDeletingSameSceneTwice();
+    tsRun(Test_smDeleteScene_FailsPreCreateScene);
+    tsRun(Test_smDeleteScene_FailsToDeleteCurrentScene);
+    tsRun(Test_smDeleteScene_AcceptsNonCurrentScene);
+    tsRun(Test_smDeleteScene_RejectsEmptyName);
+    tsRun(Test_smDeleteScene_FailsWhenDeletingSameSceneTwice);
+    tsRun(Test_smDeleteScene_FailsToDeletePendingScene);
+    tsRun(Test_smDeleteScene_ExitsSuspendedScene);
     puts(" • smGetSceneCount");
-    Test_smGetSceneCount_ReturnsZeroPostStart();
-    Test_smGetSceneCount_ReturnsCorrectSceneCountPostCreateScene();
-    Test_smGetSceneCount_ReturnsCorrectSceneCountPostDeleteScene();
+    tsRun(Test_smGetSceneCount_ReturnsZeroPostStart);
+    tsRun(Test_smGetSceneCount_ReturnsCorrectSceneCountPostCreateScene);
+    tsRun(Test_smGetSceneCount_ReturnsCorrectSceneCountPostDeleteScene);
     puts("• Lifecycle Functions");
     puts(" • smUpdate");
-    Test_smUpdate_FailsWhenNullCurrentScene();
-    Test_smUpdate_CallsNonNullUpdateOfCurrentScene();
-    Test_smUpdate_FailsWhenNullUpdate();
+    tsRun(Test_smUpdate_FailsWhenNullCurrentScene);
+    tsRun(Test_smUpdate_CallsNonNullUpdateOfCurrentScene);
+    tsRun(Test_smUpdate_FailsWhenNullUpdate);
+    tsRun(Test_smUpdate_SpreadsLoaderAcrossFramesWithinBudget);
+    tsRun(Test_smUpdate_CallsLoaderOnceWhenBudgetIsZero);
+    tsRun(Test_smUpdate_PublishesMetricsWhenMetricsIsRunning);
+    tsRun(Test_smUpdate_DoesNotAllocateInSteadyState);
     puts(" • smGetDt");
-    Test_smGetDt_UsesDefaultDtOnFirstCall();
-    Test_smGetDt_UpdatesDtOnConsecutiveCalls();
-    Test_smGetDt_FailsWhenClockGettimeFails();
+    tsRun(Test_smGetDt_UsesDefaultDtOnFirstCall);
+    tsRun(Test_smGetDt_UpdatesDtOnConsecutiveCalls);
+    tsRun(Test_smGetDt_FailsWhenClockGettimeFails);
+    tsRun(Test_smGetDt_ClampsOutliersToMaxDt);
+    tsRun(Test_smGetDt_MedianFilterIgnoresIsolatedSpike);
+    tsRun(Test_smGetDt_EmaFilterDampsJitter);
+    tsRun(Test_smGetDt_SnapsToRefreshIntervalWithoutDrift);
+    puts(" • smSetDtFilter");
+    tsRun(Test_smSetDtFilter_RejectsInvalidFilters);
     puts(" • smDraw");
-    Test_smDraw_FailsWhenNullCurrentScene();
-    Test_smDraw_CallsValidDrawFunction();
-    Test_smDraw_FailsWhenNullDraw();
+    tsRun(Test_smDraw_FailsWhenNullCurrentScene);
+    tsRun(Test_smDraw_CallsValidDrawFunction);
+    tsRun(Test_smDraw_FailsWhenNullDraw);
+    tsRun(Test_smDraw_DoesNotAllocateInSteadyState);
+    puts("• Frame Pacing");
+    puts(" • smSetClockSource");
+    tsRun(Test_smSetClockSource_RejectsInvalidSource);
+    tsRun(Test_smSetClockSource_AcceptsMonotonicAndReportsUnsupportedSources);
+    tsRun(Test_smSetClockSource_EverySourceKeepsPaceWithMonotonic);
+    tsRun(Test_smInternalTscToNs_ScalesLargeTickCounts);
+    tsRun(Test_smSetClockSource_RestartsDtTiming);
+    puts(" • smSetTargetFps");
+    tsRun(Test_smSetTargetFps_RejectsNonPositiveFps);
+    puts(" • smWaitForNextFrame");
+    tsRun(Test_smWaitForNextFrame_SleepsUntilDeadline);
+    tsRun(Test_smWaitForNextFrame_RestartsScheduleAfterLateFrame);
+    tsRun(Test_smWaitForNextFrame_FailsWhenClockGettimeFails);
+    tsRun(Test_smWaitForNextFrame_RunsIdleTasksOnlyUntilDeadline);
+    tsRun(Test_smWaitForNextFrame_SkipsIdleTasksOnLateFrame);
+    puts(" • smSetFrameBudget");
+    tsRun(Test_smSetFrameBudget_RejectsNegativeBudget);
+    puts(" • smGetQualityLevel");
+    tsRun(Test_smGetQualityLevel_StartsAtFull);
+    tsRun(Test_smGetQualityLevel_LowersAfterSustainedOverBudgetFrames);
+    tsRun(Test_smGetQualityLevel_RaisesOnlyAfterSustainedHeadroom);
+    tsRun(Test_smGetQualityLevel_IgnoresIdleTaskTime);
+    puts(" • smPostIdleTask");
+    tsRun(Test_smPostIdleTask_RejectsNullTask);
+    tsRun(Test_smPostIdleTask_FailsWhenQueueIsFull);
+    tsRun(Test_smPostIdleTask_DropsTasksWhenOwnerSceneExits);
+    puts("• Messaging");
+    puts(" • smSetSceneMessageHandler");
+    tsRun(Test_smSetSceneMessageHandler_FailsForMissingScene);
+    puts(" • smSetMessageMode");
+    tsRun(Test_smSetMessageMode_RejectsInvalidMode);
+    puts(" • smPostMessage");
+    tsRun(Test_smPostMessage_RejectsInvalidPayload);
+    tsRun(Test_smPostMessage_DeliversInOrderBeforeUpdate);
+    tsRun(Test_smPostMessage_WaitsWhileNoSceneIsActive);
+    tsRun(Test_smPostMessage_DropsMessagesWithoutHandler);
+    tsRun(Test_smPostMessage_FailsWhenQueueIsFullInEitherMode);
+    tsRun(Test_smPostMessage_DropsQueuedMessagesOnStop);
+    puts("• Timers");
+    puts(" • smAddTimer");
+    tsRun(Test_smAddTimer_RejectsInvalidArgs);
+    tsRun(Test_smAddTimer_FiresOnceAfterDelay);
+    tsRun(Test_smAddTimer_RepeatsOncePerElapsedInterval);
+    tsRun(Test_smAddTimer_FiresLongDelaysAcrossWheelLevels);
+    tsRun(Test_smAddTimer_CancelsTimersWhenOwnerSceneExits);
+    tsRun(Test_smAddTimer_CallbackCanCancelItsOwnTimer);
+    puts(" • smCancelTimer");
+    tsRun(Test_smCancelTimer_PreventsFiringAndInvalidatesId);
+    puts("• Tweens");
+    puts(" • smAddTween");
+    tsRun(Test_smAddTween_RejectsInvalidArgs);
+    tsRun(Test_smAddTween_ReachesTargetExactlyThenStops);
+    tsRun(Test_smAddTween_EasingCurvesMatchReferenceValues);
+    tsRun(Test_smAddTween_CancelsTweensWhenOwnerSceneExits);
+    tsRun(Test_smAddTween_StepsLargeGroupsOnJobPool);
+    puts(" • smCancelTween");
+    tsRun(Test_smCancelTween_LeavesTargetAndInvalidatesId);
+    puts(" • smSetParallelTweens");
+    tsRun(Test_smSetParallelTweens_HoldsOneShareUntilStop);
+    puts("• Performance Counters");
+    puts(" • smSetPerfCounters");
+    tsRun(Test_smSetPerfCounters_CountsEachCallbackOfCurrentScene);
+    puts(" • smGetScenePerfCounters");
+    tsRun(Test_smGetScenePerfCounters_RejectsInvalidScenes);
 
     puts("\nSTOP TESTING");
-    Test_smStop_CallsNonNullExitOfCurrentScene();
-    Test_smStop_SkipsNullExitOfCurrentScene();
+    tsRun(Test_smStop_CallsNonNullExitOfCurrentScene);
+    tsRun(Test_smStop_ExitsSuspendedScenes);
+    tsRun(Test_smStop_ExitsPendingScene);
+    tsRun(Test_smStop_SkipsNullExitOfCurrentScene);
+    tsRun(Test_smStop_WritesSampledStacksTaggedWithScene);
 
     puts("\nPOST-STOP TESTING");
     puts("• Start Related");
-    Test_smHasStarted_FailsPostStop();
+    tsRun(Test_smHasStarted_FailsPostStop);
     puts("• Scene Functions");
-    Test_smCreateScene_FailsPostStop();
-    Test_smSceneExists_FailsPostStop();
-    Test_smSetScene_FailsPostStop();
-    Test_smGetCurrentSceneName_FailsPostStop();
-    Test_smDeleteScene_FailsPostStop();
-    Test_smGetSceneCount_FailsPostStop();
+    tsRun(Test_smCreateScene_FailsPostStop);
+    tsRun(Test_smSceneExists_FailsPostStop);
+    tsRun(Test_smSetScene_FailsPostStop);
+    tsRun(Test_smGetCurrentSceneName_FailsPostStop);
+    tsRun(Test_smDeleteScene_FailsPostStop);
+    tsRun(Test_smGetSceneCount_FailsPostStop);
     puts("• Lifecycle Functions");
-    Test_smUpdate_FailsPostStop();
-    Test_smDraw_FailsPostStop();
+    tsRun(Test_smUpdate_FailsPostStop);
+    tsRun(Test_smDraw_FailsPostStop);
+    puts("• Messaging");
+    tsRun(Test_smPostMessage_FailsPostStop);
+    puts("• Timers");
+    tsRun(Test_smAddTimer_FailsPostStop);
+    puts("• Tweens");
+    tsRun(Test_smAddTween_FailsPostStop);
+    puts("• Performance Counters");
+    tsRun(Test_smSetPerfCounters_FailsPostStop);
     puts("• Stop Related");
-    Test_smStop_IsIdempotentPostStop();
+    tsRun(Test_smStop_IsIdempotentPostStop);
 
     puts("\nSTRESS TESTING");
-    TestStress_smCreateScene_CreatingMultipleScenesCausesNoSkips();
-    TestStress_smSetScene_SettingScenesOftenCausesNoSkips();
-    TestStress_smStop_FreeingMultipleScenesCausesNoSkips();
+    tsRun(TestStress_smCreateScene_CreatingMultipleScenesCausesNoSkips);
+    tsRun(TestStress_smSetScene_SettingScenesOftenCausesNoSkips);
+    tsRun(TestStress_smAddTimer_ManyTimersFireOnTime);
+    tsRun(TestStress_smAddTween_ManyTweensFinishOnTarget);
+    tsRun(TestStress_smStop_FreeingMultipleScenesCausesNoSkips);
 
     puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
     return 0;
@@ -0,0 +1,92 @@
+/**
+ * @file
+ * @brief Benchmarks of the Common helpers on Smile's hot paths.
+ *
+ * Run with a path to also write the results as JSON.
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <stdint.h>
+#include <stdio.h>
+// Module Related
+#include "internal/Common/Common.h"
+// Support
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#define SHORT_NAME "Menu"
+#define LONG_NAME "World3/Dungeons/FloodedCrypt/BossArena/PhaseTwo/CutsceneIntro"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Benchmarks
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Bench_cmHashString(uint64_t iterations, void *args)
+{
+    const char *name = args;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        // Hiding the name each time keeps the hash from being hoisted out of the loop.
+        tsDoNotOptimize(name);
+        uint32_t hash = cmHashString(name, (uint32_t)i);
+        tsDoNotOptimize(&hash);
+    }
+}
+
+void Bench_cmGetTimeNs(uint64_t iterations, void *args)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        int64_t now = cmGetTimeNs();
+        tsDoNotOptimize(&now);
+    }
+}
+
+void Bench_tsMalloc_ThenFree(uint64_t iterations, void *args)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        void *ptr = tsMalloc(64);
+        tsDoNotOptimize(ptr);
+        tsFree(ptr);
+    }
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(int argc, char *argv[])
+{
+    puts("\nCOMMON BENCHMARKS");
+
+    puts("\n• Hash Related");
+    tsBench("cmHashString/short", Bench_cmHashString, SHORT_NAME, nullptr);
+    tsBench("cmHashString/long", Bench_cmHashString, LONG_NAME, nullptr);
+
+    puts("\n• Time Related");
+    tsBench("cmGetTimeNs", Bench_cmGetTimeNs, nullptr, nullptr);
+
+    puts("\n• Allocation Related");
+    tsBench("tsMalloc+tsFree/64B", Bench_tsMalloc_ThenFree, nullptr, nullptr);
+
+    if (argc > 1 && !tsBenchWriteJson(argv[1]))
+    {
+        fprintf(stderr, "Failed to write %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,455 @@
+/**
+ * @file
+ * @brief Performance gate that runs a benchmark several times and compares
+ *        it against a committed baseline.
+ *
+ * Each run is reduced to one median per benchmark, since samples within a
+ * run share the machine's state and aren't independent. The run medians are
+ * compared with the baseline's by an exact one-sided Mann-Whitney U test. A
+ * benchmark regresses only if its median is slower by more than the
+ * threshold and the shift is significant, so one noisy run can't fail the
+ * gate.
+ *
+ * Usage: BenchCompare --baseline <file> [--runs <n>] [--threshold <pct>]
+ *                     [--update] <benchmark executable>
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+#define BENCHMARKS_MAX 256
+#define RUNS_MAX 32
+#define SAMPLES_MAX 1024
+#define NAME_SIZE 96
+#define COMMAND_SIZE 2048
+#define DEFAULT_RUNS 5 // the fewest that can reach ALPHA, at 1 in 252
+#define DEFAULT_THRESHOLD 10.0 // percent the median may grow before it counts
+#define ALPHA 0.01 // chance of calling pure noise a regression
+
+#define NAME_KEY "{\"name\": \""
+#define SAMPLES_KEY "\"samples_ns\": ["
+#define RUN_MEDIANS_KEY "\"run_medians_ns\": ["
+
+static const char *USAGE =
+    "Usage: BenchCompare --baseline <file> [--runs <n>] [--threshold <pct>] [--update] <benchmark>\n";
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief The median of one benchmark in each run.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    char name[NAME_SIZE];
+    double medians[RUNS_MAX];
+    size_t count;
+} bcSeries;
+
+/**
+ * @brief Benchmarks read from one or more JSON reports.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    bcSeries series[BENCHMARKS_MAX];
+    size_t count;
+} bcReport;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static int bcCompareDoubles(const void *a, const void *b)
+{
+    const double A = *(const double *)a;
+    const double B = *(const double *)b;
+    return (A > B) - (A < B);
+}
+
+// Sorts `values` in place.
+static double bcMedian(double *values, size_t count)
+{
+    qsort(values, count, sizeof(double), bcCompareDoubles);
+    const size_t MID = count / 2;
+    return count % 2 ? values[MID] : (values[MID - 1] + values[MID]) / 2;
+}
+
+static double bcSeriesMedian(const bcSeries *series)
+{
+    double sorted[RUNS_MAX];
+    memcpy(sorted, series->medians, series->count * sizeof(double));
+    return bcMedian(sorted, series->count);
+}
+
+static const bcSeries *bcFindSeries(const bcReport *report, const char *name)
+{
+    for (size_t i = 0; i < report->count; i++)
+    {
+        if (strcmp(report->series[i].name, name) == 0)
+        {
+            return &report->series[i];
+        }
+    }
+    return nullptr;
+}
+
+// Parses numbers up to the closing bracket, returning how many were read or -1.
+static int bcReadArray(const char *cursor, double *values, size_t capacity)
+{
+    size_t count = 0;
+    while (*cursor && *cursor != ']')
+    {
+        char *end;
+        const double VALUE = strtod(cursor, &end);
+        if (end == cursor || count == capacity)
+        {
+            return -1;
+        }
+        values[count++] = VALUE;
+        cursor = end + strspn(end, ", ");
+    }
+    return (int)count;
+}
+
+static char *bcReadFile(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        return nullptr;
+    }
+
+    char *content = nullptr;
+    long size;
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) >= 0 &&
+        fseek(file, 0, SEEK_SET) == 0 && (content = malloc((size_t)size + 1)))
+    {
+        content[fread(content, 1, (size_t)size, file)] = '\0';
+    }
+    fclose(file);
+    return content;
+}
+
+/*
+ * Reads a report from tsBenchWriteJson(), adding one run median per
+ * benchmark, or a baseline from bcWriteBaseline(), adding all of its run
+ * medians. Only those layouts are understood: one flat object per benchmark.
+ */
+static bool bcReadReport(const char *path, bcReport *report)
+{
+    char *content = bcReadFile(path);
+    if (!content)
+    {
+        return false;
+    }
+
+    bool isValid = true;
+    for (char *cursor = strstr(content, NAME_KEY); cursor && isValid; cursor = strstr(cursor, NAME_KEY))
+    {
+        cursor += strlen(NAME_KEY);
+        const char *OBJECT_END = strchr(cursor, '}');
+
+        char name[NAME_SIZE];
+        size_t length = 0;
+        for (; *cursor && *cursor != '"'; cursor++)
+        {
+            if (*cursor == '\\' && cursor[1])
+            {
+                cursor++;
+            }
+            if (length < sizeof(name) - 1)
+            {
+                name[length++] = *cursor;
+            }
+        }
+        name[length] = '\0';
+
+        bcSeries *series = (bcSeries *)bcFindSeries(report, name);
+        if (!series && report->count < BENCHMARKS_MAX)
+        {
+            series = &report->series[report->count++];
+            *series = (bcSeries){0};
+            memcpy(series->name, name, length + 1);
+        }
+
+        const char *medians = strstr(cursor, RUN_MEDIANS_KEY);
+        const char *samples = strstr(cursor, SAMPLES_KEY);
+        if (!series || !OBJECT_END)
+        {
+            isValid = false;
+        }
+        else if (medians && medians < OBJECT_END)
+        {
+            const int COUNT = bcReadArray(medians + strlen(RUN_MEDIANS_KEY),
+                                          series->medians + series->count,
+                                          RUNS_MAX - series->count);
+            isValid = COUNT > 0;
+            series->count += COUNT > 0 ? (size_t)COUNT : 0;
+        }
+        else if (samples && samples < OBJECT_END && series->count < RUNS_MAX)
+        {
+            static double values[SAMPLES_MAX];
+            const int COUNT = bcReadArray(samples + strlen(SAMPLES_KEY), values, SAMPLES_MAX);
+            isValid = COUNT > 0;
+            if (isValid)
+            {
+                series->medians[series->count++] = bcMedian(values, (size_t)COUNT);
+            }
+        }
+        else
+        {
+            isValid = false;
+        }
+    }
+
+    free(content);
+    return isValid;
+}
+
+static bool bcWriteBaseline(const char *path, const bcReport *report)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    fputs("{\n  \"benchmarks\": [", file);
+    for (size_t i = 0; i < report->count; i++)
+    {
+        const bcSeries *SERIES = &report->series[i];
+        fprintf(file, "%s\n    {\"name\": \"", i ? "," : "");
+        for (const char *c = SERIES->name; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                fputc('\\', file);
+            }
+            fputc(*c, file);
+        }
+        fprintf(file, "\", \"median_ns\": %.3f, \"run_medians_ns\": [", bcSeriesMedian(SERIES));
+        for (size_t j = 0; j < SERIES->count; j++)
+        {
+            fprintf(file, j ? ", %.3f" : "%.3f", SERIES->medians[j]);
+        }
+        fputs("]}", file);
+    }
+    fputs("\n  ]\n}\n", file);
+
+    return fclose(file) == 0;
+}
+
+/*
+ * Exact one-sided Mann-Whitney U test: the chance that `slower`'s values
+ * rank at least this far above `faster`'s if both came from the same
+ * distribution. Ties count as half a win, and the tail starts at the whole
+ * number below U, which errs towards calling a change noise.
+ */
+static double bcMannWhitneyP(const bcSeries *slower, const bcSeries *faster)
+{
+    const size_t M = slower->count;
+    const size_t N = faster->count;
+
+    double u = 0;
+    for (size_t i = 0; i < M; i++)
+    {
+        for (size_t j = 0; j < N; j++)
+        {
+            u += slower->medians[i] > faster->medians[j]    ? 1.0
+                 : slower->medians[i] == faster->medians[j] ? 0.5
+                                                            : 0.0;
+        }
+    }
+
+    // Under the null hypothesis, the ways to reach each U are the coefficients
+    // of the Gaussian binomial, the product of (1 - q^(N+i)) / (1 - q^i).
+    const size_t MAX_U = M * N;
+    double ways[RUNS_MAX * RUNS_MAX + 1] = {1.0};
+    for (size_t i = 1; i <= M; i++)
+    {
+        for (size_t k = MAX_U; k >= N + i && k <= MAX_U; k--)
+        {
+            ways[k] -= ways[k - (N + i)];
+        }
+        for (size_t k = i; k <= MAX_U; k++)
+        {
+            ways[k] += ways[k - i];
+        }
+    }
+
+    double total = 0;
+    double tail = 0;
+    for (size_t k = 0; k <= MAX_U; k++)
+    {
+        total += ways[k];
+        tail += k >= (size_t)floor(u) ? ways[k] : 0;
+    }
+    return tail / total;
+}
+
+static bool bcRunBenchmark(const char *executable, int runs, bcReport *report)
+{
+    for (int run = 0; run < runs; run++)
+    {
+        char output[NAME_SIZE];
+        snprintf(output, sizeof(output), "BenchCompare.run%d.json", run);
+
+        char command[COMMAND_SIZE];
+        snprintf(command, sizeof(command), "\"%s\" %s > %s", executable, output, NULL_DEVICE);
+        printf("Running %s (%d/%d)\n", executable, run + 1, runs);
+        fflush(stdout);
+
+        const bool IS_RUN = system(command) == 0 && bcReadReport(output, report);
+        remove(output);
+        if (!IS_RUN)
+        {
+            fprintf(stderr, "Failed to run %s\n", executable);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Prints one row per benchmark and returns how many regressed.
+static int bcPrintDiff(const bcReport *baseline, const bcReport *current, double threshold)
+{
+    int regressions = 0;
+    printf("\n%-52s %12s %12s %9s %9s  %s\n", "Benchmark", "Baseline", "Current", "Change",
+           "p-value", "Verdict");
+
+    for (size_t i = 0; i < current->count; i++)
+    {
+        const bcSeries *CURRENT = &current->series[i];
+        const double CURRENT_MEDIAN = bcSeriesMedian(CURRENT);
+        const bcSeries *BASE = bcFindSeries(baseline, CURRENT->name);
+        if (!BASE)
+        {
+            printf("%-52s %12s %9.1f ns %9s %9s  new\n", CURRENT->name, "-", CURRENT_MEDIAN, "-",
+                   "-");
+            continue;
+        }
+
+        const double BASE_MEDIAN = bcSeriesMedian(BASE);
+        const double CHANGE = (CURRENT_MEDIAN / BASE_MEDIAN - 1) * 100;
+
+        const char *verdict = "ok";
+        double p = bcMannWhitneyP(CURRENT, BASE);
+        if (CHANGE > threshold && p < ALPHA)
+        {
+            verdict = "SLOWER";
+            regressions++;
+        }
+        else if (CHANGE < -threshold && bcMannWhitneyP(BASE, CURRENT) < ALPHA)
+        {
+            verdict = "faster";
+            p = bcMannWhitneyP(BASE, CURRENT);
+        }
+        printf("%-52s %9.1f ns %9.1f ns %+8.1f%% %9.4f  %s\n", CURRENT->name, BASE_MEDIAN,
+               CURRENT_MEDIAN, CHANGE, p, verdict);
+    }
+
+    for (size_t i = 0; i < baseline->count; i++)
+    {
+        if (!bcFindSeries(current, baseline->series[i].name))
+        {
+            printf("%-52s %12s %12s %9s %9s  missing\n", baseline->series[i].name, "-", "-", "-",
+                   "-");
+        }
+    }
+    return regressions;
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(int argc, char *argv[])
+{
+    const char *baselinePath = nullptr;
+    const char *executable = nullptr;
+    int runs = DEFAULT_RUNS;
+    double threshold = DEFAULT_THRESHOLD;
+    bool isUpdate = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+        {
+            baselinePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc)
+        {
+            runs = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+        {
+            threshold = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--update") == 0)
+        {
+            isUpdate = true;
+        }
+        else
+        {
+            executable = argv[i];
+        }
+    }
+    if (!baselinePath || !executable || runs < 1 || runs > RUNS_MAX || threshold < 0)
+    {
+        fputs(USAGE, stderr);
+        return EXIT_FAILURE;
+    }
+
+    static bcReport current;
+    if (!bcRunBenchmark(executable, runs, &current))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (isUpdate)
+    {
+        const bool IS_WRITTEN = bcWriteBaseline(baselinePath, &current);
+        printf("%s %s\n", IS_WRITTEN ? "Wrote" : "Failed to write", baselinePath);
+        return IS_WRITTEN ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    static bcReport baseline;
+    if (!bcReadReport(baselinePath, &baseline))
+    {
+        fprintf(stderr, "Failed to read %s. Create it with --update.\n", baselinePath);
+        return EXIT_FAILURE;
+    }
+
+    const int REGRESSIONS = bcPrintDiff(&baseline, &current, threshold);
+    printf("\n%d regression%s (median more than %.0f%% slower, p < %.2f)\n", REGRESSIONS,
+           REGRESSIONS == 1 ? "" : "s", threshold, ALPHA);
+    return REGRESSIONS ? EXIT_FAILURE : EXIT_SUCCESS;
+}
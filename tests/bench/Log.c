@@ -0,0 +1,304 @@
+/**
+ * @file
+ * @brief Benchmarks of Log's throughput and per-call latency.
+ *
+ * BenchLog writes to the null device, a file and a pipe, from one thread and
+ * from several producers. BenchLogNoLog links the copy of Smile built without
+ * info and warning logs and measures what a filtered-out call costs. Run with
+ * a path to also write the results as JSON.
+ *
+ * @author Vitor Betmann
+ */
+
+// fileno, pipe, dup2 and read are POSIX, not ISO C.
+#define _POSIX_C_SOURCE 200809L
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <stdint.h>
+#include <stdio.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+// Module Related
+#include "Log.h"
+#include "LogInternal.h"
+// Support
+#include "Metrics.h"
+#include "internal/Common/Common.h"
+#include "internal/Common/CommonThreads.h"
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+#define LOG_FILE "BenchLog.log"
+#define PRODUCERS 4
+#define LATENCY_CALLS 20000 // calls timed one by one, per producer
+#define BENCH_NAME_SIZE 96
+#define PIPE_CHUNK 65536
+
+#define ORI "Bench"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Log call a benchmark makes.
+ *
+ * @author Vitor Betmann
+ */
+typedef enum
+{
+    CALL_LOG,
+    CALL_INTERNAL,
+    CALL_INTERNAL_WITH_ARG,
+} benchCall;
+
+/**
+ * @brief Work handed to one producer thread.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    benchCall call;
+    lgInternalLevel level;
+    uint64_t calls;
+    mtMetricId latency; // 0 to skip timing each call
+} benchProducer;
+
+/**
+ * @brief What a benchmark logs and how many threads log it.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    benchCall call;
+    lgInternalLevel level;
+    int producers;
+} benchFixture;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static void mockLog(benchCall call, lgInternalLevel level, uint64_t i)
+{
+    switch (call)
+    {
+    case CALL_LOG:
+        lgLog("Frame %llu took %.2f ms", (unsigned long long)i, 16.67);
+        return;
+    case CALL_INTERNAL:
+        lgInternalLog(level, ORI, "Module Started", __func__, "Successful");
+        return;
+    case CALL_INTERNAL_WITH_ARG:
+        lgInternalLogWithArg(level, ORI, "Scene Set To", "Menu", __func__, "Successful");
+        return;
+    }
+}
+
+static void mockProduce(void *args)
+{
+    const benchProducer *PRODUCER = args;
+    for (uint64_t i = 0; i < PRODUCER->calls; i++)
+    {
+        if (!PRODUCER->latency)
+        {
+            mockLog(PRODUCER->call, PRODUCER->level, i);
+            continue;
+        }
+        const int64_t START = cmGetTimeNs();
+        mockLog(PRODUCER->call, PRODUCER->level, i);
+        mtRecordHistogram(PRODUCER->latency, (uint64_t)(cmGetTimeNs() - START));
+    }
+}
+
+// Splits `calls` across `producers` threads, or runs them here if there is only one.
+static void mockRunProducers(const benchFixture *fixture, uint64_t calls, mtMetricId latency)
+{
+    benchProducer producers[PRODUCERS];
+    cmThread threads[PRODUCERS];
+    const int COUNT = fixture->producers;
+
+    for (int i = 0; i < COUNT; i++)
+    {
+        producers[i] = (benchProducer){
+            .call = fixture->call,
+            .level = fixture->level,
+            .calls = calls / (uint64_t)COUNT + ((uint64_t)i < calls % (uint64_t)COUNT),
+            .latency = latency,
+        };
+    }
+    if (COUNT == 1)
+    {
+        mockProduce(&producers[0]);
+        return;
+    }
+
+    for (int i = 0; i < COUNT; i++)
+    {
+        cmCreateThread(&threads[i], mockProduce, &producers[i]);
+    }
+    for (int i = 0; i < COUNT; i++)
+    {
+        cmJoinThread(&threads[i]);
+    }
+}
+
+// Times each call on its own, which tsBench's batches can't show. Includes one clock read per call.
+static void mockMeasureLatency(const char *name, const benchFixture *fixture)
+{
+    mtMetricId latency;
+    if (mtCreateHistogram(name, &latency) != RES_OK)
+    {
+        return;
+    }
+    mockRunProducers(fixture, (uint64_t)LATENCY_CALLS * (uint64_t)fixture->producers, latency);
+
+    mtHistogramSummary summary;
+    mtGetHistogram(latency, &summary);
+    printf("\t[LATENCY] %-46s p50 %8llu ns  p90 %8llu ns  p99 %8llu ns  max %8llu ns\n", name,
+           (unsigned long long)summary.p50, (unsigned long long)summary.p90,
+           (unsigned long long)summary.p99, (unsigned long long)summary.max);
+}
+
+#if !defined(_WIN32) && !defined(BENCH_NO_LOG)
+// Drains the pipe stderr writes to, as a real reader would.
+static void mockDrainPipe(void *args)
+{
+    const int FD = *(const int *)args;
+    static char chunk[PIPE_CHUNK];
+    while (read(FD, chunk, sizeof(chunk)) > 0)
+    {
+    }
+}
+#endif
+
+// Redirects stderr, keeping it unbuffered as it is on a terminal.
+static bool mockRedirectStderr(const char *path)
+{
+    if (!freopen(path, "w", stderr))
+    {
+        return false;
+    }
+    setvbuf(stderr, nullptr, _IONBF, 0);
+    return true;
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Benchmarks
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// With several producers, ns/op is the inverse of their combined throughput.
+void Bench_Log(uint64_t iterations, void *args)
+{
+    mockRunProducers(args, iterations, 0);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Runners
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static void mockRun(const char *name, const char *sink, benchCall call, lgInternalLevel level,
+                    int producers)
+{
+    benchFixture fixture = {.call = call, .level = level, .producers = producers};
+    char fullName[BENCH_NAME_SIZE];
+    snprintf(fullName, sizeof(fullName), "%s/%s/%dthread%s", name, sink, producers,
+             producers == 1 ? "" : "s");
+
+    tsBench(fullName, Bench_Log, &fixture, nullptr);
+    mockMeasureLatency(fullName, &fixture);
+}
+
+#ifndef BENCH_NO_LOG
+// Every call through each sink, from one thread, then lgLog from several.
+static void mockRunSink(const char *sink)
+{
+    printf("\n• To %s\n", sink);
+    mockRun("lgLog", sink, CALL_LOG, USER, 1);
+    mockRun("lgInternalLog", sink, CALL_INTERNAL, INFO, 1);
+    mockRun("lgInternalLogWithArg", sink, CALL_INTERNAL_WITH_ARG, INFO, 1);
+    mockRun("lgLog", sink, CALL_LOG, USER, PRODUCERS);
+}
+#endif
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(int argc, char *argv[])
+{
+    if (!mockRedirectStderr(NULL_DEVICE) || mtStart() != RES_OK)
+    {
+        return 1;
+    }
+
+#ifdef BENCH_NO_LOG
+    puts("\nLOG BENCHMARKS (info and warning logs compiled out)");
+
+    puts("\n• Filtered Out");
+    mockRun("lgInternalLog/INFO", "filtered", CALL_INTERNAL, INFO, 1);
+    mockRun("lgInternalLogWithArg/INFO", "filtered", CALL_INTERNAL_WITH_ARG, INFO, 1);
+    mockRun("lgInternalLogWithArg/WARN", "filtered", CALL_INTERNAL_WITH_ARG, WARN, 1);
+#else
+    puts("\nLOG BENCHMARKS");
+
+    mockRunSink("null");
+
+    if (!mockRedirectStderr(LOG_FILE))
+    {
+        return 1;
+    }
+    mockRunSink("file");
+    remove(LOG_FILE);
+
+#ifndef _WIN32
+    int fds[2];
+    cmThread reader;
+    if (pipe(fds) != 0 || cmCreateThread(&reader, mockDrainPipe, &fds[0]) != RES_OK)
+    {
+        return 1;
+    }
+    fflush(stderr);
+    dup2(fds[1], fileno(stderr));
+    mockRunSink("pipe");
+
+    // The reader stops once every write end is closed.
+    close(fileno(stderr));
+    close(fds[1]);
+    cmJoinThread(&reader);
+    close(fds[0]);
+#endif
+#endif
+
+    mtStop();
+
+    if (argc > 1 && !tsBenchWriteJson(argv[1]))
+    {
+        printf("Failed to write %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file
+ * @brief Benchmarks of SceneManager's lookup, switch and dispatch paths as
+ *        the number of scenes grows.
+ *
+ * Built twice: BenchSceneManager with Smile's info and warning logs, and
+ * BenchSceneManagerNoLog with them compiled out. Run with a path to also
+ * write the results as JSON.
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+// Module Related
+#include "SceneManager.h"
+// Support
+#include "internal/Common/Common.h"
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef BENCH_NO_LOG
+#define LOG_LABEL "nolog"
+#else
+#define LOG_LABEL "log"
+#endif
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+#define NAME_CAPACITY 80
+#define CHURN_NAMES 1024 // names created and deleted again, on top of the fixture's scenes
+#define BENCH_NAME_SIZE 96
+
+#define SHORT_FMT "s%zu"
+#define LONG_FMT "World3/Dungeons/FloodedCrypt/BossArena/PhaseTwo/Cutscene_%zu"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief Scenes registered before a benchmark runs, and the names it uses.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    char *names;      // count + CHURN_NAMES names, NAME_CAPACITY bytes apart
+    size_t count;     // scenes registered
+    size_t next;      // next scene smSetScene switches to, kept across batches
+} benchFixture;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static void mockEnter(void *args) {}
+
+static void mockUpdate(float dt) {}
+
+static void mockDraw(void) {}
+
+static void mockExit(void) {}
+
+static const char *mockGetName(const benchFixture *fixture, size_t i)
+{
+    return fixture->names + i * NAME_CAPACITY;
+}
+
+static bool setUp(benchFixture *fixture, size_t count, bool isLong)
+{
+    *fixture = (benchFixture){.count = count, .next = 1};
+    fixture->names = malloc((count + CHURN_NAMES) * NAME_CAPACITY);
+    if (!fixture->names || smStart() != RES_OK)
+    {
+        free(fixture->names);
+        return false;
+    }
+
+    for (size_t i = 0; i < count + CHURN_NAMES; i++)
+    {
+        snprintf(fixture->names + i * NAME_CAPACITY, NAME_CAPACITY, isLong ? LONG_FMT : SHORT_FMT, i);
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        smCreateScene(mockGetName(fixture, i), mockEnter, mockUpdate, mockDraw, mockExit);
+    }
+    return smSetScene(mockGetName(fixture, 0), nullptr) == RES_OK;
+}
+
+static void tearDown(benchFixture *fixture)
+{
+    smStop();
+    free(fixture->names);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Benchmarks
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Deletes each scene right after creating it, so the table keeps its size however long it runs.
+void Bench_smCreateScene(uint64_t iterations, void *args)
+{
+    const benchFixture *FIXTURE = args;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        const char *name = mockGetName(FIXTURE, FIXTURE->count + i % CHURN_NAMES);
+        smCreateScene(name, mockEnter, mockUpdate, mockDraw, mockExit);
+        smDeleteScene(name);
+    }
+}
+
+void Bench_smSceneExists_Hit(uint64_t iterations, void *args)
+{
+    const benchFixture *FIXTURE = args;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        bool exists = smSceneExists(mockGetName(FIXTURE, i % FIXTURE->count));
+        tsDoNotOptimize(&exists);
+    }
+}
+
+void Bench_smSceneExists_Miss(uint64_t iterations, void *args)
+{
+    const benchFixture *FIXTURE = args;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        bool exists = smSceneExists(mockGetName(FIXTURE, FIXTURE->count + i % CHURN_NAMES));
+        tsDoNotOptimize(&exists);
+    }
+}
+
+// Visits every scene in turn, so large tables pay for their cache misses.
+void Bench_smSetScene(uint64_t iterations, void *args)
+{
+    benchFixture *fixture = args;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        smSetScene(mockGetName(fixture, fixture->next), nullptr);
+        fixture->next = (fixture->next + 1) % fixture->count;
+    }
+}
+
+void Bench_smUpdate(uint64_t iterations, void *args)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        smUpdate(1.0f / 60.0f);
+    }
+}
+
+void Bench_smDraw(uint64_t iterations, void *args)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        smDraw();
+    }
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(int argc, char *argv[])
+{
+    // Logs still format and write every line, just not to the terminal.
+    if (!freopen(NULL_DEVICE, "w", stderr))
+    {
+        return 1;
+    }
+
+    const struct
+    {
+        const char *name;
+        tsBenchFn fn;
+    } BENCHES[] = {
+        {"smCreateScene+smDeleteScene", Bench_smCreateScene},
+        {"smSceneExists/hit", Bench_smSceneExists_Hit},
+        {"smSceneExists/miss", Bench_smSceneExists_Miss},
+        {"smSetScene", Bench_smSetScene},
+        {"smUpdate", Bench_smUpdate},
+        {"smDraw", Bench_smDraw},
+    };
+    const size_t COUNTS[] = {10, 1000, 100000};
+
+    puts("\nSCENE MANAGER BENCHMARKS (" LOG_LABEL ")");
+
+    for (size_t c = 0; c < sizeof(COUNTS) / sizeof(COUNTS[0]); c++)
+    {
+        for (int isLong = 0; isLong <= 1; isLong++)
+        {
+            printf("\n• %zu Scenes, %s Names\n", COUNTS[c], isLong ? "Long" : "Short");
+
+            benchFixture fixture;
+            if (!setUp(&fixture, COUNTS[c], isLong))
+            {
+                puts("\tFailed to set up scenes");
+                return 1;
+            }
+            for (size_t b = 0; b < sizeof(BENCHES) / sizeof(BENCHES[0]); b++)
+            {
+                char name[BENCH_NAME_SIZE];
+                snprintf(name, sizeof(name), "%s/%zu/%s/%s", BENCHES[b].name, COUNTS[c],
+                         isLong ? "long" : "short", LOG_LABEL);
+                tsBench(name, BENCHES[b].fn, &fixture, nullptr);
+            }
+            tearDown(&fixture);
+        }
+    }
+
+    if (argc > 1 && !tsBenchWriteJson(argv[1]))
+    {
+        printf("Failed to write %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file
+ * @brief Implementation of the tsBench harness tests.
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+// Module Related
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef NDEBUG
+#error "TestInternalBench must be compiled without NDEBUG (asserts required)."
+#endif
+
+#define JSON_PATH "TestInternalBench.json"
+#define JSON_SIZE 16384
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static void mockSpin(uint64_t iterations, void *args)
+{
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        sum += i;
+        tsDoNotOptimize(&sum);
+    }
+}
+
+static void mockAllocate(uint64_t iterations, void *args)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        void *ptr = tsMalloc(16);
+        tsDoNotOptimize(ptr);
+        tsFree(ptr);
+    }
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_tsBench_FailsWithNullArgs(void)
+{
+    assert(!tsBench(nullptr, mockSpin, nullptr, nullptr));
+    assert(!tsBench("spin", nullptr, nullptr, nullptr));
+    tsPass(__func__);
+}
+
+void Test_tsBench_OrdersMinMedianP99(void)
+{
+    tsBenchResult result;
+    assert(tsBench("spin", mockSpin, nullptr, &result));
+
+    assert(strcmp(result.name, "spin") == 0);
+    assert(result.iterations > 1);
+    assert(result.sampleCount >= 100 && result.sampleCount <= 200);
+    assert(result.minNs > 0);
+    assert(result.minNs <= result.medianNs && result.medianNs <= result.p99Ns);
+    assert(result.allocsPerOp == 0);
+    tsPass(__func__);
+}
+
+void Test_tsPercentile_PicksNearestRank(void)
+{
+    double samples[200];
+    for (int i = 0; i < 200; i++)
+    {
+        samples[i] = (double)(i + 1);
+    }
+
+    assert(tsPercentile(samples, 200, 99) == 198.0);
+    assert(tsPercentile(samples, 100, 99) == 99.0);
+    assert(tsPercentile(samples, 200, 50) == 100.0);
+    assert(tsPercentile(samples, 200, 100) == 200.0);
+    assert(tsPercentile(samples, 200, 0) == 1.0);
+    assert(tsPercentile(samples, 1, 99) == 1.0);
+
+    // Too few samples leave the p99 no choice but the slowest.
+    assert(tsPercentile(samples, 51, 99) == 51.0);
+
+    assert(tsPercentile(nullptr, 200, 99) == 0.0);
+    assert(tsPercentile(samples, 0, 99) == 0.0);
+    assert(tsPercentile(samples, 200, 101) == 0.0);
+    tsPass(__func__);
+}
+
+void Test_tsBench_CountsAllocsPerOp(void)
+{
+    tsBenchResult result;
+    assert(tsBench("allocate", mockAllocate, nullptr, &result));
+    assert(result.allocsPerOp == 1.0);
+    tsPass(__func__);
+}
+
+void Test_tsBenchWriteJson_ListsEveryResult(void)
+{
+    assert(tsBench("json/spin", mockSpin, nullptr, nullptr));
+    assert(tsBench("json/allocate", mockAllocate, nullptr, nullptr));
+    assert(tsBenchWriteJson(JSON_PATH));
+
+    FILE *file = fopen(JSON_PATH, "r");
+    assert(file);
+    static char json[JSON_SIZE];
+    const size_t SIZE = fread(json, 1, sizeof(json) - 1, file);
+    json[SIZE] = '\0';
+    fclose(file);
+    remove(JSON_PATH);
+
+    assert(strstr(json, "\"name\": \"json/spin\""));
+    assert(strstr(json, "\"name\": \"json/allocate\""));
+    assert(strstr(json, "\"median_ns\": "));
+    assert(strstr(json, "\"samples_ns\": ["));
+    tsPass(__func__);
+}
+
+void Test_tsBenchWriteJson_FailsWithNullPath(void)
+{
+    assert(!tsBenchWriteJson(nullptr));
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(void)
+{
+    puts("\nBENCH HARNESS TESTING");
+
+    puts("\n• Timing Related");
+    tsRun(Test_tsBench_FailsWithNullArgs);
+    tsRun(Test_tsBench_OrdersMinMedianP99);
+    tsRun(Test_tsPercentile_PicksNearestRank);
+    tsRun(Test_tsBench_CountsAllocsPerOp);
+
+    puts("\n• Report Related");
+    tsRun(Test_tsBenchWriteJson_ListsEveryResult);
+    tsRun(Test_tsBenchWriteJson_FailsWithNullPath);
+
+    puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
+    return 0;
+}
@@ -0,0 +1,278 @@
+/**
+ * @file
+ * @brief Implementation of the Common job system tests.
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdio.h>
+// Module Related
+#include "internal/Common/Common.h"
+#include "internal/Common/CommonJobs.h"
+// Support
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef NDEBUG
+#error "TestInternalCommonJobs must be compiled without NDEBUG (asserts required)."
+#endif
+
+#define WORKER_COUNT 4
+#define JOB_COUNT 5000 // above CM_JOBS_DEQUE_CAPACITY, so some jobs overflow inline
+#define CHILD_COUNT 64
+#define RANGE_COUNT 100003
+#define RANGE_BATCH 256
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Variables
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static atomic_int runCount;
+static atomic_int visits[RANGE_COUNT];
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static void setup(void)
+{
+    atomic_store(&runCount, 0);
+    assert(cmStartJobs(WORKER_COUNT) == RES_OK);
+}
+
+static void teardown(void)
+{
+    assert(cmStopJobs() == RES_OK);
+    assert(!cmJobsIsRunning());
+}
+
+static void mockCountJob(void *args)
+{
+    atomic_fetch_add(&runCount, 1);
+}
+
+// Spawns children on whichever worker runs it, then waits for them.
+static void mockParentJob(void *args)
+{
+    cmJobCounter children = {0};
+    for (int i = 0; i < CHILD_COUNT; i++)
+    {
+        assert(cmSubmitJob(mockCountJob, nullptr, &children) == RES_OK);
+    }
+    assert(cmWaitJobs(&children) == RES_OK);
+    assert(atomic_load(&children.pending) == 0);
+    atomic_fetch_add(&runCount, 1);
+}
+
+static void mockVisitRange(void *args, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        atomic_fetch_add_explicit(&visits[i], 1, memory_order_relaxed);
+    }
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// Start Related
+
+void Test_cmStartJobs_FailsWithInvalidWorkerCount(void)
+{
+    assert(cmStartJobs(-1) == RES_INVALID_ARG);
+    assert(cmStartJobs(CM_JOBS_MAX_WORKERS + 1) == RES_INVALID_ARG);
+    assert(!cmJobsIsRunning());
+    tsPass(__func__);
+}
+
+void Test_cmStartJobs_FailsWhenCallocFails(void)
+{
+    tsDisable(CALLOC, 1);
+    assert(cmStartJobs(WORKER_COUNT) == RES_MEM_ALLOC_FAIL);
+    tsDisable(CALLOC, 2);
+    assert(cmStartJobs(WORKER_COUNT) == RES_MEM_ALLOC_FAIL);
+    assert(!cmJobsIsRunning());
+    tsPass(__func__);
+}
+
+void Test_cmStartJobs_SharesPoolBetweenUsers(void)
+{
+    assert(cmStartJobs(WORKER_COUNT) == RES_OK);
+    assert(cmStartJobs(1) == RES_OK);
+    assert(cmGetJobWorkerCount() == WORKER_COUNT);
+
+    assert(cmStopJobs() == RES_OK);
+    assert(cmJobsIsRunning());
+    assert(cmStopJobs() == RES_OK);
+    assert(!cmJobsIsRunning());
+    assert(cmGetJobWorkerCount() == 0);
+    tsPass(__func__);
+}
+
+void Test_cmStartJobs_SucceedsWithDefaultWorkerCount(void)
+{
+    assert(cmStartJobs(0) == RES_OK);
+    assert(cmGetJobWorkerCount() >= 0);
+    assert(cmStopJobs() == RES_OK);
+    tsPass(__func__);
+}
+
+// Job Related
+
+void Test_cmSubmitJob_FailsWithNullFn(void)
+{
+    setup();
+    assert(cmSubmitJob(nullptr, nullptr, nullptr) == RES_NULL_ARG);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_cmSubmitJob_RunsInlineWhenNotRunning(void)
+{
+    atomic_store(&runCount, 0);
+    cmJobCounter counter = {0};
+    assert(cmSubmitJob(mockCountJob, nullptr, &counter) == RES_OK);
+    assert(atomic_load(&runCount) == 1);
+    assert(atomic_load(&counter.pending) == 0);
+    tsPass(__func__);
+}
+
+void Test_cmWaitJobs_FailsWithNullCounter(void)
+{
+    assert(cmWaitJobs(nullptr) == RES_NULL_ARG);
+    tsPass(__func__);
+}
+
+void Test_cmWaitJobs_RunsEveryJob(void)
+{
+    setup();
+    cmJobCounter counter = {0};
+    for (int i = 0; i < JOB_COUNT; i++)
+    {
+        assert(cmSubmitJob(mockCountJob, nullptr, &counter) == RES_OK);
+    }
+    assert(cmWaitJobs(&counter) == RES_OK);
+    assert(atomic_load(&runCount) == JOB_COUNT);
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_cmWaitJobs_WaitsForNestedJobs(void)
+{
+    setup();
+    cmJobCounter counter = {0};
+    for (int i = 0; i < CHILD_COUNT; i++)
+    {
+        assert(cmSubmitJob(mockParentJob, nullptr, &counter) == RES_OK);
+    }
+    assert(cmWaitJobs(&counter) == RES_OK);
+    assert(atomic_load(&runCount) == CHILD_COUNT * (CHILD_COUNT + 1));
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_cmStopJobs_RunsQueuedJobs(void)
+{
+    setup();
+    for (int i = 0; i < JOB_COUNT; i++)
+    {
+        assert(cmSubmitJob(mockCountJob, nullptr, nullptr) == RES_OK);
+    }
+    teardown();
+    assert(atomic_load(&runCount) == JOB_COUNT);
+    tsPass(__func__);
+}
+
+void Test_cmStopJobs_FailsWhenNotRunning(void)
+{
+    assert(cmStopJobs() == RES_NOT_RUNNING);
+    tsPass(__func__);
+}
+
+// Parallel For
+
+void Test_cmParallelFor_FailsWithInvalidArgs(void)
+{
+    assert(cmParallelFor(RANGE_COUNT, RANGE_BATCH, nullptr, nullptr) == RES_NULL_ARG);
+    assert(cmParallelFor(RANGE_COUNT, 0, mockVisitRange, nullptr) == RES_INVALID_ARG);
+    tsPass(__func__);
+}
+
+void Test_cmParallelFor_VisitsEveryIndexOnce(void)
+{
+    setup();
+    for (size_t i = 0; i < RANGE_COUNT; i++)
+    {
+        atomic_store(&visits[i], 0);
+    }
+    assert(cmParallelFor(RANGE_COUNT, RANGE_BATCH, mockVisitRange, nullptr) == RES_OK);
+    for (size_t i = 0; i < RANGE_COUNT; i++)
+    {
+        assert(atomic_load(&visits[i]) == 1);
+    }
+    teardown();
+    tsPass(__func__);
+}
+
+void Test_cmParallelFor_RunsInlineWhenNotRunning(void)
+{
+    for (size_t i = 0; i < RANGE_COUNT; i++)
+    {
+        atomic_store(&visits[i], 0);
+    }
+    assert(cmParallelFor(RANGE_COUNT, RANGE_BATCH, mockVisitRange, nullptr) == RES_OK);
+    for (size_t i = 0; i < RANGE_COUNT; i++)
+    {
+        assert(atomic_load(&visits[i]) == 1);
+    }
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(void)
+{
+    puts("\nCOMMON JOBS TESTING");
+
+    puts("\n• Start Related");
+    tsRun(Test_cmStartJobs_FailsWithInvalidWorkerCount);
+    tsRun(Test_cmStartJobs_FailsWhenCallocFails);
+    tsRun(Test_cmStartJobs_SharesPoolBetweenUsers);
+    tsRun(Test_cmStartJobs_SucceedsWithDefaultWorkerCount);
+
+    puts("\n• Job Related");
+    tsRun(Test_cmSubmitJob_FailsWithNullFn);
+    tsRun(Test_cmSubmitJob_RunsInlineWhenNotRunning);
+    tsRun(Test_cmWaitJobs_FailsWithNullCounter);
+    tsRun(Test_cmWaitJobs_RunsEveryJob);
+    tsRun(Test_cmWaitJobs_WaitsForNestedJobs);
+    tsRun(Test_cmStopJobs_RunsQueuedJobs);
+    tsRun(Test_cmStopJobs_FailsWhenNotRunning);
+
+    puts("\n• Parallel For");
+    tsRun(Test_cmParallelFor_FailsWithInvalidArgs);
+    tsRun(Test_cmParallelFor_VisitsEveryIndexOnce);
+    tsRun(Test_cmParallelFor_RunsInlineWhenNotRunning);
+
+    puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file
+ * @brief Implementation of the Common performance counter layer tests.
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <assert.h>
+#include <stdio.h>
+// Module Related
+#include "internal/Common/Common.h"
+#include "internal/Common/CommonPerf.h"
+// Support
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef NDEBUG
+#error "TestInternalCommonPerf must be compiled without NDEBUG (asserts required)."
+#endif
+
+#define WORK_ITERATIONS 100000
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Variables
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static volatile uint64_t sink;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_cmOpenPerfGroup_FailsWithNullGroup(void)
+{
+    assert(cmOpenPerfGroup(nullptr) == RES_NULL_ARG);
+    assert(!cmIsPerfCounterOpen(nullptr, CM_PERF_CYCLES));
+    tsPass(__func__);
+}
+
+void Test_cmOpenPerfGroup_CountsOrFailsSoft(void)
+{
+    cmPerfGroup group;
+    const int RESULT = cmOpenPerfGroup(&group);
+    uint64_t before[CM_PERF_COUNTER_COUNT];
+    uint64_t after[CM_PERF_COUNTER_COUNT];
+
+    // Counters depend on the host, so an unavailable group is a valid outcome.
+    if (RESULT == RES_PERF_UNAVAILABLE)
+    {
+        for (int i = 0; i < CM_PERF_COUNTER_COUNT; i++)
+        {
+            assert(!cmIsPerfCounterOpen(&group, i));
+        }
+        assert(!cmReadPerfGroup(&group, before));
+        cmClosePerfGroup(&group);
+        tsPass(__func__);
+        return;
+    }
+
+    assert(RESULT == RES_OK);
+    assert(cmReadPerfGroup(&group, before));
+    for (int i = 0; i < WORK_ITERATIONS; i++)
+    {
+        sink += (uint64_t)i;
+    }
+    assert(cmReadPerfGroup(&group, after));
+
+    for (int i = 0; i < CM_PERF_COUNTER_COUNT; i++)
+    {
+        assert(after[i] >= before[i]);
+        if (!cmIsPerfCounterOpen(&group, i))
+        {
+            assert(after[i] == 0);
+        }
+    }
+    if (cmIsPerfCounterOpen(&group, CM_PERF_INSTRUCTIONS))
+    {
+        assert(after[CM_PERF_INSTRUCTIONS] - before[CM_PERF_INSTRUCTIONS] >= WORK_ITERATIONS);
+    }
+
+    cmClosePerfGroup(&group);
+    assert(!cmReadPerfGroup(&group, after));
+    cmClosePerfGroup(&group);
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(void)
+{
+    puts("\nCOMMON PERF TESTING");
+
+    puts("\n• Group Related");
+    tsRun(Test_cmOpenPerfGroup_FailsWithNullGroup);
+    tsRun(Test_cmOpenPerfGroup_CountsOrFailsSoft);
+
+    puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
+    return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file
+ * @brief Implementation of the Common threading layer tests.
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <assert.h>
+#include <stdio.h>
+// Module Related
+#include "internal/Common/Common.h"
+#include "internal/Common/CommonThreads.h"
+// Support
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef NDEBUG
+#error "TestInternalCommonThreads must be compiled without NDEBUG (asserts required)."
+#endif
+
+#define THREAD_COUNT 4
+#define INCREMENTS 100000
+#define ROUND_TRIPS 1000
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Variables
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static cmMutex mutex;
+static cmCond cond;
+static int lockedCount;
+static bool isReady;
+static atomic_int turn;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static void mockIncrement(void *args)
+{
+    for (int i = 0; i < INCREMENTS; i++)
+    {
+        cmLockMutex(&mutex);
+        lockedCount++;
+        cmUnlockMutex(&mutex);
+    }
+}
+
+static void mockWaitReady(void *args)
+{
+    cmLockMutex(&mutex);
+    while (!isReady)
+    {
+        cmWaitCond(&cond, &mutex);
+    }
+    lockedCount++;
+    cmUnlockMutex(&mutex);
+}
+
+// Answers every odd turn the main thread hands over with the next even one.
+static void mockPong(void *args)
+{
+    for (int i = 0; i < ROUND_TRIPS; i++)
+    {
+        const int EXPECTED = 2 * i + 1;
+        int current;
+        while ((current = atomic_load(&turn)) != EXPECTED)
+        {
+            cmWaitOnAddress(&turn, current);
+        }
+        atomic_store(&turn, EXPECTED + 1);
+        cmWakeAddress(&turn, false);
+    }
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_cmGetProcessorCount_ReturnsAtLeastOne(void)
+{
+    assert(cmGetProcessorCount() >= 1);
+    cmCpuRelax();
+    cmYieldThread();
+    tsPass(__func__);
+}
+
+void Test_cmCreateThread_FailsWithNullArgs(void)
+{
+    cmThread thread;
+    assert(cmCreateThread(nullptr, mockIncrement, nullptr) == RES_NULL_ARG);
+    assert(cmCreateThread(&thread, nullptr, nullptr) == RES_NULL_ARG);
+    tsPass(__func__);
+}
+
+void Test_cmLockMutex_SerializesThreads(void)
+{
+    cmInitMutex(&mutex);
+    lockedCount = 0;
+
+    cmThread threads[THREAD_COUNT];
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        assert(cmCreateThread(&threads[i], mockIncrement, nullptr) == RES_OK);
+    }
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        cmJoinThread(&threads[i]);
+    }
+
+    assert(lockedCount == THREAD_COUNT * INCREMENTS);
+    cmDestroyMutex(&mutex);
+    tsPass(__func__);
+}
+
+void Test_cmBroadcastCond_WakesEveryWaiter(void)
+{
+    cmInitMutex(&mutex);
+    cmInitCond(&cond);
+    lockedCount = 0;
+    isReady = false;
+
+    cmThread threads[THREAD_COUNT];
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        assert(cmCreateThread(&threads[i], mockWaitReady, nullptr) == RES_OK);
+    }
+    cmLockMutex(&mutex);
+    isReady = true;
+    cmBroadcastCond(&cond);
+    cmUnlockMutex(&mutex);
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        cmJoinThread(&threads[i]);
+    }
+
+    assert(lockedCount == THREAD_COUNT);
+    cmDestroyCond(&cond);
+    cmDestroyMutex(&mutex);
+    tsPass(__func__);
+}
+
+void Test_cmWaitOnAddress_PingPongsWithoutLostWakes(void)
+{
+    atomic_store(&turn, 0);
+    cmThread thread;
+    assert(cmCreateThread(&thread, mockPong, nullptr) == RES_OK);
+
+    for (int i = 0; i < ROUND_TRIPS; i++)
+    {
+        const int EXPECTED = 2 * i;
+        int current;
+        while ((current = atomic_load(&turn)) != EXPECTED)
+        {
+            cmWaitOnAddress(&turn, current);
+        }
+        atomic_store(&turn, EXPECTED + 1);
+        cmWakeAddress(&turn, false);
+    }
+
+    cmJoinThread(&thread);
+    assert(atomic_load(&turn) == 2 * ROUND_TRIPS);
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(void)
+{
+    puts("\nCOMMON THREADS TESTING");
+
+    puts("\n• Processor Related");
+    tsRun(Test_cmGetProcessorCount_ReturnsAtLeastOne);
+
+    puts("\n• Thread Related");
+    tsRun(Test_cmCreateThread_FailsWithNullArgs);
+    tsRun(Test_cmLockMutex_SerializesThreads);
+    tsRun(Test_cmBroadcastCond_WakesEveryWaiter);
+
+    puts("\n• Address Waits");
+    tsRun(Test_cmWaitOnAddress_PingPongsWithoutLostWakes);
+
+    puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
+    return 0;
+}
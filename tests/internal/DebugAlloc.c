@@ -0,0 +1,186 @@
+/**
+ * @file
+ * @brief Implementation of the SMILE_DEBUG_ALLOC allocator tests.
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <assert.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+// Module Related
+#include "internal/Test/Test.h"
+// Support
+#include "Metrics.h"
+#include "internal/Common/Common.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef NDEBUG
+#error "TestInternalDebugAlloc must be compiled without NDEBUG (asserts required)."
+#endif
+
+#ifndef SMILE_DEBUG_ALLOC
+#error "TestInternalDebugAlloc must be compiled with SMILE_DEBUG_ALLOC."
+#endif
+
+// Allocations made here are counted under this file's directory.
+#define MODULE "internal"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static tsAllocStats mockGetStats(const char *module)
+{
+    tsAllocStats stats = {0};
+    tsGetAllocStats(module, &stats);
+    return stats;
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_tsMalloc_CountsLiveAndPeakBytes(void)
+{
+    const tsAllocStats BEFORE = mockGetStats(MODULE);
+
+    char *first = tsMalloc(100);
+    char *second = tsCalloc(10, 30);
+    assert(first && second);
+    assert(second[0] == 0 && second[299] == 0);
+
+    tsAllocStats stats = mockGetStats(MODULE);
+    assert(stats.liveBytes == BEFORE.liveBytes + 400);
+    assert(stats.liveBlocks == BEFORE.liveBlocks + 2);
+    assert(stats.totalBlocks == BEFORE.totalBlocks + 2);
+
+    tsFree(first);
+    tsFree(second);
+    stats = mockGetStats(MODULE);
+    assert(stats.liveBytes == BEFORE.liveBytes);
+    assert(stats.peakBytes >= BEFORE.liveBytes + 400);
+    tsPass(__func__);
+}
+
+void Test_tsReportAllocations_ReturnsBlocksStillHeld(void)
+{
+    const size_t BEFORE = tsReportAllocations(MODULE);
+
+    void *leaked = tsMalloc(64);
+    assert(tsReportAllocations(MODULE) == BEFORE + 1);
+
+    tsFree(leaked);
+    assert(tsReportAllocations(MODULE) == BEFORE);
+    tsPass(__func__);
+}
+
+void Test_tsRealloc_KeepsContentsAndSize(void)
+{
+    const tsAllocStats BEFORE = mockGetStats(MODULE);
+
+    char *text = tsMalloc(6);
+    memcpy(text, "smile", 6);
+    text = tsRealloc(text, 64);
+    assert(text && strcmp(text, "smile") == 0);
+
+    const tsAllocStats STATS = mockGetStats(MODULE);
+    assert(STATS.liveBytes == BEFORE.liveBytes + 64);
+    assert(STATS.liveBlocks == BEFORE.liveBlocks + 1);
+
+    tsFree(text);
+    tsPass(__func__);
+}
+
+void Test_tsFree_CatchesDoubleFree(void)
+{
+    void *ptr = tsMalloc(32);
+    tsFree(ptr);
+    const tsAllocStats BEFORE = mockGetStats(MODULE);
+
+    tsFree(ptr);
+
+    const tsAllocStats STATS = mockGetStats(MODULE);
+    assert(STATS.badFrees == BEFORE.badFrees + 1);
+    assert(STATS.liveBytes == BEFORE.liveBytes);
+    assert(STATS.liveBlocks == BEFORE.liveBlocks);
+    tsPass(__func__);
+}
+
+void Test_tsFree_CatchesOverrun(void)
+{
+    const tsAllocStats BEFORE = mockGetStats(MODULE);
+
+    unsigned char *bytes = tsMalloc(16);
+    bytes[16] = 0xFF;
+    tsFree(bytes);
+
+    const tsAllocStats STATS = mockGetStats(MODULE);
+    assert(STATS.badFrees == BEFORE.badFrees + 1);
+    assert(STATS.liveBlocks == BEFORE.liveBlocks);
+    tsPass(__func__);
+}
+
+void Test_tsMalloc_KeepsMaxAlignment(void)
+{
+    void *ptr = tsMalloc(1);
+    assert((uintptr_t)ptr % alignof(max_align_t) == 0);
+    tsFree(ptr);
+    tsPass(__func__);
+}
+
+void Test_mtStop_LeavesNoMetricsBlocks(void)
+{
+    assert(mtStart() == RES_OK);
+    mtMetricId id;
+    assert(mtCreateHistogram("frame_ns", &id) == RES_OK);
+    mtRecordHistogram(id, 1000);
+    assert(mtStop() == RES_OK);
+
+    const tsAllocStats STATS = mockGetStats("Metrics");
+    assert(STATS.totalBlocks > 0);
+    assert(STATS.liveBlocks == 0 && STATS.liveBytes == 0);
+    assert(STATS.badFrees == 0);
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(void)
+{
+    puts("\nDEBUG ALLOCATOR TESTING");
+
+    puts("\n• Usage Related");
+    tsRun(Test_tsMalloc_CountsLiveAndPeakBytes);
+    tsRun(Test_tsReportAllocations_ReturnsBlocksStillHeld);
+    tsRun(Test_tsRealloc_KeepsContentsAndSize);
+    tsRun(Test_tsMalloc_KeepsMaxAlignment);
+
+    puts("\n• Bad Free Related");
+    tsRun(Test_tsFree_CatchesDoubleFree);
+    tsRun(Test_tsFree_CatchesOverrun);
+
+    puts("\n• Module Related");
+    tsRun(Test_mtStop_LeavesNoMetricsBlocks);
+
+    puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
+    return 0;
+}
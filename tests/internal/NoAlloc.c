@@ -0,0 +1,132 @@
+/**
+ * @file
+ * @brief Implementation of the no-allocation region tests.
+ *
+ * @author Vitor Betmann
+ */
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+// External
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+// Module Related
+#include "internal/Test/Test.h"
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#ifdef NDEBUG
+#error "TestInternalNoAlloc must be compiled without NDEBUG (asserts required)."
+#endif
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_tsEndNoAlloc_ReturnsZeroWithoutAllocations(void)
+{
+    tsAllocSite site;
+    tsBeginNoAlloc();
+    assert(tsEndNoAlloc(&site) == 0);
+    assert(!site.file && site.line == 0 && site.size == 0);
+    tsPass(__func__);
+}
+
+void Test_tsEndNoAlloc_CountsEveryWrapper(void)
+{
+    tsBeginNoAlloc();
+    void *ptr = tsMalloc(8);
+    void *zeroed = tsCalloc(2, 8);
+    ptr = tsRealloc(ptr, 32);
+    assert(tsEndNoAlloc(nullptr) == 3);
+
+    tsFree(ptr);
+    tsFree(zeroed);
+    tsPass(__func__);
+}
+
+void Test_tsEndNoAlloc_ReportsFirstCallSite(void)
+{
+    tsAllocSite site;
+    tsBeginNoAlloc();
+    const int LINE = __LINE__ + 1;
+    void *first = tsMallocAt(24, __FILE__, LINE);
+    void *second = tsMallocAt(48, __FILE__, LINE + 1);
+    assert(tsEndNoAlloc(&site) == 2);
+
+    assert(site.file && strcmp(site.file, __FILE__) == 0);
+    assert(site.line == LINE);
+    assert(site.size == 24);
+
+    tsFree(first);
+    tsFree(second);
+    tsPass(__func__);
+}
+
+void Test_tsEndNoAlloc_IgnoresAllocationsOutsideRegion(void)
+{
+    void *before = tsMalloc(8);
+    tsBeginNoAlloc();
+    tsFree(before);
+    assert(tsEndNoAlloc(nullptr) == 0);
+
+    void *after = tsMalloc(8);
+    tsBeginNoAlloc();
+    assert(tsEndNoAlloc(nullptr) == 0);
+
+    tsFree(after);
+    tsPass(__func__);
+}
+
+void Test_tsEndNoAlloc_IgnoresFailedAllocations(void)
+{
+    tsReset();
+    assert(tsDisable(MALLOC, 1));
+    tsBeginNoAlloc();
+    assert(!tsMalloc(8));
+    assert(tsEndNoAlloc(nullptr) == 0);
+    tsReset();
+    tsPass(__func__);
+}
+
+void Test_tsBeginNoAlloc_StartsRegionOver(void)
+{
+    tsBeginNoAlloc();
+    void *ptr = tsMalloc(8);
+    tsBeginNoAlloc();
+    assert(tsEndNoAlloc(nullptr) == 0);
+
+    tsFree(ptr);
+    tsPass(__func__);
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(void)
+{
+    puts("\nNO-ALLOCATION REGION TESTING");
+
+    puts("\n• Counting Related");
+    tsRun(Test_tsEndNoAlloc_ReturnsZeroWithoutAllocations);
+    tsRun(Test_tsEndNoAlloc_CountsEveryWrapper);
+    tsRun(Test_tsEndNoAlloc_IgnoresAllocationsOutsideRegion);
+    tsRun(Test_tsEndNoAlloc_IgnoresFailedAllocations);
+    tsRun(Test_tsBeginNoAlloc_StartsRegionOver);
+
+    puts("\n• Report Related");
+    tsRun(Test_tsEndNoAlloc_ReportsFirstCallSite);
+
+    puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
+    return 0;
+}
@@ -0,0 +1,329 @@
+/**
+ * @file
+ * @brief Runs the tests of Smile's test executables in parallel, each in its
+ *        own process.
+ *
+ * Tests are found by running each executable with SMILE_TEST_LIST set, which
+ * makes tsRunTest() print names instead of running tests. Each test then runs
+ * in a forked worker that re-executes its executable with SMILE_TEST_ONLY set,
+ * inside a fresh temporary directory, so tests share neither Test's static
+ * state nor the files they write. An executable that lists no tests runs as a
+ * single job.
+ *
+ * Usage: TestRunner [-j <jobs>] [--slowest <n>] <test executable>...
+ *
+ * @author Vitor Betmann
+ */
+
+// fork, exec, mkdtemp, nftw and friends are POSIX, not ISO C.
+#define _POSIX_C_SOURCE 200809L
+#define _XOPEN_SOURCE 700
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Includes
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Defines
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+#define TEST_LIST_ENV "SMILE_TEST_LIST"
+#define TEST_ONLY_ENV "SMILE_TEST_ONLY"
+#define TEST_PREFIX "\t[TEST] "
+
+#define JOBS_MAX 4096
+#define EXECUTABLES_MAX 64
+#define NAME_SIZE 160
+#define LINE_SIZE 512
+#define DIR_TEMPLATE "/tmp/SmileTest.XXXXXX"
+#define DEFAULT_SLOWEST 10
+#define FTW_FDS_MAX 16
+
+#define NS_PER_S 1000000000LL
+#define NS_PER_MS 1000000.0
+
+static const char *USAGE = "Usage: TestRunner [-j <jobs>] [--slowest <n>] <test executable>...\n";
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Data Types
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+/**
+ * @brief One test, or a whole executable that lists none.
+ *
+ * @author Vitor Betmann
+ */
+typedef struct
+{
+    const char *executable; // absolute path
+    char name[NAME_SIZE];   // empty to run the whole executable
+    pid_t pid;
+    FILE *output; // stdout and stderr of the worker
+    char dir[sizeof(DIR_TEMPLATE)];
+    int64_t startNs;
+    int64_t elapsedNs;
+    bool isPassed;
+} trJob;
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Functions
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+static int64_t trGetTimeNs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * NS_PER_S + now.tv_nsec;
+}
+
+static const char *trBaseName(const char *path)
+{
+    const char *slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+static const char *trJobName(const trJob *job)
+{
+    return job->name[0] ? job->name : "(all tests)";
+}
+
+static int trRemoveEntry(const char *path, const struct stat *info, int type, struct FTW *ftw)
+{
+    return remove(path);
+}
+
+// Adds one job per test the executable lists, or one for the whole executable.
+static bool trDiscover(const char *executable, trJob *jobs, size_t *count)
+{
+    char command[PATH_MAX + 16];
+    snprintf(command, sizeof(command), "\"%s\" 2>&1", executable);
+
+    setenv(TEST_LIST_ENV, "1", 1);
+    FILE *list = popen(command, "r");
+    unsetenv(TEST_LIST_ENV);
+    if (!list)
+    {
+        return false;
+    }
+
+    const size_t FIRST = *count;
+    char line[LINE_SIZE];
+    while (fgets(line, sizeof(line), list))
+    {
+        if (strncmp(line, TEST_PREFIX, strlen(TEST_PREFIX)) != 0 || *count == JOBS_MAX)
+        {
+            continue;
+        }
+        trJob *job = &jobs[(*count)++];
+        *job = (trJob){.executable = executable};
+        snprintf(job->name, sizeof(job->name), "%s", line + strlen(TEST_PREFIX));
+        job->name[strcspn(job->name, "\r\n")] = '\0';
+    }
+    // Without tsRun(), listing runs every test, so a failure there shows up again as the job's.
+    if (pclose(list) != 0 && *count > FIRST)
+    {
+        *count = FIRST;
+        return false;
+    }
+
+    if (*count == FIRST && *count < JOBS_MAX)
+    {
+        jobs[(*count)++] = (trJob){.executable = executable};
+    }
+    return true;
+}
+
+static bool trStart(trJob *job)
+{
+    job->output = tmpfile();
+    memcpy(job->dir, DIR_TEMPLATE, sizeof(DIR_TEMPLATE));
+    if (!job->output || !mkdtemp(job->dir))
+    {
+        return false;
+    }
+
+    fflush(stdout);
+    job->startNs = trGetTimeNs();
+    job->pid = fork();
+    if (job->pid < 0)
+    {
+        return false;
+    }
+    if (job->pid > 0)
+    {
+        return true;
+    }
+
+    // Worker. The runner has no other threads, so it may set up its environment before exec.
+    const int OUTPUT = fileno(job->output);
+    const int DEV_NULL = open("/dev/null", O_RDONLY);
+    if (chdir(job->dir) != 0 || DEV_NULL < 0 || dup2(DEV_NULL, STDIN_FILENO) < 0 ||
+        dup2(OUTPUT, STDOUT_FILENO) < 0 || dup2(OUTPUT, STDERR_FILENO) < 0)
+    {
+        _exit(127);
+    }
+    if (job->name[0])
+    {
+        setenv(TEST_ONLY_ENV, job->name, 1);
+    }
+    execl(job->executable, job->executable, (char *)nullptr);
+    _exit(127);
+}
+
+static void trFinish(trJob *job, int status)
+{
+    // The PID may be reused by a later worker, which must not match this job.
+    job->pid = 0;
+    job->elapsedNs = trGetTimeNs() - job->startNs;
+    job->isPassed = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+    if (!job->isPassed)
+    {
+        printf("[FAIL] %s %s", trBaseName(job->executable), trJobName(job));
+        if (WIFSIGNALED(status))
+        {
+            printf(" (signal %d)", WTERMSIG(status));
+        }
+        puts("");
+
+        char line[LINE_SIZE];
+        rewind(job->output);
+        while (fgets(line, sizeof(line), job->output))
+        {
+            printf("\t%s", line);
+        }
+    }
+    fclose(job->output);
+    nftw(job->dir, trRemoveEntry, FTW_FDS_MAX, FTW_DEPTH | FTW_PHYS);
+}
+
+static int trCompareElapsed(const void *a, const void *b)
+{
+    const trJob *A = *(trJob *const *)a;
+    const trJob *B = *(trJob *const *)b;
+    return (A->elapsedNs < B->elapsedNs) - (A->elapsedNs > B->elapsedNs);
+}
+
+static void trPrintSlowest(trJob *jobs, size_t count, size_t slowest)
+{
+    static trJob *sorted[JOBS_MAX];
+    for (size_t i = 0; i < count; i++)
+    {
+        sorted[i] = &jobs[i];
+    }
+    qsort(sorted, count, sizeof(sorted[0]), trCompareElapsed);
+
+    printf("\nSlowest %zu tests:\n", slowest < count ? slowest : count);
+    for (size_t i = 0; i < slowest && i < count; i++)
+    {
+        printf("\t%10.1f ms  %-24s %s\n", (double)sorted[i]->elapsedNs / NS_PER_MS,
+               trBaseName(sorted[i]->executable), trJobName(sorted[i]));
+    }
+}
+
+
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Main
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+int main(int argc, char *argv[])
+{
+    static trJob jobs[JOBS_MAX];
+    static char executables[EXECUTABLES_MAX][PATH_MAX];
+    size_t count = 0;
+    size_t executableCount = 0;
+    long workers = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t slowest = DEFAULT_SLOWEST;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            workers = atol(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--slowest") == 0 && i + 1 < argc)
+        {
+            slowest = (size_t)atol(argv[++i]);
+        }
+        else if (executableCount < EXECUTABLES_MAX && realpath(argv[i], executables[executableCount]))
+        {
+            if (!trDiscover(executables[executableCount], jobs, &count))
+            {
+                fprintf(stderr, "Failed to list the tests of %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+            executableCount++;
+        }
+        else
+        {
+            fprintf(stderr, "Failed to find %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (executableCount == 0 || workers < 1)
+    {
+        fputs(USAGE, stderr);
+        return EXIT_FAILURE;
+    }
+
+    printf("Running %zu tests from %zu executables on %ld workers\n", count, executableCount,
+           workers);
+    const int64_t START = trGetTimeNs();
+    size_t next = 0;
+    size_t running = 0;
+    size_t failed = 0;
+    int64_t totalNs = 0;
+
+    while (next < count || running > 0)
+    {
+        while (next < count && running < (size_t)workers)
+        {
+            if (!trStart(&jobs[next]))
+            {
+                fprintf(stderr, "Failed to start %s\n", trJobName(&jobs[next]));
+                return EXIT_FAILURE;
+            }
+            next++;
+            running++;
+        }
+
+        int status;
+        const pid_t PID = wait(&status);
+        if (PID < 0)
+        {
+            perror("wait");
+            return EXIT_FAILURE;
+        }
+        for (size_t i = 0; i < next; i++)
+        {
+            if (jobs[i].pid == PID)
+            {
+                trFinish(&jobs[i], status);
+                failed += !jobs[i].isPassed;
+                totalNs += jobs[i].elapsedNs;
+                running--;
+                break;
+            }
+        }
+    }
+
+    trPrintSlowest(jobs, count, slowest);
+    printf("\n%zu passed, %zu failed in %.2f s (%.2f s of test time)\n", count - failed, failed,
+           (double)(trGetTimeNs() - START) / NS_PER_S, (double)totalNs / NS_PER_S);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
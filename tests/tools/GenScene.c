@@ -31,6 +31,8 @@
 #error "TestToolGenScene must be compiled without NDEBUG (asserts required)."
 #endif
 
+#define HASH_NAME_COUNT 200
+
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Functions
@@ -600,6 +602,109 @@ void Test_gsInternalRun_GeneratedSrcHasNoSectionsWithoutFlag(void)
 }
 
 
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+// Tests - Scene Registry
+// —————————————————————————————————————————————————————————————————————————————————————————————————
+
+void Test_gsInternalBuildPerfectHash_MapsNamesToDistinctSlots(void)
+{
+    char buf[HASH_NAME_COUNT][GS_NAME_MAX];
+    const char *names[HASH_NAME_COUNT];
+    for (size_t i = 0; i < HASH_NAME_COUNT; i++)
+    {
+        snprintf(buf[i], sizeof(buf[i]), "Scene%zu", i);
+        names[i] = buf[i];
+    }
+
+    const size_t SEED_COUNT = HASH_NAME_COUNT / GS_KEYS_PER_BUCKET;
+    uint32_t seeds[HASH_NAME_COUNT / GS_KEYS_PER_BUCKET];
+    size_t slots[HASH_NAME_COUNT];
+    assert(gsInternalBuildPerfectHash(names, HASH_NAME_COUNT, seeds, SEED_COUNT, slots) ==
+        RES_OK);
+
+    bool isTaken[HASH_NAME_COUNT] = {0};
+    for (size_t i = 0; i < HASH_NAME_COUNT; i++)
+    {
+        // Same lookup SceneManager performs at runtime.
+        uint32_t seed = seeds[cmHashString(names[i], 0) % SEED_COUNT];
+        assert(cmHashString(names[i], seed) % HASH_NAME_COUNT == slots[i]);
+        assert(!isTaken[slots[i]]);
+        isTaken[slots[i]] = true;
+    }
+
+    tsPass(__func__);
+}
+
+void Test_gsInternalBuildPerfectHash_FailsWithZeroCount(void)
+{
+    const char *names[] = {"Menu"};
+    uint32_t seeds[1];
+    size_t slots[1];
+    assert(gsInternalBuildPerfectHash(names, 0, seeds, 1, slots) == RES_INVALID_ARG);
+    assert(gsInternalBuildPerfectHash(names, 1, seeds, 0, slots) == RES_INVALID_ARG);
+    tsPass(__func__);
+}
+
+void Test_gsInternalRun_RegistryFailsWithMissingDir(void)
+{
+    char *argv[] = {"GenScene", "--registry", "gstest_nonexistent_scenes"};
+    assert(gsInternalRun(3, argv) == RES_DIR_NOT_FOUND);
+    tsPass(__func__);
+}
+
+void Test_gsInternalRun_RegistryFailsWithNoScenes(void)
+{
+    char incDir[] = "gstest_inc_XXXXXX";
+    assert(tsMkdtemp(incDir) != nullptr);
+
+    char *argv[] = {"GenScene", "-r", incDir};
+    int result = gsInternalRun(3, argv);
+
+    cmDeleteDir(incDir);
+    assert(result == RES_NO_SCENES);
+    tsPass(__func__);
+}
+
+void Test_gsInternalRun_RegistryGeneratesTableFromSceneHeaders(void)
+{
+    char srcDir[] = "gstest_src_XXXXXX";
+    char incDir[] = "gstest_inc_XXXXXX";
+    assert(tsMkdtemp(srcDir) != nullptr);
+    assert(tsMkdtemp(incDir) != nullptr);
+
+    char *menuArgv[] = {"GenScene", "Menu", "-si", srcDir, "-hi", incDir};
+    assert(gsInternalRun(6, menuArgv) == RES_OK);
+    char *levelArgv[] = {"GenScene", "Level 1", "-si", srcDir, "-hi", incDir, "-nd"};
+    assert(gsInternalRun(7, levelArgv) == RES_OK);
+
+    char *argv[] = {"GenScene", "--registry", incDir, "-si", srcDir, "-hi", incDir};
+    assert(gsInternalRun(7, argv) == RES_OK);
+
+    char path[CM_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/" GS_REGISTRY_NAME ".c", srcDir);
+    assert(fileContains(path, "#include \"Menu.h\""));
+    assert(fileContains(path, "{\"Menu\", MenuEnter, MenuUpdate, MenuDraw, MenuExit}"));
+    assert(fileContains(path, "{\"Level1\", Level1Enter, Level1Update, nullptr, Level1Exit}"));
+    assert(fileContains(path, ".sceneCount = 2,"));
+    remove(path);
+    snprintf(path, sizeof(path), "%s/" GS_REGISTRY_NAME ".h", incDir);
+    assert(fileContains(path, "extern const smSceneRegistry sceneRegistry;"));
+    remove(path);
+
+    const char *SCENES[] = {"Menu", "Level1"};
+    for (size_t i = 0; i < sizeof(SCENES) / sizeof(SCENES[0]); i++)
+    {
+        snprintf(path, sizeof(path), "%s/%s.c", srcDir, SCENES[i]);
+        remove(path);
+        snprintf(path, sizeof(path), "%s/%s.h", incDir, SCENES[i]);
+        remove(path);
+    }
+    cmDeleteDir(srcDir);
+    cmDeleteDir(incDir);
+    tsPass(__func__);
+}
+
+
 // —————————————————————————————————————————————————————————————————————————————————————————————————
 // Main
 // —————————————————————————————————————————————————————————————————————————————————————————————————
@@ -607,48 +712,54 @@ void Test_gsInternalRun_GeneratedSrcHasNoSectionsWithoutFlag(void)
 int main(void)
 {
     puts("\nNAME SANITIZATION TESTING");
-    Test_gsInternalSanitizeName_SucceedsWithSimpleName();
-    Test_gsInternalSanitizeName_SucceedsConvertsSpacesToCamelCase();
-    Test_gsInternalSanitizeName_SucceedsWithUnderscoreStart();
-    Test_gsInternalSanitizeName_SucceedsTrimmingLeadingSpaces();
-    Test_gsInternalSanitizeName_SucceedsTrimmingTrailingSpaces();
-    Test_gsInternalSanitizeName_FailsWithNullBuf();
-    Test_gsInternalSanitizeName_FailsWithNullName();
-    Test_gsInternalSanitizeName_FailsWithEmptyName();
-    Test_gsInternalSanitizeName_FailsWithWhitespaceOnly();
-    Test_gsInternalSanitizeName_FailsWithDigitStart();
-    Test_gsInternalSanitizeName_FailsWithInvalidChar();
-    Test_gsInternalSanitizeName_FailsWhenOutputTooLong();
-    Test_gsInternalSanitizeName_SucceedsAtMaxNameLength();
-    Test_gsInternalSanitizeName_FailsExceedingMaxNameLength();
+    tsRun(Test_gsInternalSanitizeName_SucceedsWithSimpleName);
+    tsRun(Test_gsInternalSanitizeName_SucceedsConvertsSpacesToCamelCase);
+    tsRun(Test_gsInternalSanitizeName_SucceedsWithUnderscoreStart);
+    tsRun(Test_gsInternalSanitizeName_SucceedsTrimmingLeadingSpaces);
+    tsRun(Test_gsInternalSanitizeName_SucceedsTrimmingTrailingSpaces);
+    tsRun(Test_gsInternalSanitizeName_FailsWithNullBuf);
+    tsRun(Test_gsInternalSanitizeName_FailsWithNullName);
+    tsRun(Test_gsInternalSanitizeName_FailsWithEmptyName);
+    tsRun(Test_gsInternalSanitizeName_FailsWithWhitespaceOnly);
+    tsRun(Test_gsInternalSanitizeName_FailsWithDigitStart);
+    tsRun(Test_gsInternalSanitizeName_FailsWithInvalidChar);
+    tsRun(Test_gsInternalSanitizeName_FailsWhenOutputTooLong);
+    tsRun(Test_gsInternalSanitizeName_SucceedsAtMaxNameLength);
+    tsRun(Test_gsInternalSanitizeName_FailsExceedingMaxNameLength);
     puts("\nERROR PATH TESTING");
-    Test_gsInternalRun_FailsWithNoArgs();
-    Test_gsInternalRun_SucceedsWithHelpFlag();
-    Test_gsInternalRun_SucceedsWithShortHelpFlag();
-    Test_gsInternalRun_FailsWithNameStartingWithDash();
-    Test_gsInternalRun_FailsWithInvalidFlag();
-    Test_gsInternalRun_FailsWithNoCallbacks();
-    Test_gsInternalRun_FailsWithMissingSourceInArg();
-    Test_gsInternalRun_FailsWithMissingHeaderInArg();
-    Test_gsInternalRun_FailsWithInvalidSourcePath();
-    Test_gsInternalRun_FailsWithInvalidHeaderPath();
+    tsRun(Test_gsInternalRun_FailsWithNoArgs);
+    tsRun(Test_gsInternalRun_SucceedsWithHelpFlag);
+    tsRun(Test_gsInternalRun_SucceedsWithShortHelpFlag);
+    tsRun(Test_gsInternalRun_FailsWithNameStartingWithDash);
+    tsRun(Test_gsInternalRun_FailsWithInvalidFlag);
+    tsRun(Test_gsInternalRun_FailsWithNoCallbacks);
+    tsRun(Test_gsInternalRun_FailsWithMissingSourceInArg);
+    tsRun(Test_gsInternalRun_FailsWithMissingHeaderInArg);
+    tsRun(Test_gsInternalRun_FailsWithInvalidSourcePath);
+    tsRun(Test_gsInternalRun_FailsWithInvalidHeaderPath);
     puts("\nFILE GENERATION TESTING");
-    Test_gsInternalRun_FailsWhenSrcFileCannotBeCreated();
-    Test_gsInternalRun_FailsWhenIncFileCannotBeCreated();
-    Test_gsInternalRun_FailsWhenSrcDirCannotBeCreated();
-    Test_gsInternalRun_FailsWhenIncDirCannotBeCreated();
-    Test_gsInternalRun_SucceedsAndCreatesBothFiles();
-    Test_gsInternalRun_GeneratedSrcContainsAllCallbacks();
-    Test_gsInternalRun_GeneratedSrcOmitsDisabledCallbacks();
-    Test_gsInternalRun_GeneratedHeaderHasCorrectIncludeGuard();
+    tsRun(Test_gsInternalRun_FailsWhenSrcFileCannotBeCreated);
+    tsRun(Test_gsInternalRun_FailsWhenIncFileCannotBeCreated);
+    tsRun(Test_gsInternalRun_FailsWhenSrcDirCannotBeCreated);
+    tsRun(Test_gsInternalRun_FailsWhenIncDirCannotBeCreated);
+    tsRun(Test_gsInternalRun_SucceedsAndCreatesBothFiles);
+    tsRun(Test_gsInternalRun_GeneratedSrcContainsAllCallbacks);
+    tsRun(Test_gsInternalRun_GeneratedSrcOmitsDisabledCallbacks);
+    tsRun(Test_gsInternalRun_GeneratedHeaderHasCorrectIncludeGuard);
     puts("\nOVERWRITE/PROMPT TESTING");
-    Test_gsInternalRun_AbortsWhenUserDeclinesCreateSrcDir();
-    Test_gsInternalRun_AbortsWhenUserDeclinesCreateIncDir();
-    Test_gsInternalRun_AbortsWhenUserDeclinesOverwriteSrcFile();
-    Test_gsInternalRun_AbortsWhenUserDeclinesOverwriteIncFile();
-    Test_gsInternalRun_SucceedsWhenUserAcceptsOverwrite();
-    Test_gsInternalRun_GeneratedSrcHasSectionsWithFlag();
-    Test_gsInternalRun_GeneratedSrcHasNoSectionsWithoutFlag();
+    tsRun(Test_gsInternalRun_AbortsWhenUserDeclinesCreateSrcDir);
+    tsRun(Test_gsInternalRun_AbortsWhenUserDeclinesCreateIncDir);
+    tsRun(Test_gsInternalRun_AbortsWhenUserDeclinesOverwriteSrcFile);
+    tsRun(Test_gsInternalRun_AbortsWhenUserDeclinesOverwriteIncFile);
+    tsRun(Test_gsInternalRun_SucceedsWhenUserAcceptsOverwrite);
+    tsRun(Test_gsInternalRun_GeneratedSrcHasSectionsWithFlag);
+    tsRun(Test_gsInternalRun_GeneratedSrcHasNoSectionsWithoutFlag);
+    puts("\nSCENE REGISTRY TESTING");
+    tsRun(Test_gsInternalBuildPerfectHash_MapsNamesToDistinctSlots);
+    tsRun(Test_gsInternalBuildPerfectHash_FailsWithZeroCount);
+    tsRun(Test_gsInternalRun_RegistryFailsWithMissingDir);
+    tsRun(Test_gsInternalRun_RegistryFailsWithNoScenes);
+    tsRun(Test_gsInternalRun_RegistryGeneratesTableFromSceneHeaders);
 
     puts("\nTIME TO SMILE! :)\n\tAll Tests Passed!");
     return 0;